@@ -1,21 +1,44 @@
 #include <benchmark/benchmark.h>
-#include "myLogger/logger.hpp"
+#include "benchmark_support.hpp"
 #include "myLogger/backends/file_backend.hpp"
+#include "myLogger/backends/mmap_file_backend.hpp"
 #include <memory>
+#include <string>
 
-// ✅ Benchmark File Logging Performance
-static void BM_FileLogging(benchmark::State& state) {
-    auto settings = std::make_shared<LoggerSettings>();
-    FileBackend fileBackend;
-
-    // ✅ Use correct Logger instantiation
-    Logger<FileBackend> logger(settings, fileBackend);
+// ✅ End-to-end file throughput: enqueue `messages` lines, then shut down so the
+// consumer has drained them and FileBackend has written (and closed) the file.
+template <typename Backend>
+static void runFileLogging(benchmark::State& state, const std::string& name, const std::string& flushMode) {
+    const auto messages = state.range(0);
+    auto settings = makeBenchmarkSettings("io_overhead_" + name + "_" + flushMode,
+                                          "flush_mode = \"" + flushMode + "\"\nqueue_capacity = 65536");
 
     for (auto _ : state) {
-        logger.log("INFO", "BENCHMARK", "Testing file logging speed...");
+        Backend fileBackend;
+        auto logger = Logger<Backend>::createLogger(settings, fileBackend);
+
+        for (int64_t i = 0; i < messages; ++i) {
+            logger->log("INFO", "BENCHMARK", "Testing file logging speed...");
+        }
+        logger.reset();
     }
 
-    logger.flush();
+    state.SetItemsProcessed(state.iterations() * messages);
+}
+
+static void BM_FileLogging(benchmark::State& state, const std::string& flushMode) {
+    runFileLogging<FileBackend>(state, "file", flushMode);
 }
 
-BENCHMARK(BM_FileLogging);
+// ✅ Same workload appended into a preallocated memory-mapped segment
+static void BM_MmapFileLogging(benchmark::State& state, const std::string& flushMode) {
+    runFileLogging<MmapFileBackend>(state, "mmap", flushMode);
+}
+
+// "instant" syncs every line to disk, so it runs a much smaller batch
+BENCHMARK_CAPTURE(BM_FileLogging, instant, std::string("instant"))->Arg(1000)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_FileLogging, batch, std::string("batch"))->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_FileLogging, auto, std::string("auto"))->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MmapFileLogging, batch, std::string("batch"))->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
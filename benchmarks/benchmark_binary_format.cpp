@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_support.hpp"
+#include "myLogger/backends/file_backend.hpp"
+#include "myLogger/binary_log_format.hpp"
+#include "myLogger/timestamp_formatter.hpp"
+
+namespace {
+
+    std::shared_ptr<LoggerSettings> loadSettings(const std::string& name) {
+        auto settings = makeBenchmarkSettings(name);
+        LoggerConfig::loadOrGenerateConfig(settings->configPath, *settings);
+        return settings;
+    }
+
+    LogMessage sampleMessage(const LoggerSettings& settings) {
+        LogMessage log(settings.findLevel("INFO"), settings.findContext("BENCHMARK"),
+                       "Order 48213 filled: 300 shares at 101.25");
+        log.timeNs = currentTimeNs();
+        return log;
+    }
+
+} // namespace
+
+// ✅ Plain text line: timestamp rendered on the consumer, names spelled out
+static void BM_PlainTextEncoding(benchmark::State& state) {
+    const auto settings = loadSettings("binary_format_plain");
+    LogMessage log = sampleMessage(*settings);
+    std::string out;
+    std::size_t bytes = 0;
+
+    for (auto _ : state) {
+        log.timeNs += 1000;
+        log.stampTime(settings->config.format.timestampFormat);
+        out.clear();
+        FileBackend::appendLine(log, *settings, out);
+        bytes += out.size();
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+    state.counters["bytes/msg"] = static_cast<double>(bytes) / static_cast<double>(state.iterations());
+}
+
+// ✅ Binary record: time delta varint, interned level/context ids, raw payload
+static void BM_BinaryEncoding(benchmark::State& state) {
+    const auto settings = loadSettings("binary_format_binary");
+    LogMessage log = sampleMessage(*settings);
+    BinaryLogEncoder encoder;
+    std::string out;
+    encoder.beginSession(*settings, out);
+    encoder.append(log, *settings, out);
+    std::size_t bytes = 0;
+
+    for (auto _ : state) {
+        log.timeNs += 1000;
+        out.clear();
+        encoder.append(log, *settings, out);
+        bytes += out.size();
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+    state.counters["bytes/msg"] = static_cast<double>(bytes) / static_cast<double>(state.iterations());
+}
+
+BENCHMARK(BM_PlainTextEncoding);
+BENCHMARK(BM_BinaryEncoding);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_support.hpp"
+#include <string>
+#include <vector>
+
+// coalesce_window_ms runs once per batch on the consumer thread. The batch
+// benchmarks time that pass alone; the end-to-end ones include the queue.
+
+namespace {
+
+    constexpr std::size_t BATCH = DEFAULT_BATCH_SIZE;
+    constexpr std::int64_t WINDOW_NS = 1000 * 1'000'000;
+
+    // `distinct` different texts, repeated in blocks of BATCH / distinct
+    std::vector<LogMessage> makeBatch(std::size_t distinct) {
+        std::vector<LogMessage> batch;
+        batch.reserve(BATCH);
+        for (std::size_t i = 0; i < BATCH; ++i) {
+            batch.emplace_back(1, 1, "request " + std::to_string(i * distinct / BATCH) + " served in 913 us");
+            batch.back().timeNs = static_cast<std::int64_t>(i);
+        }
+        return batch;
+    }
+
+    void runBatch(benchmark::State& state, std::size_t distinct) {
+        const std::vector<LogMessage> source = makeBatch(distinct);
+        LoggerSettings::Format format;
+        DuplicateCoalescer coalescer;
+        std::vector<LogMessage> batch;
+        std::vector<LogMessage> leading;
+        std::int64_t base = 0;
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            batch = source;
+            for (auto& log : batch) log.timeNs += base;
+            base += 2 * WINDOW_NS;   // every batch starts a fresh run
+            leading.clear();
+            state.ResumeTiming();
+
+            coalescer.apply(batch, WINDOW_NS, format, leading);
+            benchmark::DoNotOptimize(batch.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(BATCH));
+    }
+
+} // namespace
+
+// ✅ Every record differs from the one before: the no-duplicates cost
+static void BM_CoalesceUniqueBatch(benchmark::State& state) {
+    runBatch(state, BATCH);
+}
+
+// ✅ Every record repeats the one before
+static void BM_CoalesceDuplicateBatch(benchmark::State& state) {
+    runBatch(state, 1);
+}
+
+// ✅ End to end with unique messages, coalescing off and on
+static void runEndToEnd(benchmark::State& state, const std::string& name, const std::string& general, bool repeat) {
+    NullBackend nullBackend;
+    auto logger = Logger<NullBackend>::createLogger(makeBenchmarkSettings(name, general), nullBackend);
+    const LevelId level = logger->level("INFO");
+    const ContextId context = logger->context("BENCHMARK");
+
+    int i = 0;
+    for (auto _ : state) {
+        logger->log(level, context, "Value: {}", repeat ? 42 : ++i);
+    }
+    logger->shutdown();
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["written"] = static_cast<double>(nullBackend.received.load());
+}
+
+static void BM_UniqueCoalesceOff(benchmark::State& state) {
+    runEndToEnd(state, "coalesce_unique_off", "", false);
+}
+
+static void BM_UniqueCoalesceOn(benchmark::State& state) {
+    runEndToEnd(state, "coalesce_unique_on", "coalesce_window_ms = 1000", false);
+}
+
+static void BM_RepeatedCoalesceOn(benchmark::State& state) {
+    runEndToEnd(state, "coalesce_repeated_on", "coalesce_window_ms = 1000", true);
+}
+
+BENCHMARK(BM_CoalesceUniqueBatch);
+BENCHMARK(BM_CoalesceDuplicateBatch);
+BENCHMARK(BM_UniqueCoalesceOff);
+BENCHMARK(BM_UniqueCoalesceOn);
+BENCHMARK(BM_RepeatedCoalesceOn);
+
+BENCHMARK_MAIN();
@@ -1,17 +1,54 @@
 #include <benchmark/benchmark.h>
-#include "myLogger/logger.hpp"
+#include "benchmark_support.hpp"
 #include "myLogger/backends/console_backend.hpp"
+#include <fcntl.h>
 #include <memory>
+#include <unistd.h>
+#include <vector>
 
 // ✅ Benchmark Console Logging Performance
 static void BM_ConsoleLogging(benchmark::State& state) {
-    // ✅ Proper instantiation with the new Logger setup
-    auto logger = std::make_unique<Logger<ConsoleBackend>>();
+    ConsoleBackend consoleBackend;
+    auto logger = Logger<ConsoleBackend>::createLogger(makeBenchmarkSettings("console"), consoleBackend);
 
     for (auto _ : state) {
         logger->log("INFO", "BENCHMARK", "Testing console logging speed...");
     }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// ✅ Rendering + write(2) of one batch, with stdout redirected to /dev/null
+static void BM_ConsoleBatchRedirected(benchmark::State& state) {
+    auto settings = makeBenchmarkSettings("console_batch");
+    LoggerConfig::loadOrGenerateConfig(settings->configPath, *settings);
+
+    std::vector<LogMessage> batch;
+    for (int i = 0; i < DEFAULT_BATCH_SIZE; ++i) {
+        LogMessage log(settings->findLevel("INFO"), settings->addContext("BENCHMARK"),
+                       "Testing console logging speed...");
+        log.timeNs = currentTimeNs();
+        log.stampTime(settings->config.format.timestampFormat);
+        batch.push_back(std::move(log));
+    }
+
+    const int savedStdout = ::dup(STDOUT_FILENO);
+    const int devNull = ::open("/dev/null", O_WRONLY);
+    ::dup2(devNull, STDOUT_FILENO);
+
+    ConsoleBackend consoleBackend;
+    consoleBackend.setup(*settings);
+    for (auto _ : state) {
+        consoleBackend.writeBatch(batch, *settings);
+    }
+
+    ::dup2(savedStdout, STDOUT_FILENO);
+    ::close(devNull);
+    ::close(savedStdout);
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch.size()));
 }
 
 BENCHMARK(BM_ConsoleLogging);
+BENCHMARK(BM_ConsoleBatchRedirected);
 BENCHMARK_MAIN();
@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_support.hpp"
+#include <memory>
+#include <string>
+
+// ✅ Producer cost when the caller formats the message itself
+static void BM_EagerFormatting(benchmark::State& state) {
+    NullBackend nullBackend;
+    auto logger = Logger<NullBackend>::createLogger(makeBenchmarkSettings("eager_formatting"), nullBackend);
+
+    int i = 0;
+    for (auto _ : state) {
+        logger->log("INFO", "BENCHMARK",
+                    "Request #" + std::to_string(i) + " took " + std::to_string(0.25 * i) + " ms");
+        ++i;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// ✅ Producer cost when formatting is deferred to the logger thread
+static void BM_DeferredFormatting(benchmark::State& state) {
+    NullBackend nullBackend;
+    auto logger = Logger<NullBackend>::createLogger(makeBenchmarkSettings("deferred_formatting"), nullBackend);
+
+    int i = 0;
+    for (auto _ : state) {
+        logger->log("INFO", "BENCHMARK", "Request #{} took {} ms", i, 0.25 * i);
+        ++i;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_EagerFormatting);
+BENCHMARK(BM_DeferredFormatting);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_support.hpp"
+
+// The benchmark config switches VERBOSE off; nothing here reaches the queue.
+
+// ✅ Level and context by name: two hash lookups before the filter
+static void BM_DisabledByName(benchmark::State& state) {
+    NullBackend nullBackend;
+    auto logger = Logger<NullBackend>::createLogger(makeBenchmarkSettings("level_filter_name"), nullBackend);
+
+    for (auto _ : state) {
+        logger->log("VERBOSE", "BENCHMARK", "Value: {}", 42);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// ✅ Pre-resolved ids: the runtime filter through shouldLog()
+static void BM_DisabledById(benchmark::State& state) {
+    NullBackend nullBackend;
+    auto logger = Logger<NullBackend>::createLogger(makeBenchmarkSettings("level_filter_id"), nullBackend);
+    const LevelId level = logger->level("VERBOSE");
+    const ContextId context = logger->context("BENCHMARK");
+
+    for (auto _ : state) {
+        logger->log(level, context, "Value: {}", 42);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// ✅ Typed level, switched off at runtime: one load from the Level-indexed table
+static void BM_DisabledTyped(benchmark::State& state) {
+    NullBackend nullBackend;
+    auto logger = Logger<NullBackend>::createLogger(makeBenchmarkSettings("level_filter_typed"), nullBackend);
+    const ContextId context = logger->context("BENCHMARK");
+
+    for (auto _ : state) {
+        logger->log<Level::Verbose>(context, "Value: {}", 42);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// ✅ Typed level switched on, but below its context's minimum: one load
+//    from the context's typed-level mask
+static void BM_ContextFilteredTyped(benchmark::State& state) {
+    NullBackend nullBackend;
+    auto logger = Logger<NullBackend>::createLogger(
+        makeBenchmarkSettings("level_filter_context", "", "QUIET = \"ERROR\""), nullBackend);
+    const ContextId context = logger->context("QUIET");
+
+    for (auto _ : state) {
+        logger->log<Level::Info>(context, "Value: {}", 42);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// ✅ Typed level below MYLOGGER_MIN_LEVEL: no code at all
+static void BM_CompiledOut(benchmark::State& state) {
+    if constexpr (levelCompiledIn<Level::Verbose>) {
+        state.SkipWithError("configure with -DMYLOGGER_MIN_LEVEL=DEBUG (or higher) to strip VERBOSE");
+        return;
+    }
+
+    NullBackend nullBackend;
+    auto logger = Logger<NullBackend>::createLogger(makeBenchmarkSettings("level_filter_stripped"), nullBackend);
+    const ContextId context = logger->context("BENCHMARK");
+
+    for (auto _ : state) {
+        logger->log<Level::Verbose>(context, "Value: {}", 42);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// ✅ Two loggers used in turn from one thread: each keeps its own cached
+//    settings snapshot, so neither falls back to the locked refresh
+static void BM_DisabledTwoLoggers(benchmark::State& state) {
+    NullBackend nullBackend;
+    auto first = Logger<NullBackend>::createLogger(makeBenchmarkSettings("level_filter_first"), nullBackend);
+    auto second = Logger<NullBackend>::createLogger(makeBenchmarkSettings("level_filter_second"), nullBackend);
+    const ContextId firstContext = first->context("BENCHMARK");
+    const ContextId secondContext = second->context("BENCHMARK");
+
+    for (auto _ : state) {
+        first->log<Level::Verbose>(firstContext, "Value: {}", 42);
+        second->log<Level::Verbose>(secondContext, "Value: {}", 42);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+// ✅ A flooded context with [contexts] limits, from several threads at once.
+//    Refused calls only read the bucket and bump a per-thread counter shard,
+//    so per-call cost should stay flat as threads are added.
+static std::unique_ptr<Logger<NullBackend>> limitedLogger;
+static NullBackend limitedBackend;
+static LevelId limitedLevel;
+static ContextId limitedContext;
+
+static void runLimited(benchmark::State& state, const std::string& name, const std::string& limits) {
+    if (state.thread_index() == 0) {
+        auto settings = makeBenchmarkSettings(name, "", "NETWORK = " + limits);
+        limitedLogger = Logger<NullBackend>::createLogger(settings, limitedBackend);
+        limitedLevel = limitedLogger->level("INFO");
+        limitedContext = limitedLogger->context("NETWORK");
+    }
+
+    for (auto _ : state) {
+        limitedLogger->log(limitedLevel, limitedContext, "Value: {}", 42);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        limitedLogger.reset();
+    }
+}
+
+static void BM_RateLimitedFlood(benchmark::State& state) {
+    runLimited(state, "level_filter_rate_limited", R"({ level = "INFO", rate = 100 })");
+}
+
+static void BM_SampledFlood(benchmark::State& state) {
+    runLimited(state, "level_filter_sampled", R"({ level = "INFO", sample = 0.001 })");
+}
+
+BENCHMARK(BM_DisabledByName);
+BENCHMARK(BM_DisabledById);
+BENCHMARK(BM_DisabledTyped);
+BENCHMARK(BM_ContextFilteredTyped);
+BENCHMARK(BM_CompiledOut);
+BENCHMARK(BM_DisabledTwoLoggers);
+BENCHMARK(BM_RateLimitedFlood)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_SampledFlood)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
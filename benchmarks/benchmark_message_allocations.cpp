@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_support.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+
+// ✅ Every heap allocation in the process, producer and logger threads alike
+static std::atomic<long long> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// Blocks until the backend has seen `expected` messages
+static void waitForBackend(const NullBackend& backend, long long expected) {
+    while (backend.received.load(std::memory_order_relaxed) < expected) {
+        std::this_thread::yield();
+    }
+}
+
+// ✅ Allocations per logged message once queue, slabs and batch vectors are warm.
+// range(0) = message length: 32 stays inline, 600 spills into a slab.
+static void runAllocationBenchmark(benchmark::State& state, const std::string& name, const std::string& general) {
+    NullBackend nullBackend;
+    auto logger = Logger<NullBackend>::createLogger(makeBenchmarkSettings(name, general), nullBackend);
+    const LevelId level = logger->level("INFO");
+    const ContextId context = logger->context("BENCHMARK");
+    const std::string message(static_cast<std::size_t>(state.range(0)), 'x');
+
+    // Warm-up: let every pool reach its working size
+    constexpr long long WARMUP = 50'000;
+    for (long long i = 0; i < WARMUP; ++i) {
+        logger->log(level, context, message);
+    }
+    waitForBackend(nullBackend, WARMUP);
+
+    const long long before = g_allocations.load(std::memory_order_relaxed);
+    long long sent = 0;
+    for (auto _ : state) {
+        logger->log(level, context, message);
+        ++sent;
+    }
+    waitForBackend(nullBackend, WARMUP + sent);
+    const long long allocations = g_allocations.load(std::memory_order_relaxed) - before;
+
+    state.counters["allocs_per_msg"] = benchmark::Counter(static_cast<double>(allocations) / static_cast<double>(sent));
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_AllocationsSerial(benchmark::State& state) {
+    runAllocationBenchmark(state, "allocations_serial", "queue_mode = \"ring\"\n");
+}
+
+static void BM_AllocationsPerThread(benchmark::State& state) {
+    runAllocationBenchmark(state, "allocations_per_thread", "queue_mode = \"per_thread\"\n");
+}
+
+// Recycled batch vectors; each published batch still costs one shared_ptr control block
+static void BM_AllocationsFanOut(benchmark::State& state) {
+    runAllocationBenchmark(state, "allocations_fan_out", "queue_mode = \"ring\"\ndispatch_mode = \"fan_out\"\n");
+}
+
+// ✅ Deferred formatting: arguments are rendered into the consumer's scratch buffer
+static void BM_AllocationsDeferred(benchmark::State& state) {
+    NullBackend nullBackend;
+    auto logger = Logger<NullBackend>::createLogger(makeBenchmarkSettings("allocations_deferred"), nullBackend);
+    const LevelId level = logger->level("INFO");
+    const ContextId context = logger->context("BENCHMARK");
+
+    constexpr long long WARMUP = 50'000;
+    for (long long i = 0; i < WARMUP; ++i) {
+        logger->log(level, context, "Value: {} ({})", i, 3.5);
+    }
+    waitForBackend(nullBackend, WARMUP);
+
+    const long long before = g_allocations.load(std::memory_order_relaxed);
+    long long sent = 0;
+    for (auto _ : state) {
+        logger->log(level, context, "Value: {} ({})", sent, 3.5);
+        ++sent;
+    }
+    waitForBackend(nullBackend, WARMUP + sent);
+    const long long allocations = g_allocations.load(std::memory_order_relaxed) - before;
+
+    state.counters["allocs_per_msg"] = benchmark::Counter(static_cast<double>(allocations) / static_cast<double>(sent));
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_AllocationsSerial)->Arg(32)->Arg(600);
+BENCHMARK(BM_AllocationsPerThread)->Arg(32)->Arg(600);
+BENCHMARK(BM_AllocationsFanOut)->Arg(32)->Arg(600);
+BENCHMARK(BM_AllocationsDeferred);
+
+BENCHMARK_MAIN();
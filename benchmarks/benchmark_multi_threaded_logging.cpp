@@ -1,50 +1,40 @@
 #include <benchmark/benchmark.h>
-#include "myLogger/logger.hpp"
-#include "myLogger/backends/console_backend.hpp"
-#include <thread>
-#include <vector>
+#include "benchmark_support.hpp"
 #include <memory>
-#include <fstream>
 
-// ✅ Benchmark for High-Throughput Logging
-static void BM_HighThroughputLogging(benchmark::State& state) {
-    // ✅ Proper instantiation with the new Logger setup
-    auto logger = std::make_unique<Logger<ConsoleBackend>>();
+// ✅ Shared logger for all benchmark threads, created by thread 0
+static std::unique_ptr<Logger<NullBackend>> sharedLogger;
+static NullBackend nullBackend;
 
-    // ✅ Redirect console output to /dev/null to avoid excessive terminal spam
-    std::ofstream nullStream("/dev/null");
-    std::streambuf* oldCout = std::cout.rdbuf(nullStream.rdbuf());
-
-    const int numThreads = std::thread::hardware_concurrency();
-    const int logsPerThread = state.range(0);
+// ✅ Benchmark for High-Throughput Logging from many producers at once
+static void runMultiThreadedLogging(benchmark::State& state, const std::string& queueMode) {
+    if (state.thread_index() == 0) {
+        auto settings = makeBenchmarkSettings("multi_threaded_" + queueMode,
+                                              "queue_mode = \"" + queueMode + "\"\nqueue_capacity = 65536");
+        sharedLogger = Logger<NullBackend>::createLogger(settings, nullBackend);
+    }
 
     for (auto _ : state) {
-        std::vector<std::thread> threads;
-        for (int i = 0; i < numThreads; ++i) {
-            threads.emplace_back([&]() {
-                for (int j = 0; j < logsPerThread; ++j) {
-                    logger->log("INFO", "THREAD", "High-Throughput Logging Test");
-                }
-            });
-        }
-
-        for (auto& thread : threads) {
-            thread.join();
-        }
-
-        // ✅ Ensure logger is properly reset between iterations
-        state.PauseTiming();
-        logger->shutdown();
-        state.ResumeTiming();
+        sharedLogger->log("INFO", "THREAD", "High-Throughput Logging Test");
     }
 
-    // ✅ Restore stdout
-    std::cout.rdbuf(oldCout);
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        sharedLogger.reset();
+    }
+}
+
+static void BM_MultiThreadedLogging_Deque(benchmark::State& state) {
+    runMultiThreadedLogging(state, "deque");
+}
 
-    state.SetItemsProcessed(state.iterations() * numThreads * logsPerThread);
+static void BM_MultiThreadedLogging_Ring(benchmark::State& state) {
+    runMultiThreadedLogging(state, "ring");
 }
 
-// ✅ Benchmark with different log amounts per thread (10k, 50k, 100k)
-BENCHMARK(BM_HighThroughputLogging)->Arg(10000)->Arg(50000)->Arg(100000);
+// ✅ Producer throughput (items/s) per thread count; compare the two queue modes
+BENCHMARK(BM_MultiThreadedLogging_Deque)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_MultiThreadedLogging_Ring)->ThreadRange(1, 16)->UseRealTime();
 
 BENCHMARK_MAIN();
@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_support.hpp"
+#include <memory>
+
+// ✅ Shared logger for all benchmark threads, created by thread 0
+static std::unique_ptr<Logger<NullBackend>> sharedLogger;
+static NullBackend nullBackend;
+
+// ✅ Per-call enqueue cost as the number of producer threads grows
+static void runEnqueue(benchmark::State& state, const std::string& queueMode) {
+    if (state.thread_index() == 0) {
+        auto settings = makeBenchmarkSettings("per_thread_enqueue_" + queueMode,
+                                              "queue_mode = \"" + queueMode + "\"\n"
+                                              "queue_capacity = 65536\n"
+                                              "thread_queue_capacity = 1024");
+        sharedLogger = Logger<NullBackend>::createLogger(settings, nullBackend);
+    }
+
+    for (auto _ : state) {
+        sharedLogger->log("INFO", "THREAD", "Per-thread enqueue test");
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        sharedLogger.reset();
+    }
+}
+
+static void BM_Enqueue_PerThread(benchmark::State& state) {
+    runEnqueue(state, "per_thread");
+}
+
+static void BM_Enqueue_SharedRing(benchmark::State& state) {
+    runEnqueue(state, "ring");
+}
+
+// ✅ CPU time per iteration should stay flat for per_thread from 1 to 64 threads
+BENCHMARK(BM_Enqueue_PerThread)->ThreadRange(1, 64);
+BENCHMARK(BM_Enqueue_SharedRing)->ThreadRange(1, 64);
+
+BENCHMARK_MAIN();
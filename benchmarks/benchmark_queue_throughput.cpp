@@ -1,15 +1,17 @@
 #include <benchmark/benchmark.h>
-#include "myLogger/logger.hpp"
-#include "myLogger/backends/console_backend.hpp"
+#include "benchmark_support.hpp"
 #include <memory>
 
 // ✅ Benchmark Log Queue Throughput
 static void BM_LogQueueThroughput(benchmark::State& state) {
-    auto logger = std::make_unique<Logger<ConsoleBackend>>();
+    NullBackend nullBackend;
+    auto logger = Logger<NullBackend>::createLogger(makeBenchmarkSettings("queue_throughput"), nullBackend);
 
     for (auto _ : state) {
-        logger->log("INFO", "TEST", "Logging Performance Test");
+        logger->log("INFO", "BENCHMARK", "Logging Performance Test");
     }
+
+    state.SetItemsProcessed(state.iterations());
 }
 
 BENCHMARK(BM_LogQueueThroughput);
@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_support.hpp"
+#include "myLogger/backends/file_backend.hpp"
+#include "myLogger/binary_log_format.hpp"
+#include "myLogger/structured_format.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// ✅ Heap allocations while encoding; steady state should be zero
+static std::atomic<long long> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+    std::shared_ptr<LoggerSettings> loadSettings(const std::string& name) {
+        auto settings = makeBenchmarkSettings(name);
+        LoggerConfig::loadOrGenerateConfig(settings->configPath, *settings);
+        return settings;
+    }
+
+    LogMessage sampleMessage(const LoggerSettings& settings, bool withFields) {
+        LogMessage log(settings.findLevel("INFO"), settings.findContext("BENCHMARK"), "Request completed");
+        if (withFields) {
+            log.fields.assign({{{"user_id", 48213}, {"latency_us", 913}, {"route", "/api/orders"},
+                                {"cache_hit", true}, {"ratio", 0.25}}});
+        }
+        log.timeNs = currentTimeNs();
+        return log;
+    }
+
+    // Same information as the fields above, spelled into the message text
+    LogMessage plainEquivalent(const LoggerSettings& settings) {
+        LogMessage log(settings.findLevel("INFO"), settings.findContext("BENCHMARK"),
+                       "Request completed user_id=48213 latency_us=913 route=/api/orders cache_hit=true ratio=0.25");
+        log.timeNs = currentTimeNs();
+        return log;
+    }
+
+    void reportCounters(benchmark::State& state, std::size_t bytes, long long allocations) {
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+        state.counters["bytes/msg"] = static_cast<double>(bytes) / static_cast<double>(state.iterations());
+        state.counters["allocs/msg"] = static_cast<double>(allocations) / static_cast<double>(state.iterations());
+    }
+
+    void runTextEncoding(benchmark::State& state, const char* name, LogFormat format, LogMessage (*make)(const LoggerSettings&)) {
+        const auto settings = loadSettings(name);
+        LogMessage log = make(*settings);
+        std::string out;
+        FileBackend::appendText(log, *settings, format, out);   // grow the buffer once
+        std::size_t bytes = 0;
+
+        const long long before = g_allocations.load(std::memory_order_relaxed);
+        for (auto _ : state) {
+            log.timeNs += 1000;
+            log.stampTime(settings->config.format.timestampFormat);
+            out.clear();
+            FileBackend::appendText(log, *settings, format, out);
+            bytes += out.size();
+            benchmark::DoNotOptimize(out.data());
+        }
+        reportCounters(state, bytes, g_allocations.load(std::memory_order_relaxed) - before);
+    }
+
+} // namespace
+
+// ✅ Baseline: the plain formatter, fields written into the message by hand
+static void BM_PlainFormatter(benchmark::State& state) {
+    runTextEncoding(state, "structured_plain_baseline", LogFormat::Plain, plainEquivalent);
+}
+
+// ✅ Plain line with the same five values as structured fields
+static void BM_PlainWithFields(benchmark::State& state) {
+    runTextEncoding(state, "structured_plain_fields", LogFormat::Plain,
+                    [](const LoggerSettings& settings) { return sampleMessage(settings, true); });
+}
+
+static void BM_JsonEncoder(benchmark::State& state) {
+    runTextEncoding(state, "structured_json", LogFormat::Json,
+                    [](const LoggerSettings& settings) { return sampleMessage(settings, true); });
+}
+
+static void BM_LogfmtEncoder(benchmark::State& state) {
+    runTextEncoding(state, "structured_logfmt", LogFormat::Logfmt,
+                    [](const LoggerSettings& settings) { return sampleMessage(settings, true); });
+}
+
+// ✅ FieldMessage record in a binary log
+static void BM_BinaryWithFields(benchmark::State& state) {
+    const auto settings = loadSettings("structured_binary");
+    LogMessage log = sampleMessage(*settings, true);
+    BinaryLogEncoder encoder;
+    std::string out;
+    encoder.beginSession(*settings, out);
+    encoder.append(log, *settings, out);
+    std::size_t bytes = 0;
+
+    const long long before = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        log.timeNs += 1000;
+        out.clear();
+        encoder.append(log, *settings, out);
+        bytes += out.size();
+        benchmark::DoNotOptimize(out.data());
+    }
+    reportCounters(state, bytes, g_allocations.load(std::memory_order_relaxed) - before);
+}
+
+// ✅ Producer side: packing five fields into a LogMessage (slab from the pool)
+static void BM_CaptureFields(benchmark::State& state) {
+    LogFields fields;
+    const std::string route = "/api/orders";
+    std::size_t bytes = 0;
+
+    const long long before = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        fields.assign({{{"user_id", 48213}, {"latency_us", 913}, {"route", route},
+                        {"cache_hit", true}, {"ratio", 0.25}}});
+        bytes += fields.size();
+        benchmark::DoNotOptimize(&fields);
+        fields.clear();
+    }
+    reportCounters(state, bytes, g_allocations.load(std::memory_order_relaxed) - before);
+}
+
+BENCHMARK(BM_PlainFormatter);
+BENCHMARK(BM_PlainWithFields);
+BENCHMARK(BM_JsonEncoder);
+BENCHMARK(BM_LogfmtEncoder);
+BENCHMARK(BM_BinaryWithFields);
+BENCHMARK(BM_CaptureFields);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,73 @@
+#ifndef BENCHMARK_SUPPORT_HPP
+#define BENCHMARK_SUPPORT_HPP
+
+#include "myLogger/logger.hpp"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+// ✅ Backend that discards everything, so benchmarks measure the logger and not the sink
+class NullBackend {
+public:
+    std::atomic<long long> received{0};
+
+    void setup([[maybe_unused]] const LoggerSettings& settings) {}
+
+    void write([[maybe_unused]] const LogMessage& log, [[maybe_unused]] const LoggerSettings& settings) {
+        received.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+// ✅ Writes a dedicated config file for a benchmark and returns settings pointing at it.
+// `generalOverrides` is inserted verbatim into the [general] table, `extraContexts` into [contexts].
+inline std::shared_ptr<LoggerSettings> makeBenchmarkSettings(const std::string& name,
+                                                             const std::string& generalOverrides = "",
+                                                             const std::string& extraContexts = "") {
+    const std::filesystem::path dir = "config/benchmarks";
+    std::filesystem::create_directories(dir);
+
+    auto settings = std::make_shared<LoggerSettings>();
+    settings->configPath = (dir / (name + ".conf")).string();
+
+    std::ofstream file(settings->configPath, std::ios::trunc);
+    file << "[general]\n"
+         << "log_directory = \"logs/benchmarks/\"\n";
+    if (generalOverrides.find("flush_mode") == std::string::npos) {
+        file << "flush_mode = \"batch\"\n";
+    }
+    file << generalOverrides << "\n"
+         << R"(
+[format]
+log_timestamps = true
+timestamp_format = "ISO"
+
+[backends]
+enable_console = false
+enable_file = true
+
+[levels]
+VERBOSE   = "OFF"
+DEBUG     = "ON"
+INFO      = "ON"
+WARN      = "ON"
+ERROR     = "ON"
+CRITICAL  = "ON"
+
+[severities]
+VERBOSE   = 1
+DEBUG     = 2
+INFO      = 3
+WARN      = 4
+ERROR     = 5
+CRITICAL  = 6
+
+[contexts]
+BENCHMARK = "INFO"
+THREAD = "INFO"
+)" << extraContexts << "\n";
+    return settings;
+}
+
+#endif // BENCHMARK_SUPPORT_HPP
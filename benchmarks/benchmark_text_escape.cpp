@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+#include "myLogger/text_escape.hpp"
+#include <string>
+
+namespace {
+
+    // Log-like text: mostly ASCII, one quote or newline every ~64 bytes and
+    // some multi-byte UTF-8 when `mixed` is set
+    std::string payload(std::size_t size, bool mixed) {
+        static const std::string words = "request completed for user 48213 in 913us route /api/orders ";
+        std::string text;
+        while (text.size() < size) {
+            text += words;
+            if (mixed) text += "\"caf\xC3\xA9\"\n";
+        }
+        text.resize(size);
+        return text;
+    }
+
+    void run(benchmark::State& state, SimdLevel level, bool mixed,
+             void (*escape)(std::string_view, std::string&, const EscapeKernel&)) {
+        const EscapeKernel* kernel = escapeKernelFor(level);
+        if (kernel == nullptr) {
+            state.SkipWithError("not supported on this CPU");
+            return;
+        }
+        const std::string text = payload(static_cast<std::size_t>(state.range(0)), mixed);
+        std::string out;
+        out.reserve(text.size() * 6);
+        for (auto _ : state) {
+            out.clear();
+            escape(text, out, *kernel);
+            benchmark::DoNotOptimize(out.data());
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+    }
+
+} // namespace
+
+// ✅ Previous approach: test every byte, append unescaped runs
+static void BM_JsonEscapeBytewise(benchmark::State& state) {
+    const std::string text = payload(static_cast<std::size_t>(state.range(0)), true);
+    std::string out;
+    out.reserve(text.size() * 6);
+    for (auto _ : state) {
+        out.clear();
+        std::size_t runStart = 0;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            const auto c = static_cast<unsigned char>(text[i]);
+            if (!(c < 0x20 || c == '"' || c == '\\' || c == 0x7F)) continue;
+            out.append(text.data() + runStart, i - runStart);
+            runStart = i + 1;
+            out += '\\';
+            out += c == '\n' ? 'n' : static_cast<char>(c);
+        }
+        out.append(text.data() + runStart, text.size() - runStart);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+
+// ✅ Kernel escapers: JSON strings, console message text, plain ASCII vs. mixed
+static void BM_JsonEscape(benchmark::State& state, SimdLevel level, bool mixed) {
+    run(state, level, mixed, appendJsonEscaped);
+}
+
+static void BM_TerminalSafe(benchmark::State& state, SimdLevel level) {
+    run(state, level, true, appendTerminalSafe);
+}
+
+// ✅ UTF-8 validation on its own
+static void BM_ValidateUtf8(benchmark::State& state, SimdLevel level) {
+    const EscapeKernel* kernel = escapeKernelFor(level);
+    if (kernel == nullptr) {
+        state.SkipWithError("not supported on this CPU");
+        return;
+    }
+    const std::string text = payload(static_cast<std::size_t>(state.range(0)), true);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(isValidUtf8(text, *kernel));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+
+#define PAYLOAD_SIZES RangeMultiplier(4)->Range(16, 4096)
+
+BENCHMARK(BM_JsonEscapeBytewise)->PAYLOAD_SIZES;
+BENCHMARK_CAPTURE(BM_JsonEscape, scalar_ascii, SimdLevel::Scalar, false)->PAYLOAD_SIZES;
+BENCHMARK_CAPTURE(BM_JsonEscape, sse2_ascii, SimdLevel::Sse2, false)->PAYLOAD_SIZES;
+BENCHMARK_CAPTURE(BM_JsonEscape, avx2_ascii, SimdLevel::Avx2, false)->PAYLOAD_SIZES;
+BENCHMARK_CAPTURE(BM_JsonEscape, scalar_mixed, SimdLevel::Scalar, true)->PAYLOAD_SIZES;
+BENCHMARK_CAPTURE(BM_JsonEscape, sse2_mixed, SimdLevel::Sse2, true)->PAYLOAD_SIZES;
+BENCHMARK_CAPTURE(BM_JsonEscape, avx2_mixed, SimdLevel::Avx2, true)->PAYLOAD_SIZES;
+BENCHMARK_CAPTURE(BM_TerminalSafe, scalar, SimdLevel::Scalar)->PAYLOAD_SIZES;
+BENCHMARK_CAPTURE(BM_TerminalSafe, avx2, SimdLevel::Avx2)->PAYLOAD_SIZES;
+BENCHMARK_CAPTURE(BM_ValidateUtf8, scalar, SimdLevel::Scalar)->PAYLOAD_SIZES;
+BENCHMARK_CAPTURE(BM_ValidateUtf8, avx2, SimdLevel::Avx2)->PAYLOAD_SIZES;
+
+BENCHMARK_MAIN();
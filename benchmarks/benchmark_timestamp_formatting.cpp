@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+#include "myLogger/timestamp_formatter.hpp"
+#include <ctime>
+#include <string>
+
+// ✅ Previous approach: localtime_r + strftime into a fresh std::string per message
+static void BM_StrftimeTimestamp(benchmark::State& state) {
+    for (auto _ : state) {
+        const std::time_t now = std::time(nullptr);
+        std::tm tm{};
+        localtime_r(&now, &tm);
+        char buf[64];
+        std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", &tm);
+        std::string timestamp(buf);
+        benchmark::DoNotOptimize(timestamp);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// ✅ Cached per-second prefix + fixed-width sub-second digits
+static void BM_CachedTimestamp(benchmark::State& state, const char* format) {
+    char buf[MAX_TIMESTAMP_LENGTH];
+    for (auto _ : state) {
+        const std::size_t length = formatTimestamp(currentTimeNs(), format, buf, sizeof(buf));
+        benchmark::DoNotOptimize(buf);
+        benchmark::DoNotOptimize(length);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_StrftimeTimestamp);
+BENCHMARK_CAPTURE(BM_CachedTimestamp, ISO, "ISO");
+BENCHMARK_CAPTURE(BM_CachedTimestamp, ISO_MS, "ISO_MS");
+BENCHMARK_CAPTURE(BM_CachedTimestamp, ISO_US, "ISO_US");
+BENCHMARK_CAPTURE(BM_CachedTimestamp, ISO_NS, "ISO_NS");
+
+BENCHMARK_MAIN();
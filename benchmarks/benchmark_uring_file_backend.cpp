@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_support.hpp"
+#include "myLogger/backends/file_backend.hpp"
+#include "myLogger/backends/uring_file_backend.hpp"
+#include <memory>
+
+// ✅ One shared logger per run, created by thread 0; the backend lives alongside it
+template <typename Backend>
+struct SharedFileLogger {
+    static inline std::unique_ptr<Backend> backend;
+    static inline std::unique_ptr<Logger<Backend>> logger;
+};
+
+// ✅ Producers log into a file-backed logger; thread 0 drains and closes it afterwards
+template <typename Backend>
+static void runFileBackend(benchmark::State& state, const char* name) {
+    using Shared = SharedFileLogger<Backend>;
+    if (state.thread_index() == 0) {
+        Shared::backend = std::make_unique<Backend>();
+        Shared::logger = Logger<Backend>::createLogger(makeBenchmarkSettings(name, "queue_capacity = 65536"),
+                                                       *Shared::backend);
+    }
+
+    int i = 0;
+    for (auto _ : state) {
+        Shared::logger->log("INFO", "THREAD", "File backend throughput test #{}", i++);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        Shared::logger.reset();
+        Shared::backend.reset();
+    }
+}
+
+static void BM_FileBackend_Sync(benchmark::State& state) {
+    runFileBackend<FileBackend>(state, "file_backend_sync");
+}
+
+static void BM_FileBackend_Uring(benchmark::State& state) {
+    runFileBackend<UringFileBackend>(state, "file_backend_uring");
+}
+
+// ✅ Synchronous write(2) vs io_uring submission at 1, 4 and 16 producers
+BENCHMARK(BM_FileBackend_Sync)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+BENCHMARK(BM_FileBackend_Uring)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_support.hpp"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ✅ Records capture -> write latency of every message it receives (logger thread only)
+class LatencyBackend {
+public:
+    std::vector<std::int64_t> samples;
+    std::atomic<long long> received{0};
+
+    void setup([[maybe_unused]] const LoggerSettings& settings) {}
+
+    void write(const LogMessage& log, [[maybe_unused]] const LoggerSettings& settings) {
+        samples.push_back(currentTimeNs() - log.timeNs);
+        received.fetch_add(1, std::memory_order_release);
+    }
+};
+
+static const char* const WAIT_STRATEGIES[] = {"spin", "adaptive", "interval"};
+
+static std::string waitConfig(const benchmark::State& state) {
+    return std::string("wait_strategy = \"") + WAIT_STRATEGIES[state.range(0)] + "\"\n";
+}
+
+static void reportPercentiles(benchmark::State& state, std::vector<std::int64_t>& samples) {
+    if (samples.empty()) return;
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](double p) {
+        const auto index = static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1));
+        return static_cast<double>(samples[index]) / 1000.0;
+    };
+    state.counters["p50_us"] = percentile(0.50);
+    state.counters["p99_us"] = percentile(0.99);
+    state.counters["p999_us"] = percentile(0.999);
+    state.counters["max_us"] = percentile(1.0);
+}
+
+// ✅ Producer -> sink latency for sparse traffic: the consumer has gone idle
+// before each message, so this measures how fast each strategy wakes up.
+// range(0): 0 = spin, 1 = adaptive, 2 = interval
+static void BM_WakeupLatency(benchmark::State& state) {
+    state.SetLabel(WAIT_STRATEGIES[state.range(0)]);
+    LatencyBackend backend;
+    backend.samples.reserve(static_cast<std::size_t>(state.max_iterations) + 16);
+    long long sent = 0;
+    {
+        auto logger = Logger<LatencyBackend>::createLogger(
+            makeBenchmarkSettings(std::string("wakeup_") + WAIT_STRATEGIES[state.range(0)], waitConfig(state)), backend);
+        const LevelId level = logger->level("INFO");
+        const ContextId context = logger->context("BENCHMARK");
+
+        for (auto _ : state) {
+            logger->log(level, context, "Wakeup probe");
+            ++sent;
+            state.PauseTiming();
+            // Let the consumer drain and fall idle (spin, then park) again
+            while (backend.received.load(std::memory_order_acquire) < sent) {
+                std::this_thread::yield();
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+            state.ResumeTiming();
+        }
+    }
+
+    reportPercentiles(state, backend.samples);
+}
+
+// ✅ Producer cost and latency under a continuous stream
+static void BM_StreamLatency(benchmark::State& state) {
+    state.SetLabel(WAIT_STRATEGIES[state.range(0)]);
+    LatencyBackend backend;
+    backend.samples.reserve(static_cast<std::size_t>(state.max_iterations) + 16);
+    {
+        auto logger = Logger<LatencyBackend>::createLogger(
+            makeBenchmarkSettings(std::string("stream_") + WAIT_STRATEGIES[state.range(0)], waitConfig(state)), backend);
+        const LevelId level = logger->level("INFO");
+        const ContextId context = logger->context("BENCHMARK");
+
+        for (auto _ : state) {
+            logger->log(level, context, "Streamed message");
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    reportPercentiles(state, backend.samples);
+}
+
+BENCHMARK(BM_WakeupLatency)->DenseRange(0, 2)->Iterations(2000);
+BENCHMARK(BM_StreamLatency)->DenseRange(0, 2)->Iterations(200000);
+
+BENCHMARK_MAIN();
@@ -2,6 +2,7 @@
 #define LOGGER_CONTROLLER_HPP
 
 #include "myLogger/my_logger.hpp"
+#include "myLogger/file_watcher.hpp"
 #include <atomic>
 #include <thread>
 
@@ -81,8 +82,7 @@ void LoggerController<LoggerType>::threadedLogging() {
     while (!exitFlag.load()) {
         std::thread logThread([&]() {
             for (int i = 0; i < 5; i++) {
-                logger.log("INFO", "MULTI_THREAD",
-                           ("Threaded log #" + std::to_string(i)).c_str());
+                logger.log("INFO", "MULTI_THREAD", "Threaded log #{}", i);
                 std::this_thread::sleep_for(std::chrono::milliseconds(500));
             }
         });
@@ -0,0 +1,94 @@
+#ifndef BACKEND_WORKER_HPP
+#define BACKEND_WORKER_HPP
+
+#include "myLogger/logger_core.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// One consumer batch, immutable once published and shared by every worker
+// that still has to write it; freed when the last one lets go.
+using SharedLogBatch = std::shared_ptr<const std::vector<LogMessage>>;
+
+// Snapshot of one backend's queue ("fan_out" dispatch mode)
+struct BackendStats {
+    std::size_t queuedMessages = 0;      // waiting for this backend right now
+    std::size_t peakQueuedMessages = 0;  // high-water mark of queuedMessages
+    std::uint64_t writtenMessages = 0;
+    std::uint64_t droppedMessages = 0;   // discarded because this backend fell behind
+    std::int64_t lastLagNs = 0;          // capture -> written, newest message of the last batch
+    std::int64_t maxLagNs = 0;
+};
+
+// What post() does once a backend's queue holds queue_max_messages
+// (backend_overflow_policy). Never blocks: post() runs on the logger thread,
+// and waiting there would stall every other backend too.
+enum class OverflowPolicy {
+    DropOldest,   // discard the oldest queued batches to make room
+    DropNewest    // discard the incoming batch
+};
+
+inline OverflowPolicy parseOverflowPolicy(std::string_view name) {
+    return name == "drop_newest" ? OverflowPolicy::DropNewest : OverflowPolicy::DropOldest;
+}
+
+//------------------------------------------------------------------------------
+// BackendWorker: Queue and thread of one backend in "fan_out" dispatch mode
+//
+// The logger thread posts each batch to every worker, so a backend that
+// blocks (stdout piped into a slow reader) only delays its own queue. A full
+// queue (queue_max_messages) is handled with backend_overflow_policy, for
+// this backend alone; what it discards is counted in droppedMessages.
+//------------------------------------------------------------------------------
+class BackendWorker {
+public:
+    using WriteFn = std::function<void(std::span<const LogMessage>)>;
+    using FlushFn = std::function<void()>;
+
+    struct Options {
+        std::size_t maxQueuedMessages = DEFAULT_QUEUE_MAX_MESSAGES;   // 0 = no limit
+        OverflowPolicy policy = OverflowPolicy::DropOldest;
+        bool flushWhenIdle = true;   // flush once the queue runs empty ("batch"/"auto" flush modes)
+    };
+
+    BackendWorker(WriteFn write, FlushFn flush, const Options& options);
+    ~BackendWorker();
+
+    BackendWorker(const BackendWorker&) = delete;
+    BackendWorker& operator=(const BackendWorker&) = delete;
+
+    void post(const SharedLogBatch& batch);
+
+    // Blocks until everything posted so far has been written and flushed
+    void waitIdle();
+
+    // Writes what is still queued, then joins the thread
+    void stop();
+
+    BackendStats stats() const;
+
+private:
+    WriteFn writeFn;
+    FlushFn flushFn;
+    Options options;
+
+    std::thread thread;
+    mutable std::mutex mutex;
+    std::condition_variable wake;       // worker: batches queued or stopping
+    std::condition_variable progress;   // waitIdle(): a batch was written
+    std::deque<SharedLogBatch> pending;
+    bool busy = false;
+    bool stopping = false;
+    BackendStats counters;              // guarded by mutex
+
+    void run();
+};
+
+#endif // BACKEND_WORKER_HPP
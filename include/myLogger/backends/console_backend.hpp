@@ -3,23 +3,58 @@
 
 #include "myLogger/logger_core.hpp"
 #include "myLogger/logger_config.hpp"
+#include "myLogger/structured_format.hpp"
 #include <iostream>
+#include <span>
+#include <string>
+#include <vector>
 
+// Renders lines from per-level and per-context pieces (ANSI color, tag) that
+// are resolved in setup() and again whenever the config is reloaded. Colors
+// are left out when stdout is not a terminal or enable_colors is off.
+// log_format = "json" or "logfmt" prints uncolored structured lines instead.
+// Control characters in message text are printed escaped (see text_escape.hpp)
+// so a logged string cannot drive the terminal.
 class ConsoleBackend {
 public:
     ConsoleBackend() = default;
 
     void setup(const LoggerSettings& settings);
     void write(const LogMessage& log, const LoggerSettings& settings);
+    void writeBatch(std::span<const LogMessage> batch, const LoggerSettings& settings);
     void flush();
     void shutdown();
 
 private:
+    struct Style {
+        std::string color;   // ANSI escape, empty when not colorizing
+        std::string tag;     // "[LEVEL] " / "CONTEXT: ", empty when hidden
+    };
+
     static int hexToAnsiColor(const std::string& hexColor);
+    std::string ansiColorFor(const LoggerSettings& settings, const std::string& key) const;
+    Style buildStyle(const LoggerSettings& settings, std::string_view name, bool isLevel) const;
+    void rebuildStyles(const LoggerSettings& settings);
+    const Style& contextStyle(ContextId context, const LoggerSettings& settings);
+    void appendLine(const LogMessage& log, const LoggerSettings& settings, std::string& out);
+    void writeOut(const std::string& data);
+
+    std::string batchBuffer;           // reused by write() and writeBatch()
 
     std::string colorMode = "level";   // Default mode
     bool hideLevelTag = false;         // Default: show level tags
     bool hideContextTag = false;       // Default: show context tags
+    bool colorize = false;             // enable_colors and a terminal to show them
+    bool colorByContext = false;       // color_mode = "context"
+    std::string_view reset;            // "\033[0m" when colorizing
+    LogFormat format = LogFormat::Plain;   // Json and Logfmt skip the styles
+
+    std::uint64_t stylesGeneration = 0;   // LoggerSettings::generation the tables were built from
+    std::vector<Style> levelStyles;       // indexed by LevelId
+    std::vector<Style> contextStyles;     // indexed by ContextId, grows as contexts appear
+    Style unknownLevel;
+    Style unknownContext;
+
     private:
     bool vtEnabled = false;
     bool isTty = true;
@@ -3,24 +3,89 @@
 
 #include "myLogger/logger_core.hpp"
 #include "myLogger/logger_config.hpp"
+#include "myLogger/log_rotator.hpp"
+#include "myLogger/binary_log_format.hpp"
+#include "myLogger/structured_format.hpp"
+#include <atomic>
+#include <climits>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <filesystem>
+#include <span>
 
+//------------------------------------------------------------------------------
+// FileBackend: Keeps the log file open from setup() to shutdown() and formats
+// into a reusable buffer. A batch from the core is formatted in full and
+// written with a single write() (earlier if the buffer fills); flush_mode =
+// "instant" writes and syncs every message instead. The file is rotated by
+// size and time (see LogRotator) between two records, on the consumer thread.
+// log_format picks the encoding: "plain", "json", "logfmt" (see
+// structured_format.hpp) or "binary" (BinaryLogEncoder records).
+//------------------------------------------------------------------------------
 class FileBackend {
 private:
     std::string logFilePath;
+    int fd = -1;
+    std::string buffer;
+    std::size_t bufferCapacity = DEFAULT_FILE_BUFFER_SIZE;
+    std::uint64_t fileSize = 0;   // bytes already written to the current file
+    LogRotator rotator;
+    LogFormat format = LogFormat::Plain;
+    BinaryLogEncoder encoder;
 
-    std::string resolveFilename(const std::string& format);
+    // A rotated file that failed to open is retried with every later batch;
+    // the records that arrive meanwhile are counted, not written
+    bool reopenPending = false;
+    std::uint64_t lostMessages = 0;
+
+    // For the fatal-signal path: a line buffer that never grows, and the
+    // local UTC offset looked up ahead of time (localtime_r is not
+    // async-signal-safe)
+    std::string emergencyLine;
+    std::atomic<std::int64_t> utcOffset{0};
+    std::int64_t utcOffsetCheckNs = INT64_MIN;   // refreshed from here on
+
+    void refreshUtcOffset(std::int64_t timeNs);
+
+    static std::string resolveFilename(const std::string& format);
+    void appendRecord(const LogMessage& log, const LoggerSettings& settings);
+    void encodeRecord(const LogMessage& log, const LoggerSettings& settings);
+    void rotate(std::int64_t timeNs, const LoggerSettings& settings);
+    void openFile(const LoggerSettings& settings);
+    bool ensureOpen(std::size_t records, const LoggerSettings& settings);
+    void loseBuffered(std::size_t records);
+    void writeBuffer();
+    void writeRange(const char* data, std::size_t size);
 
 public:
     FileBackend() = default;
+    ~FileBackend();
+
+    FileBackend(const FileBackend&) = delete;
+    FileBackend& operator=(const FileBackend&) = delete;
 
     void setup(const LoggerSettings& settings);
     void write(const LogMessage& log, const LoggerSettings& settings);
+    void writeBatch(std::span<const LogMessage> batch, const LoggerSettings& settings);
     void flush();
     void shutdown();
+
+    // Records lost because the log file could not be opened after a rotation
+    std::uint64_t lostMessageCount() const { return lostMessages; }
+
+    // Fatal-signal path (async-signal-safe, see CrashHandler): writes the
+    // buffered bytes, then single records in the file's text encoding and
+    // time zone. In json and logfmt a text too long for the line buffer is
+    // cut short. Binary logs only get the buffered bytes.
+    void emergencyFlush();
+    void emergencyWrite(std::int64_t timeNs, std::string_view level, std::string_view context,
+                        std::string_view text, const LoggerSettings& settings);
+
+    // Shared with the other file backends
+    static std::string prepareLogFilePath(const LoggerSettings& settings);   // creates the log directory
+    static void appendLine(const LogMessage& log, const LoggerSettings& settings, std::string& out);
+    static void appendText(const LogMessage& log, const LoggerSettings& settings, LogFormat format, std::string& out);
 };
 
 #endif // FILE_BACKEND_HPP
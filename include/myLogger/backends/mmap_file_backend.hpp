@@ -0,0 +1,66 @@
+#ifndef MMAP_FILE_BACKEND_HPP
+#define MMAP_FILE_BACKEND_HPP
+
+#include "myLogger/logger_core.hpp"
+#include "myLogger/logger_config.hpp"
+#include "myLogger/backends/file_backend.hpp"
+#include <span>
+
+//------------------------------------------------------------------------------
+// MmapFileBackend: Appends records into a preallocated, memory-mapped log
+// segment, so writing a message is a memcpy and no syscall.
+//
+// A segment of mmap_segment_size bytes is fallocate()d and mapped. When the
+// next record does not fit, the segment is truncated to its used length and
+// a fresh one is opened as "<name>.<n><ext>". Durability is governed by
+// mmap_msync ("none", "async" or "sync", applied per batch); flush_mode =
+// "instant" msyncs every record. setup() resumes in the newest existing
+// segment, after its last record: the zero-filled tail a crashed run leaves
+// is written over. Without mmap support (Windows) setup() falls back to a
+// plain FileBackend. log_format = "binary" is refused: the resume scan trims
+// trailing NUL bytes, which binary records may end in.
+//------------------------------------------------------------------------------
+class MmapFileBackend {
+public:
+    MmapFileBackend() = default;
+    ~MmapFileBackend();
+
+    MmapFileBackend(const MmapFileBackend&) = delete;
+    MmapFileBackend& operator=(const MmapFileBackend&) = delete;
+
+    void setup(const LoggerSettings& settings);
+    void write(const LogMessage& log, const LoggerSettings& settings);
+    void writeBatch(std::span<const LogMessage> batch, const LoggerSettings& settings);
+    void flush();
+    void shutdown();
+
+    // Path of the segment currently being written
+    const std::string& segmentPath() const { return currentPath; }
+
+private:
+    enum class SyncPolicy { None, Async, Sync };
+
+    FileBackend fallback;
+    bool mapped = false;   // false: forwarding to `fallback`
+
+    std::string basePath;
+    std::string currentPath;
+    int segmentIndex = 0;
+    std::size_t segmentSize = DEFAULT_MMAP_SEGMENT_SIZE;
+    SyncPolicy syncPolicy = SyncPolicy::None;
+
+    int fd = -1;
+    char* mapping = nullptr;
+    std::size_t mappedSize = 0;
+    std::size_t writePos = 0;
+    std::size_t syncedPos = 0;   // start of the range not yet msync()ed
+    LogFormat format = LogFormat::Plain;   // text encodings only; setup() rejects "binary"
+    std::string line;            // scratch for formatting one message
+
+    bool openSegment(std::size_t minSize);
+    void closeSegment();
+    void append(const LogMessage& log, const LoggerSettings& settings);
+    void syncRange(bool wait);
+};
+
+#endif // MMAP_FILE_BACKEND_HPP
@@ -13,10 +13,11 @@ public:
 
     void setup([[maybe_unused]] const LoggerSettings& settings) {}
 
-    void write(const LogMessage& log, [[maybe_unused]] const LoggerSettings& settings) {
-        std::cout << "[MockBackend] Writing log: " << log.message << std::endl;
+    void write(const LogMessage& log, const LoggerSettings& settings) {
+        std::cout << "[MockBackend] Writing log: " << log.message.view() << std::endl;
 
-        std::string logEntry = std::string(log.timestamp) + " [" + log.level + "] " + log.context + ": " + log.message;
+        std::string logEntry = std::string(log.timestamp()) + " [" + std::string(settings.levelName(log.level)) + "] "
+                             + std::string(settings.contextName(log.context)) + ": " + std::string(log.message);
         logEntries.push_back(std::move(logEntry));
     }
 
@@ -0,0 +1,58 @@
+#ifndef SHM_RING_BACKEND_HPP
+#define SHM_RING_BACKEND_HPP
+
+#include "myLogger/logger_core.hpp"
+#include "myLogger/logger_config.hpp"
+#include "myLogger/backends/file_backend.hpp"
+#include "myLogger/shm_ring.hpp"
+#include "myLogger/structured_format.hpp"
+#include <span>
+
+//------------------------------------------------------------------------------
+// ShmRingBackend: Hands records to a mylogger-collector process through a
+// shared-memory ring instead of writing a file of its own, so that a pool of
+// worker processes ends up in one merged, rotated log.
+//
+// setup() creates "/<shm_ring_name>.<pid>.<n>" with shm_ring_size bytes of
+// ring; writing a record is a memcpy into it, and each batch is published
+// with one release store. When the ring is full (collector slow, stopped or
+// crashed) records are dropped and counted in the segment, where the
+// collector picks the count up. Create the logger after fork(): a ring has
+// exactly one writer. Without shared memory (Windows) setup() falls back to
+// a plain FileBackend.
+//------------------------------------------------------------------------------
+class ShmRingBackend {
+public:
+    ShmRingBackend() = default;
+    ~ShmRingBackend();
+
+    ShmRingBackend(const ShmRingBackend&) = delete;
+    ShmRingBackend& operator=(const ShmRingBackend&) = delete;
+
+    void setup(const LoggerSettings& settings);
+    void write(const LogMessage& log, const LoggerSettings& settings);
+    void writeBatch(std::span<const LogMessage> batch, const LoggerSettings& settings);
+    void flush();
+    void shutdown();
+
+    // Fatal-signal path (see CrashHandler): memcpy and publish, nothing else
+    void emergencyFlush();
+    void emergencyWrite(std::int64_t timeNs, std::string_view level, std::string_view context,
+                        std::string_view text, const LoggerSettings& settings);
+
+    // Name of the segment being written, "" when falling back to a file
+    const std::string& segmentName() const { return name; }
+
+    // Records this process could not fit into the ring
+    std::uint64_t dropped() const { return ring.dropped(); }
+
+private:
+    FileBackend fallback;
+    ShmRing ring;
+    std::string name;
+    std::string scratch;   // message text plus its fields
+
+    void append(const LogMessage& log, const LoggerSettings& settings);
+};
+
+#endif // SHM_RING_BACKEND_HPP
@@ -0,0 +1,84 @@
+#ifndef URING_FILE_BACKEND_HPP
+#define URING_FILE_BACKEND_HPP
+
+#include "myLogger/logger_core.hpp"
+#include "myLogger/logger_config.hpp"
+#include "myLogger/backends/file_backend.hpp"
+#include <memory>
+#include <span>
+#include <vector>
+
+#define URING_BUFFER_COUNT 4   // buffers that can be in flight at once
+
+//------------------------------------------------------------------------------
+// UringFileBackend: Writes the log file through io_uring (Linux).
+//
+// Each batch is formatted into one of a small pool of registered buffers and
+// submitted as a single write at an explicit file offset; the consumer moves
+// on to the next buffer without waiting for the kernel. Completions are
+// reaped opportunistically, and only block when every buffer is in flight.
+//
+// When io_uring is not available (older kernel, seccomp, non-Linux builds)
+// setup() falls back to a plain FileBackend and all calls are forwarded. If
+// the ring fails later (io_uring_enter errors), the buffers the kernel may
+// still hold are rewritten with pwrite() and the file continues synchronously.
+//------------------------------------------------------------------------------
+class UringFileBackend {
+public:
+    UringFileBackend();
+    ~UringFileBackend();
+
+    UringFileBackend(const UringFileBackend&) = delete;
+    UringFileBackend& operator=(const UringFileBackend&) = delete;
+
+    void setup(const LoggerSettings& settings);
+    void write(const LogMessage& log, const LoggerSettings& settings);
+    void writeBatch(std::span<const LogMessage> batch, const LoggerSettings& settings);
+    void flush();
+    void shutdown();
+
+    // False when setup() fell back to buffered write(2), or the ring failed since
+    bool usingIoUring() const { return ring != nullptr && !ringFailed; }
+
+private:
+    struct Ring;   // kernel ring mappings, defined in the .cpp
+
+    struct Buffer {
+        std::unique_ptr<char[]> data;
+        std::size_t size = 0;
+        std::uint64_t offset = 0;   // file position of data[0] once submitted
+        bool inFlight = false;
+    };
+
+    FileBackend fallback;
+    std::unique_ptr<Ring> ring;
+
+    std::string logFilePath;
+    int fd = -1;
+    std::uint64_t fileOffset = 0;   // next write position; writes may complete out of order
+
+    std::vector<Buffer> buffers;
+    std::size_t bufferCapacity = DEFAULT_FILE_BUFFER_SIZE;
+    std::size_t current = 0;
+    std::size_t inFlight = 0;
+    bool ringFailed = false;                            // write with pwrite() from here on
+    std::vector<std::unique_ptr<char[]>> retired;       // buffers the failed ring may still read
+    LogFormat format = LogFormat::Plain;
+    BinaryLogEncoder encoder;   // log_format = "binary": header and session when the file opens
+    std::string line;   // scratch for formatting one message
+
+    bool openLogFile();
+    void closeLogFile();
+    void syncLogFile();
+    bool initRing();
+    void closeRing();
+    void append(const LogMessage& log, const LoggerSettings& settings);
+    void appendLine();
+    void submitCurrent();
+    void reapCompletions(unsigned minComplete);
+    void waitAll();
+    void abandonRing();
+    void writeAt(const char* data, std::size_t size, std::uint64_t offset);
+};
+
+#endif // URING_FILE_BACKEND_HPP
@@ -0,0 +1,71 @@
+#ifndef BINARY_LOG_FORMAT_HPP
+#define BINARY_LOG_FORMAT_HPP
+
+#include "myLogger/logger_core.hpp"
+#include "myLogger/logger_config.hpp"
+#include "myLogger/structured_format.hpp"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Binary log format (log_format = "binary")
+//
+//   file    := "MYLOGBIN" version:u8 record*
+//   record  := length:varint body[length]
+//   body    := type:u8 fields
+//
+//   Session  (1)  flags:varint tsFormatLength:varint tsFormat
+//                 starts a writer session: resets the dictionary and the
+//                 timestamp delta base (flags bit 0 = timestamps enabled)
+//   Level    (2)  id:varint name
+//   Context  (3)  id:varint name
+//   Message  (4)  timeDelta:zigzag-varint level:varint context:varint payload
+//   FieldMessage (5)  timeDelta level context textLength:varint text
+//                 count:varint field*       (a Message with structured fields)
+//
+//   field   := keyLength:varint key type:u8 value
+//   value   := Int: zigzag-varint | UInt: varint | Double: 8 bytes (host order)
+//              | Bool: u8 | String: length:varint bytes
+//
+// Level and context names are interned: each id is defined once per session,
+// right before its first use. Timestamps are nanoseconds since the epoch,
+// stored as the difference to the previous message.
+//------------------------------------------------------------------------------
+
+inline constexpr char BINARY_LOG_MAGIC[] = "MYLOGBIN";
+inline constexpr std::size_t BINARY_LOG_MAGIC_LENGTH = sizeof(BINARY_LOG_MAGIC) - 1;
+inline constexpr std::uint8_t BINARY_LOG_VERSION = 1;
+
+enum class BinaryRecordType : std::uint8_t {
+    Session = 1,
+    Level   = 2,
+    Context = 3,
+    Message = 4,
+    FieldMessage = 5
+};
+
+class BinaryLogEncoder {
+public:
+    // File magic; only for a file that is still empty
+    static void appendFileHeader(std::string& out);
+
+    // Starts a new session; call whenever a file is (re)opened
+    void beginSession(const LoggerSettings& settings, std::string& out);
+
+    void append(const LogMessage& log, const LoggerSettings& settings, std::string& out);
+
+private:
+    std::int64_t previousTimeNs = 0;
+    std::vector<bool> levelsDefined;
+    std::vector<bool> contextsDefined;
+    std::string body;   // FieldMessage under construction; its length goes first
+};
+
+// Turns a binary log back into the lines FileBackend would have written with
+// `format` (Binary means plain). Returns false and sets `error` on malformed
+// input; lines decoded so far are already written.
+bool decodeBinaryLog(std::istream& in, std::ostream& out, std::string& error, LogFormat format = LogFormat::Plain);
+
+#endif // BINARY_LOG_FORMAT_HPP
@@ -0,0 +1,78 @@
+#ifndef CONTEXT_REGISTRY_HPP
+#define CONTEXT_REGISTRY_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using ContextId = std::uint32_t;
+inline constexpr ContextId INVALID_CONTEXT_ID = UINT32_MAX;
+
+//------------------------------------------------------------------------------
+// ContextRegistry: Concurrent name <-> ContextId table
+//
+// Lookups are wait-free (hash bucket walk over append-only lists). Inserting
+// a new name is lock-free: the entry is published into the id table first,
+// then CAS-pushed onto its bucket. Entries live until the registry is
+// destroyed, so returned names stay valid. Ids are handed out densely and are
+// never reused; there is no upper bound besides ContextId's range.
+//
+// Two threads racing to add the same name may both be given an id; the loser's
+// id becomes an alias carrying the same name, and only the winner is
+// reported by names(). Per-context severities are not kept here; they are
+// part of each published LoggerSettings (contextSeverities).
+//------------------------------------------------------------------------------
+class ContextRegistry {
+public:
+    ContextRegistry();
+    ~ContextRegistry();
+
+    ContextRegistry(const ContextRegistry&) = delete;
+    ContextRegistry& operator=(const ContextRegistry&) = delete;
+
+    ContextId find(std::string_view name) const;
+    ContextId findOrAdd(std::string_view name);
+
+    std::string_view name(ContextId id) const;
+    std::size_t size() const { return nextId.load(std::memory_order_acquire); }
+
+    // Canonical names registered so far, in id order
+    std::vector<std::string> names() const;
+
+private:
+    struct Entry {
+        std::string name;
+        std::size_t hash;
+        ContextId id;
+        Entry* next;
+    };
+
+    struct Slot {
+        std::atomic<const Entry*> entry{nullptr};
+    };
+
+    static constexpr std::size_t BUCKET_COUNT = 1024;
+    static constexpr unsigned FIRST_SEGMENT_BITS = 6;   // first segment holds 64 ids
+    static constexpr std::size_t SEGMENT_COUNT = 32 - FIRST_SEGMENT_BITS;
+
+    struct SegmentIndex {
+        std::size_t segment;
+        std::size_t offset;
+    };
+
+    static SegmentIndex locate(ContextId id);
+    static std::size_t segmentSize(std::size_t segment);
+    const Entry* findEntry(std::string_view name, std::size_t hash, const Entry* from) const;
+    Slot* slotFor(ContextId id) const;
+    Slot& ensureSlot(ContextId id);
+
+    std::array<std::atomic<Entry*>, BUCKET_COUNT> buckets{};
+    std::array<std::atomic<Slot*>, SEGMENT_COUNT> segments{};
+    std::atomic<ContextId> nextId{0};
+};
+
+#endif // CONTEXT_REGISTRY_HPP
@@ -0,0 +1,36 @@
+#ifndef CRASH_HANDLER_HPP
+#define CRASH_HANDLER_HPP
+
+#define MAX_CRASH_DRAINS 8   // Loggers that can register at the same time
+#define CRASH_STACK_SIZE (64 * 1024)   // Alternate signal stack per prepared thread (at least SIGSTKSZ)
+
+//------------------------------------------------------------------------------
+// CrashHandler: Emergency drain on fatal signals (crash_handler = true)
+//
+// On SIGSEGV, SIGABRT, SIGBUS or SIGFPE each registered logger writes what it
+// still holds straight to its open log files, using async-signal-safe calls
+// only. The previous disposition is then restored and the signal raised
+// again, so core dumps and other handlers still see it. A second thread that
+// faults while the drain runs waits for the first to finish. The handler
+// runs on an alternate signal stack, so a stack overflow can still be
+// drained, but only in threads that have one: install() prepares the calling
+// thread and the logger prepares its consumer thread; other threads call
+// prepareThread() themselves. POSIX only; both do nothing on Windows.
+//------------------------------------------------------------------------------
+class CrashHandler {
+public:
+    // Runs inside the signal handler; `signal` is the signal being handled
+    using DrainFn = void (*)(void* owner, int signal);
+
+    // Installs the handlers once per process, and prepares the calling thread
+    static void install();
+
+    // Gives the calling thread an alternate signal stack unless it has one;
+    // it is released when the thread exits
+    static void prepareThread();
+
+    static bool add(void* owner, DrainFn drain);   // false when all slots are taken
+    static void remove(void* owner);
+};
+
+#endif // CRASH_HANDLER_HPP
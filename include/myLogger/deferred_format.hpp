@@ -0,0 +1,223 @@
+#ifndef DEFERRED_FORMAT_HPP
+#define DEFERRED_FORMAT_HPP
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#define MAX_DEFERRED_ARGS_SIZE 64  // Bytes of raw argument storage per message
+
+//------------------------------------------------------------------------------
+// DeferredFormatString: The format of a deferred log call
+//
+// The consumer reads the format long after the call returns, so only a string
+// literal (or another constant expression) converts to it; a format built at
+// runtime does not compile. Use the std::string_view overloads for those.
+//------------------------------------------------------------------------------
+class DeferredFormatString {
+public:
+    template <std::size_t N>
+    consteval DeferredFormatString(const char (&literal)[N]) : text(literal) {}
+
+    constexpr const char* c_str() const { return text; }
+
+private:
+    const char* text;
+};
+
+namespace deferred_detail {
+
+    template <typename T>
+    using Decayed = std::remove_cv_t<std::decay_t<T>>;
+
+    template <typename T>
+    inline constexpr bool isStringArg =
+        std::is_same_v<Decayed<T>, const char*> || std::is_same_v<Decayed<T>, char*> ||
+        std::is_same_v<Decayed<T>, std::string_view> || std::is_same_v<Decayed<T>, std::string>;
+
+    // How an argument travels: strings as a copy of their bytes, the rest by value
+    template <typename T>
+    using Stored = std::conditional_t<isStringArg<T>, std::string_view, Decayed<T>>;
+
+} // namespace deferred_detail
+
+//------------------------------------------------------------------------------
+// Arguments that can be captured and formatted later on the consumer thread.
+// Strings (const char*, std::string, std::string_view) are copied into the
+// message, so temporaries such as s.c_str() are fine.
+//------------------------------------------------------------------------------
+template <typename T>
+concept DeferredFormatArg = std::is_arithmetic_v<deferred_detail::Decayed<T>> ||
+                            std::is_enum_v<deferred_detail::Decayed<T>> ||
+                            deferred_detail::isStringArg<T>;
+
+namespace deferred_detail {
+
+    constexpr std::size_t alignUp(std::size_t offset, std::size_t alignment) {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Bytes the fixed-size arguments need; strings add their length
+    template <typename... Stored>
+    constexpr std::size_t packedSize() {
+        std::size_t offset = 0;
+        ((offset = std::is_same_v<Stored, std::string_view>
+                       ? alignUp(offset, alignof(std::uint32_t)) + sizeof(std::uint32_t)
+                       : alignUp(offset, alignof(Stored)) + sizeof(Stored)), ...);
+        return offset;
+    }
+
+    template <typename T>
+    Stored<T> toStored(const T& value) {
+        if constexpr (std::is_pointer_v<Decayed<T>>) {
+            return value ? std::string_view{value} : std::string_view{"(null)"};
+        } else {
+            return value;
+        }
+    }
+
+    template <typename T>
+    void appendArg(std::string& out, T value) {
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            out += value;
+        } else if constexpr (std::is_same_v<T, bool>) {
+            out += value ? "true" : "false";
+        } else if constexpr (std::is_same_v<T, char>) {
+            out += value;
+        } else if constexpr (std::is_enum_v<T>) {
+            appendArg(out, static_cast<std::underlying_type_t<T>>(value));
+        } else {
+            char buf[64];
+            const auto result = std::to_chars(buf, buf + sizeof(buf), value);
+            out.append(buf, result.ptr);
+        }
+    }
+
+    // Copies the literal text of `format` up to the next "{}" placeholder,
+    // handling "{{" / "}}" escapes. Returns the position after the placeholder,
+    // or nullptr when the format string is exhausted.
+    inline const char* appendUntilPlaceholder(std::string& out, const char* format) {
+        while (*format) {
+            if (format[0] == '{' && format[1] == '}') return format + 2;
+            if ((format[0] == '{' && format[1] == '{') || (format[0] == '}' && format[1] == '}')) {
+                out += *format;
+                format += 2;
+                continue;
+            }
+            out += *format++;
+        }
+        return nullptr;
+    }
+
+    // Appends values to a fixed buffer; a string is its u32 length and bytes
+    struct ArgWriter {
+        std::byte* data;
+        std::size_t capacity;
+        std::size_t offset = 0;
+        bool fits = true;
+
+        void bytes(const void* src, std::size_t size) {
+            if (!fits || offset + size > capacity) {
+                fits = false;
+                return;
+            }
+            std::memcpy(data + offset, src, size);
+            offset += size;
+        }
+
+        template <typename T>
+        void put(const T& value) {
+            if constexpr (std::is_same_v<T, std::string_view>) {
+                put(static_cast<std::uint32_t>(value.size()));
+                bytes(value.data(), value.size());
+            } else {
+                offset = alignUp(offset, alignof(T));
+                bytes(&value, sizeof(T));
+            }
+        }
+    };
+
+    template <typename T>
+    T unpackArg(const std::byte* src, std::size_t& offset) {
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            const auto size = unpackArg<std::uint32_t>(src, offset);
+            const std::string_view text{reinterpret_cast<const char*>(src + offset), size};
+            offset += size;
+            return text;
+        } else {
+            T value{};
+            offset = alignUp(offset, alignof(T));
+            std::memcpy(&value, src + offset, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+    }
+
+    // Fills the placeholders of `format` with `values`, in order
+    template <typename... Values>
+    void formatValues(std::string& out, const char* format, const Values&... values) {
+        const char* cursor = format;
+        auto appendNext = [&](const auto& value) {
+            if (!cursor) return;
+            cursor = appendUntilPlaceholder(out, cursor);
+            if (cursor) appendArg(out, value);
+        };
+        (appendNext(values), ...);
+
+        // Placeholders without a matching argument are kept verbatim
+        while (cursor && (cursor = appendUntilPlaceholder(out, cursor))) {
+            out += "{}";
+        }
+    }
+
+    // Instantiated once per argument pack; stored as a function pointer in the message.
+    template <typename... Stored>
+    void formatPacked(const char* format, const std::byte* src, std::string& out) {
+        std::size_t offset = 0;
+        // Braced init: the arguments are unpacked left to right
+        std::apply([&](const auto&... values) { formatValues(out, format, values...); },
+                   std::tuple<Stored...>{unpackArg<Stored>(src, offset)...});
+    }
+
+} // namespace deferred_detail
+
+//------------------------------------------------------------------------------
+// DeferredArgs: Format string pointer + raw argument bytes (and copies of
+// string arguments) captured on the producer; turned into text by the
+// consumer thread.
+//------------------------------------------------------------------------------
+struct DeferredArgs {
+    using FormatFn = void (*)(const char* format, const std::byte* args, std::string& out);
+
+    const char* format = nullptr;
+    FormatFn formatFn = nullptr;
+    alignas(std::max_align_t) std::array<std::byte, MAX_DEFERRED_ARGS_SIZE> args;
+
+    // Returns false, leaving nothing pending, when string arguments do not fit
+    template <DeferredFormatArg... Args>
+    bool capture(DeferredFormatString fmt, const Args&... values) {
+        static_assert(deferred_detail::packedSize<deferred_detail::Stored<Args>...>() <= MAX_DEFERRED_ARGS_SIZE,
+                      "Too many deferred log arguments; raise MAX_DEFERRED_ARGS_SIZE");
+        deferred_detail::ArgWriter writer{args.data(), args.size()};
+        (writer.put(deferred_detail::toStored(values)), ...);
+        if (!writer.fits) return false;
+
+        format = fmt.c_str();
+        formatFn = &deferred_detail::formatPacked<deferred_detail::Stored<Args>...>;
+        return true;
+    }
+
+    bool pending() const { return formatFn != nullptr; }
+
+    void formatInto(std::string& out) const {
+        formatFn(format, args.data(), out);
+    }
+};
+
+#endif // DEFERRED_FORMAT_HPP
@@ -9,6 +9,7 @@
 #include <thread>
 #include <cerrno>
 #include <iostream>
+#include <vector>
 
 #if !defined(_WIN32)
   #include <sys/inotify.h>
@@ -0,0 +1,181 @@
+#ifndef LOG_FIELDS_HPP
+#define LOG_FIELDS_HPP
+
+#include "myLogger/message_payload.hpp"
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+
+#define MAX_FIELD_KEY_LENGTH 255   // longer keys are cut
+
+enum class FieldType : std::uint8_t {
+    Int    = 0,
+    UInt   = 1,
+    Double = 2,
+    Bool   = 3,
+    String = 4
+};
+
+//------------------------------------------------------------------------------
+// FieldValue: One structured field value as passed to log(); strings are
+// only viewed here and copied once, into the message's LogFields
+//------------------------------------------------------------------------------
+struct FieldValue {
+    FieldType type = FieldType::Int;
+    union {
+        std::int64_t i;
+        std::uint64_t u;   // also Bool: 0 or 1
+        double d;
+    };
+    std::string_view s;
+
+    FieldValue() : i(0) {}
+    FieldValue(bool value) : type(FieldType::Bool), u(value ? 1 : 0) {}
+    template <std::signed_integral T>
+    FieldValue(T value) : type(FieldType::Int), i(value) {}
+    template <std::unsigned_integral T>
+        requires (!std::same_as<T, bool>)
+    FieldValue(T value) : type(FieldType::UInt), u(value) {}
+    template <std::floating_point T>
+    FieldValue(T value) : type(FieldType::Double), d(static_cast<double>(value)) {}
+    FieldValue(const char* value) : type(FieldType::String), i(0), s(value ? value : "") {}
+    FieldValue(std::string_view value) : type(FieldType::String), i(0), s(value) {}
+    FieldValue(const std::string& value) : type(FieldType::String), i(0), s(value) {}
+};
+
+struct LogField {
+    std::string_view key;
+    FieldValue value;
+};
+
+//------------------------------------------------------------------------------
+// LogFields: The structured fields of one message, packed into one buffer
+//
+//   field := type:u8 keyLength:u8 key value
+//   value := 8 bytes (Int, UInt, Double, Bool) | length:u32 bytes (String)
+//
+// The buffer is a SlabArena slab, so capturing fields costs one copy and no
+// allocation once the pool is warm; a message without fields carries a null
+// pointer only. forEach() hands back FieldValues viewing into the buffer.
+//------------------------------------------------------------------------------
+class LogFields {
+public:
+    LogFields() = default;
+    LogFields(std::initializer_list<LogField> fields) { assign({fields.begin(), fields.size()}); }
+
+    LogFields(const LogFields& other) { copyFrom(other); }
+    LogFields(LogFields&& other) noexcept : packed(other.packed), length(other.length) {
+        other.packed = nullptr;
+        other.length = 0;
+    }
+
+    LogFields& operator=(const LogFields& other) {
+        if (this != &other) {
+            clear();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    LogFields& operator=(LogFields&& other) noexcept {
+        if (this != &other) {
+            clear();
+            packed = other.packed;
+            length = other.length;
+            other.packed = nullptr;
+            other.length = 0;
+        }
+        return *this;
+    }
+
+    ~LogFields() { clear(); }
+
+    void assign(std::span<const LogField> fields) {
+        clear();
+        std::size_t bytes = 0;
+        for (const auto& field : fields) bytes += packedSize(field);
+        if (bytes == 0) return;
+
+        packed = SlabArena::instance().acquire(bytes);
+        length = static_cast<std::uint32_t>(bytes);
+        char* out = packed;
+        for (const auto& field : fields) {
+            const auto key = field.key.substr(0, MAX_FIELD_KEY_LENGTH);
+            *out++ = static_cast<char>(field.value.type);
+            *out++ = static_cast<char>(key.size());
+            std::memcpy(out, key.data(), key.size());
+            out += key.size();
+            if (field.value.type == FieldType::String) {
+                const auto size = static_cast<std::uint32_t>(field.value.s.size());
+                std::memcpy(out, &size, sizeof(size));
+                std::memcpy(out + sizeof(size), field.value.s.data(), size);
+                out += sizeof(size) + size;
+            } else {
+                std::memcpy(out, &field.value.u, sizeof(std::uint64_t));
+                out += sizeof(std::uint64_t);
+            }
+        }
+    }
+
+    void clear() {
+        if (packed) {
+            SlabArena::instance().release(packed, length);
+            packed = nullptr;
+        }
+        length = 0;
+    }
+
+    bool empty() const { return length == 0; }
+    std::size_t size() const { return length; }   // packed bytes
+
+    // The packed form; equal field lists pack to equal bytes
+    std::string_view bytes() const { return {packed, length}; }
+
+    // Calls visit(std::string_view key, const FieldValue& value) per field, in order
+    template <typename F>
+    void forEach(F&& visit) const {
+        const char* in = packed;
+        const char* end = packed + length;
+        while (in < end) {
+            FieldValue value;
+            value.type = static_cast<FieldType>(*in++);
+            const auto keyLength = static_cast<unsigned char>(*in++);
+            const std::string_view key{in, keyLength};
+            in += keyLength;
+            if (value.type == FieldType::String) {
+                std::uint32_t size = 0;
+                std::memcpy(&size, in, sizeof(size));
+                value.s = {in + sizeof(size), size};
+                in += sizeof(size) + size;
+            } else {
+                std::memcpy(&value.u, in, sizeof(std::uint64_t));
+                in += sizeof(std::uint64_t);
+            }
+            visit(key, value);
+        }
+    }
+
+private:
+    char* packed = nullptr;
+    std::uint32_t length = 0;
+
+    static std::size_t packedSize(const LogField& field) {
+        const std::size_t value = field.value.type == FieldType::String ? sizeof(std::uint32_t) + field.value.s.size()
+                                                                         : sizeof(std::uint64_t);
+        return 2 + std::min<std::size_t>(field.key.size(), MAX_FIELD_KEY_LENGTH) + value;
+    }
+
+    void copyFrom(const LogFields& other) {
+        if (other.empty()) return;
+        packed = SlabArena::instance().acquire(other.length);
+        length = other.length;
+        std::memcpy(packed, other.packed, length);
+    }
+};
+
+#endif // LOG_FIELDS_HPP
@@ -0,0 +1,48 @@
+#ifndef LOG_LEVEL_HPP
+#define LOG_LEVEL_HPP
+
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+//------------------------------------------------------------------------------
+// Typed levels for Logger::log<Level::...>()
+//
+// The standard level names, known at compile time. Their LevelIds still come
+// from [levels] at runtime; LoggerSettings::Levels maps each one to its id
+// and effective severity on every (re)load.
+//
+// MYLOGGER_MIN_LEVEL (CMake option of the same name) drops typed calls below
+// that level at compile time.
+//------------------------------------------------------------------------------
+enum class Level : std::uint8_t {
+    Verbose,
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Critical
+};
+
+inline constexpr std::size_t TYPED_LEVEL_COUNT = 6;
+static_assert(TYPED_LEVEL_COUNT <= 8, "typed levels are kept as one bit each in a uint8_t mask");
+
+inline constexpr std::array<std::string_view, TYPED_LEVEL_COUNT> TYPED_LEVEL_NAMES = {
+    "VERBOSE", "DEBUG", "INFO", "WARN", "ERROR", "CRITICAL"
+};
+
+// Severity of a typed level that is switched off or missing from [levels]
+inline constexpr int LEVEL_DISABLED = INT_MIN;
+
+#ifndef MYLOGGER_MIN_LEVEL
+#define MYLOGGER_MIN_LEVEL 0   // Level::Verbose: everything compiled in
+#endif
+
+inline constexpr Level COMPILED_MIN_LEVEL = static_cast<Level>(MYLOGGER_MIN_LEVEL);
+
+template <Level L>
+inline constexpr bool levelCompiledIn = L >= COMPILED_MIN_LEVEL;
+
+#endif // LOG_LEVEL_HPP
@@ -0,0 +1,92 @@
+#ifndef LOG_ROTATOR_HPP
+#define LOG_ROTATOR_HPP
+
+#include "myLogger/logger_config.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+//------------------------------------------------------------------------------
+// LogRotator: Decides when a log file is due for rotation and disposes of the
+// rotated files off the logging path.
+//
+// A file rotates once it reaches rotation_size bytes or once a record's
+// capture time crosses the next rotation_interval boundary (0 disables
+// either trigger). The owner closes the old file and calls retire(); a
+// low-priority helper thread then gzips it (when built with zlib and
+// compress_rotated is set) and deletes rotated logs older than
+// log_rotation_days. Neither the consumer nor producers wait on it.
+//
+// Retention only touches files whose names log_filename_format could have
+// produced, with this rotator's ".N" suffix and ".gz" allowed, so other
+// files in a shared log directory are left alone.
+//------------------------------------------------------------------------------
+class LogRotator {
+public:
+    LogRotator() = default;
+    ~LogRotator();
+
+    LogRotator(const LogRotator&) = delete;
+    LogRotator& operator=(const LogRotator&) = delete;
+
+    // Reads the rotation keys; `activePath` was opened at `openedAtNs`.
+    // Also queues a retention sweep of the log directory.
+    void configure(const LoggerSettings& settings, const std::string& activePath, std::int64_t openedAtNs);
+
+    // True when appending `pendingBytes` to a file of `fileSize` bytes, for a
+    // record captured at `timeNs`, should go to a fresh file instead.
+    bool due(std::uint64_t fileSize, std::uint64_t pendingBytes, std::int64_t timeNs) const;
+
+    // Path for the next file. `resolved` is the freshly resolved filename; a
+    // numeric suffix is added when that name was used already (same second, or
+    // a format without time fields) or a file by that name exists.
+    std::string nextPath(const std::string& resolved);
+
+    // Hands the closed file to the helper thread; `activePath` (opened at
+    // `timeNs`) starts the next interval.
+    void retire(const std::string& closedPath, const std::string& activePath, std::int64_t timeNs);
+
+    // Waits until queued compression and cleanup work is done, then stops the helper
+    void shutdown();
+
+    // True when `filename` is one the rotator may have written for the
+    // strftime `format`: the resolved name, optionally with a ".N" sequence
+    // before its extension and a ".gz" suffix.
+    static bool isRotatedName(std::string_view filename, std::string_view format);
+
+private:
+    // What the helper thread needs from the settings; copied under `mutex`
+    struct Disposal {
+        bool compress = true;
+        int retentionDays = 0;
+        std::string logDirectory;
+        std::string filenameFormat;
+    };
+
+    // Consumer thread only
+    std::uint64_t maxBytes = 0;
+    std::int64_t intervalNs = 0;
+    std::int64_t nextRotationNs = 0;
+    std::string lastResolved;
+    int sequence = 0;
+
+    std::thread helper;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::string> pending;   // rotated files; "" requests a retention sweep only
+    std::string active;                // never removed by the retention sweep
+    Disposal disposal;
+    bool stopping = false;
+
+    void scheduleNext(std::int64_t timeNs);
+    void enqueue(std::string path, const std::string& activePath);
+    void run();
+    static void sweepRetention(const Disposal& policy, const std::string& activePath);
+    static bool compressFile(const std::string& path);
+};
+
+#endif // LOG_ROTATOR_HPP
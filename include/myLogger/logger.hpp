@@ -3,16 +3,24 @@
 
 #include "myLogger/logger_core.hpp"
 #include "myLogger/logger_config.hpp"
+#include "myLogger/backend_worker.hpp"
+#include <array>
 #include <memory>
 #include <tuple>
+#include <utility>
+#include <vector>
 #include <iostream>
-#include <unordered_set>
+#include <algorithm>
 #include <fstream>
 #include <mutex>
 #include <filesystem>
+#include <span>
 
 //------------------------------------------------------------------------------
 // LoggerBackends: Manages multiple logging backends
+//
+// dispatch_mode = "serial" writes every batch to each backend in turn on the
+// logger thread; "fan_out" gives each backend a BackendWorker of its own.
 //------------------------------------------------------------------------------
 template <typename... Backends>
 struct LoggerBackends {
@@ -23,19 +31,98 @@ struct LoggerBackends {
         std::apply([&](auto&... backend) { ((backend.write(logMsg, settings)), ...); }, backends);
     }
 
+    void dispatchBatch(std::span<const LogMessage> batch, const LoggerSettings& settings) {
+        std::apply([&](auto&... backend) { ((writeBatchIfAvailable(backend, batch, settings)), ...); }, backends);
+    }
+
+    // In "fan_out" mode: waits until every worker has written and flushed
     void flush() {
+        if (fanOutMode) {
+            for (auto& worker : workers) worker->waitIdle();
+            return;
+        }
         std::apply([&](auto&... backend) { ((flushIfAvailable(backend)), ...); }, backends);
     }
 
-    void setup(const LoggerSettings& settings) {
+    void setup(const SettingsSnapshots& snapshots) {
+        const LoggerSettings& settings = snapshots.current();
         std::apply([&](auto&... backend) { ((backend.setup(settings)), ...); }, backends);
+        if (settings.config.general.dispatchMode == "fan_out" && !fanOutMode) {
+            startWorkers(snapshots, std::index_sequence_for<Backends...>{});
+        }
     }
 
     void shutdown() {
+        stopWorkers();
         std::apply([&](auto&... backend) { ((shutdownIfAvailable(backend)), ...); }, backends);
     }
 
+    bool fanOut() const { return fanOutMode; }
+
+    // Fatal-signal path; only backends that provide it (FileBackend) take part
+    void emergencyFlush() {
+        std::apply([&](auto&... backend) { ((emergencyFlushIfAvailable(backend)), ...); }, backends);
+    }
+
+    void emergencyWrite(std::int64_t timeNs, std::string_view level, std::string_view context,
+                        std::string_view text, const LoggerSettings& settings) {
+        std::apply([&](auto&... backend) {
+            ((emergencyWriteIfAvailable(backend, timeNs, level, context, text, settings)), ...);
+        }, backends);
+    }
+
+    void publish(const SharedLogBatch& batch) {
+        for (auto& worker : workers) worker->post(batch);
+    }
+
+    // Per backend, in template argument order; all zero in "serial" mode
+    std::vector<BackendStats> stats() const {
+        std::vector<BackendStats> result(sizeof...(Backends));
+        if (fanOutMode) {
+            for (std::size_t i = 0; i < workers.size(); ++i) result[i] = workers[i]->stats();
+        }
+        return result;
+    }
+
 private:
+    bool fanOutMode = false;
+    std::array<std::unique_ptr<BackendWorker>, sizeof...(Backends)> workers;
+
+    template <std::size_t... I>
+    void startWorkers(const SettingsSnapshots& snapshots, std::index_sequence<I...>) {
+        const auto& general = snapshots.current().config.general;
+        BackendWorker::Options options;
+        options.maxQueuedMessages = static_cast<std::size_t>(std::max<std::int64_t>(general.queueMaxMessages, 0));
+        options.policy = parseOverflowPolicy(general.backendOverflowPolicy);
+        options.flushWhenIdle = general.flushMode != "instant";
+
+        ((workers[I] = std::make_unique<BackendWorker>(
+              [this, &snapshots](std::span<const LogMessage> batch) {
+                  writeBatchIfAvailable(std::get<I>(backends), batch, snapshots.current());
+              },
+              [this] { flushIfAvailable(std::get<I>(backends)); },
+              options)), ...);
+        fanOutMode = true;
+    }
+
+    void stopWorkers() {
+        if (!fanOutMode) return;
+        for (auto& worker : workers) worker->stop();
+    }
+
+    // Backends that can amortize work over a batch provide writeBatch(); the
+    // rest get one write() per message.
+    template <typename B>
+    void writeBatchIfAvailable(B& backend, std::span<const LogMessage> batch, const LoggerSettings& settings) {
+        if constexpr (requires { backend.writeBatch(batch, settings); }) {
+            backend.writeBatch(batch, settings);
+        } else {
+            for (const auto& logMsg : batch) {
+                backend.write(logMsg, settings);
+            }
+        }
+    }
+
     template <typename B>
 void flushIfAvailable(B& backend) {
         if constexpr (requires { backend.flush(); }) {
@@ -43,6 +130,21 @@ void flushIfAvailable(B& backend) {
         }
     }
 
+    template <typename B>
+    void emergencyFlushIfAvailable(B& backend) {
+        if constexpr (requires { backend.emergencyFlush(); }) {
+            backend.emergencyFlush();
+        }
+    }
+
+    template <typename B>
+    void emergencyWriteIfAvailable(B& backend, std::int64_t timeNs, std::string_view level, std::string_view context,
+                                   std::string_view text, const LoggerSettings& settings) {
+        if constexpr (requires { backend.emergencyWrite(timeNs, level, context, text, settings); }) {
+            backend.emergencyWrite(timeNs, level, context, text, settings);
+        }
+    }
+
     template <typename B>
     void shutdownIfAvailable(B& backend) {
         if constexpr (requires { backend.shutdown(); }) {
@@ -60,20 +162,61 @@ public:
     static std::unique_ptr<Logger<Backends...>> createLogger(std::shared_ptr<LoggerSettings> s, Backends&... backends);
     Logger(std::shared_ptr<LoggerSettings> s, Backends&... backends);
     ~Logger();
+
+    // Resolve names once, then log through the ids; INVALID_LEVEL_ID for unknown levels.
+    // context() registers names it has not seen before without taking a lock.
+    LevelId level(std::string_view name) const;
+    ContextId context(std::string_view name);
+
+    void log(LevelId level, ContextId context, std::string_view message);
     void log(std::string_view level, std::string_view context, std::string_view message);
+
+    // Deferred formatting: only `format` (a string literal) and the argument
+    // bytes are queued; "{}" placeholders are rendered on the logger thread.
+    template <DeferredFormatArg... Args>
+        requires (sizeof...(Args) > 0)
+    void log(LevelId level, ContextId context, DeferredFormatString format, const Args&... args);
+    template <DeferredFormatArg... Args>
+        requires (sizeof...(Args) > 0)
+    void log(std::string_view level, std::string_view context, DeferredFormatString format, const Args&... args);
+
+    // Structured fields: log(level, ctx, "Request done", {{"user_id", 42}, {"latency_us", 913}}).
+    // Keys and values are packed into one recycled buffer; backends encode
+    // them per log_format on the logger thread.
+    void log(LevelId level, ContextId context, std::string_view message, std::initializer_list<LogField> fields);
+    void log(std::string_view level, std::string_view context, std::string_view message,
+             std::initializer_list<LogField> fields);
+
+    // Typed levels: calls below MYLOGGER_MIN_LEVEL compile to nothing, the
+    // rest test their enablement with one load: the context's mask of typed
+    // levels in the current settings snapshot.
+    template <Level L>
+    void log(ContextId context, std::string_view message);
+    template <Level L, DeferredFormatArg... Args>
+        requires (sizeof...(Args) > 0)
+    void log(ContextId context, DeferredFormatString format, const Args&... args);
+    template <Level L>
+    void log(ContextId context, std::string_view message, std::initializer_list<LogField> fields);
+
     void updateSettings(const std::string& configFile);
     void shutdown();
 
+    // Messages discarded by backpressure_policy since startup
+    std::uint64_t droppedMessages(LevelId level) const { return logCore.droppedMessages(level); }
+    std::uint64_t droppedMessages() const { return logCore.droppedMessages(); }
+
+    // Queue depth and lag per backend ("fan_out" dispatch mode)
+    std::vector<BackendStats> backendStats() const { return backendsWrapper.stats(); }
+
 private:
-    std::shared_ptr<LoggerSettings> settings;
+    SettingsSnapshots settings;   // immutable snapshots, replaced by updateSettings()
     std::tuple<Backends&...> backendStorage;
     LoggerBackends<Backends...> backendsWrapper;
     LoggerCore<LoggerBackends<Backends...>> logCore;
 
-    mutable std::unordered_set<std::string> trackedContexts;
-    mutable std::mutex contextMutex;
-
-    bool shouldLog(std::string_view level, std::string_view context) const;
+    bool shouldLog(LevelId level, ContextId context) const;
+    template <Level L>
+    LevelId typedLevelIfEnabled(ContextId context) const;
     void updateConfigWithNewContexts();
 };
 
@@ -90,14 +233,16 @@ std::unique_ptr<Logger<Backends...>> Logger<Backends...>::createLogger(std::shar
 //------------------------------------------------------------------------------
 template <typename... Backends>
 Logger<Backends...>::Logger(std::shared_ptr<LoggerSettings> s, Backends&... backends)
-    : settings(std::move(s))
+    : settings()
     , backendStorage(backends...)
     , backendsWrapper(backends...)
     , logCore()
 {
-    LoggerConfig::loadOrGenerateConfig("config/logger.conf", *settings);
-    logCore.setBackends(backendsWrapper, *settings);
-    backendsWrapper.setup(*settings);
+    assert(s && "Logger settings must not be null");
+    LoggerConfig::loadOrGenerateConfig(s->configPath, *s);
+    settings.publish(std::move(s));     // not modified from here on
+    backendsWrapper.setup(settings);    // before the consumer thread can dispatch to them
+    logCore.setBackends(backendsWrapper, settings);
 }
 
 //------------------------------------------------------------------------------
@@ -124,9 +269,18 @@ void Logger<Backends...>::shutdown() {
 //------------------------------------------------------------------------------
 template <typename... Backends>
 void Logger<Backends...>::updateConfigWithNewContexts() {
-    if (trackedContexts.empty()) return;
+    // Contexts discovered while logging that [contexts] does not list yet
+    const auto snapshot = settings.latest();
+    const auto& configured = snapshot->config.contexts.contextNames;
+    std::vector<std::string> discovered;
+    for (auto& name : snapshot->contextRegistry->names()) {
+        if (std::find(configured.begin(), configured.end(), name) == configured.end()) {
+            discovered.push_back(std::move(name));
+        }
+    }
+    if (discovered.empty()) return;
 
-    std::string configFile = "config/logger.conf";
+    const std::string& configFile = snapshot->configPath;
     toml::table config;
 
     // ✅ Load existing config if possible
@@ -155,19 +309,14 @@ void Logger<Backends...>::updateConfigWithNewContexts() {
     }
     auto& colorsContextTable = *colorsTable["context"].as_table();
 
-    {
-        std::lock_guard<std::mutex> lock(contextMutex);
-
-        // ✅ Add missing contexts with default severity and color
-        for (const auto& context : trackedContexts) {
-            if (!contextsTable.contains(context)) {
-                contextsTable.insert(context, "INFO");  // Default log level
-            }
-            if (!colorsContextTable.contains(context)) {
-                colorsContextTable.insert(context, "WHITE");  // Default white color
-            }
+    // ✅ Add missing contexts with default severity and color
+    for (const auto& context : discovered) {
+        if (!contextsTable.contains(context)) {
+            contextsTable.insert(context, "INFO");  // Default log level
+        }
+        if (!colorsContextTable.contains(context)) {
+            colorsContextTable.insert(context, "WHITE");  // Default white color
         }
-        trackedContexts.clear();
     }
 
     // Write updated config back to file
@@ -186,67 +335,169 @@ void Logger<Backends...>::updateConfigWithNewContexts() {
 //------------------------------------------------------------------------------
 template <typename... Backends>
 void Logger<Backends...>::updateSettings(const std::string& configFile) {
-    LoggerConfig::loadOrGenerateConfig(configFile, *settings);
+    // Parse into a private copy, then swap it in; readers never see a half-loaded config
+    auto next = std::make_shared<LoggerSettings>(*settings.latest());
+    LoggerConfig::loadOrGenerateConfig(configFile, *next);
+    settings.publish(std::move(next));
 }
 
 //------------------------------------------------------------------------------
-// Should Log?
+// Level / Context Ids
 //------------------------------------------------------------------------------
+inline std::string_view trimName(std::string_view s) {
+    size_t b = 0, e = s.size();
+    while (b < e && static_cast<unsigned char>(s[b]) <= ' ') ++b;
+    while (e > b && static_cast<unsigned char>(s[e - 1]) <= ' ') --e;
+    return s.substr(b, e - b);
+}
+
 template <typename... Backends>
-bool Logger<Backends...>::shouldLog(std::string_view level, std::string_view context) const {
-    assert(settings && "Logger settings must not be null");
+LevelId Logger<Backends...>::level(std::string_view name) const {
+    return settings.current().findLevel(trimName(name));
+}
 
-    auto trim = [](std::string_view s) -> std::string {
-        size_t b = 0, e = s.size();
-        while (b < e && static_cast<unsigned char>(s[b]) <= ' ') ++b;
-        while (e > b && static_cast<unsigned char>(s[e - 1]) <= ' ') --e;
-        return std::string{s.substr(b, e - b)};
-    };
+template <typename... Backends>
+ContextId Logger<Backends...>::context(std::string_view name) {
+    return settings.current().addContext(trimName(name));
+}
 
-    const std::string lvlKey = trim(level);
-    const std::string ctxKey = trim(context);
+//------------------------------------------------------------------------------
+// Should Log?
+//------------------------------------------------------------------------------
+template <typename... Backends>
+bool Logger<Backends...>::shouldLog(LevelId level, ContextId context) const {
+    const LoggerSettings& current = settings.current();
+    const auto& levels = current.config.levels;
+    if (level >= MAX_LEVELS || !levels.enabledArray[level]) return false;
 
-    const auto lvlIt = settings->config.levels.levelIndexMap.find(lvlKey);
-    if (lvlIt == settings->config.levels.levelIndexMap.end()) return false;
+    if (levels.severitiesArray[level] < current.contextSeverity(context)) return false;
+    return !current.rateLimiter || current.rateLimiter->admit(level, context);
+}
 
-    const int levelIndex = lvlIt->second;
-    if (!settings->config.levels.enabledArray[levelIndex]) return false;
+//------------------------------------------------------------------------------
+// Log Message
+//------------------------------------------------------------------------------
+template <typename... Backends>
+void Logger<Backends...>::log(LevelId level, ContextId context, std::string_view message) {
+    if (!shouldLog(level, context)) {
+        return;
+    }
 
-    const int msgSeverity = settings->config.levels.severitiesArray[levelIndex];
+    LogMessage logMsg{level, context, message};
+    logCore.enqueueLog(std::move(logMsg));
+}
 
-    int minContextSeverity;
-    {
-        std::lock_guard<std::mutex> lock(contextMutex);
-        const auto ctxIt = settings->config.contexts.contextIndexMap.find(ctxKey);
-        if (ctxIt == settings->config.contexts.contextIndexMap.end()) {
-            trackedContexts.insert(ctxKey);
-            const auto defIt = settings->config.levels.levelIndexMap.find("INFO");
-            minContextSeverity = (defIt == settings->config.levels.levelIndexMap.end())
-                ? msgSeverity
-                : settings->config.levels.severitiesArray[defIt->second];
-        } else {
-            minContextSeverity = settings->config.contexts.contextSeverityArray[ctxIt->second];
-        }
+template <typename... Backends>
+void Logger<Backends...>::log(std::string_view level, std::string_view context, std::string_view message) {
+    log(this->level(level), this->context(context), message);
+}
+
+//------------------------------------------------------------------------------
+// Log Message (deferred formatting)
+//------------------------------------------------------------------------------
+template <typename... Backends>
+template <DeferredFormatArg... Args>
+    requires (sizeof...(Args) > 0)
+void Logger<Backends...>::log(LevelId level, ContextId context, DeferredFormatString format, const Args&... args) {
+    if (!shouldLog(level, context)) {
+        return;
     }
 
-    return msgSeverity >= minContextSeverity;
+    LogMessage logMsg{level, context, {}};
+    logMsg.captureFormat(format, args...);
+
+    logCore.enqueueLog(std::move(logMsg));
+}
+
+template <typename... Backends>
+template <DeferredFormatArg... Args>
+    requires (sizeof...(Args) > 0)
+void Logger<Backends...>::log(std::string_view level, std::string_view context, DeferredFormatString format,
+                              const Args&... args) {
+    log(this->level(level), this->context(context), format, args...);
 }
 
 //------------------------------------------------------------------------------
-// Log Message
+// Log Message (structured fields)
 //------------------------------------------------------------------------------
 template <typename... Backends>
-void Logger<Backends...>::log(std::string_view level, std::string_view context, std::string_view message) {
+void Logger<Backends...>::log(LevelId level, ContextId context, std::string_view message,
+                              std::initializer_list<LogField> fields) {
     if (!shouldLog(level, context)) {
         return;
     }
 
-    LogMessage logMsg{std::string(level), std::string(context), std::string(message)};
-    if (settings->config.format.enableTimestamps) {
-        logMsg.setTimestamp(getCurrentTimestamp(settings->config.format.timestampFormat));
+    LogMessage logMsg{level, context, message};
+    logMsg.fields.assign(fields);
+    logCore.enqueueLog(std::move(logMsg));
+}
+
+template <typename... Backends>
+void Logger<Backends...>::log(std::string_view level, std::string_view context, std::string_view message,
+                              std::initializer_list<LogField> fields) {
+    log(this->level(level), this->context(context), message, fields);
+}
+
+//------------------------------------------------------------------------------
+// Log Message (typed level)
+//------------------------------------------------------------------------------
+
+// Returns the level's runtime id when a message at `L` for `context` should
+// be logged, INVALID_LEVEL_ID otherwise.
+template <typename... Backends>
+template <Level L>
+LevelId Logger<Backends...>::typedLevelIfEnabled(ContextId context) const {
+    constexpr auto index = static_cast<std::size_t>(L);
+    const LoggerSettings& current = settings.current();
+
+    if (!((current.typedLevelMask(context) >> index) & 1u)) {
+        return INVALID_LEVEL_ID;
+    }
+    const LevelId id = current.config.levels.typedIds[index];
+    if (current.rateLimiter && !current.rateLimiter->admit(id, context)) {
+        return INVALID_LEVEL_ID;
+    }
+    return id;
+}
+
+template <typename... Backends>
+template <Level L>
+void Logger<Backends...>::log([[maybe_unused]] ContextId context, [[maybe_unused]] std::string_view message) {
+    if constexpr (levelCompiledIn<L>) {
+        const LevelId level = typedLevelIfEnabled<L>(context);
+        if (level == INVALID_LEVEL_ID) return;
+
+        logCore.enqueueLog(LogMessage{level, context, message});
     }
+}
 
-    logCore.enqueueLog(std::move(logMsg), *settings);
+template <typename... Backends>
+template <Level L, DeferredFormatArg... Args>
+    requires (sizeof...(Args) > 0)
+void Logger<Backends...>::log([[maybe_unused]] ContextId context, [[maybe_unused]] DeferredFormatString format,
+                              [[maybe_unused]] const Args&... args) {
+    if constexpr (levelCompiledIn<L>) {
+        const LevelId level = typedLevelIfEnabled<L>(context);
+        if (level == INVALID_LEVEL_ID) return;
+
+        LogMessage logMsg{level, context, {}};
+        logMsg.captureFormat(format, args...);
+        logCore.enqueueLog(std::move(logMsg));
+    }
+}
+
+template <typename... Backends>
+template <Level L>
+void Logger<Backends...>::log([[maybe_unused]] ContextId context, [[maybe_unused]] std::string_view message,
+                              [[maybe_unused]] std::initializer_list<LogField> fields) {
+    if constexpr (levelCompiledIn<L>) {
+        const LevelId level = typedLevelIfEnabled<L>(context);
+        if (level == INVALID_LEVEL_ID) return;
+
+        LogMessage logMsg{level, context, message};
+        logMsg.fields.assign(fields);
+        logCore.enqueueLog(std::move(logMsg));
+    }
 }
 
 #endif // LOGGER_HPP
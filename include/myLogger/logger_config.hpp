@@ -5,10 +5,45 @@
 #include <array>
 #include <unordered_map>
 #include <vector>
+#include <cstdint>
+#include <string_view>
+#include <functional>
+#include <memory>
 #include <toml++/toml.hpp>
+#include "myLogger/context_registry.hpp"
+#include "myLogger/log_level.hpp"
 
 #define MAX_LEVELS 16
-#define MAX_CONTEXTS 256
+#define DEFAULT_QUEUE_CAPACITY 8192
+#define DEFAULT_THREAD_QUEUE_CAPACITY 1024
+#define DEFAULT_FILE_BUFFER_SIZE (256 * 1024)
+#define DEFAULT_BATCH_SIZE 256
+#define DEFAULT_MMAP_SEGMENT_SIZE (64 * 1024 * 1024)
+#define DEFAULT_QUEUE_MAX_MESSAGES 65536
+#define DEFAULT_QUEUE_MAX_BYTES (64 * 1024 * 1024)
+#define DEFAULT_BLOCK_TIMEOUT_MS 100
+#define DEFAULT_WAIT_SPIN_US 50
+#define DEFAULT_WAIT_INTERVAL_US 1000
+#define DEFAULT_SHM_RING_SIZE (4 * 1024 * 1024)
+#define DEFAULT_SHM_POLL_MS 10
+#define DEFAULT_SUPPRESSION_REPORT_INTERVAL 10
+
+// Compact handles for levels and contexts; index into the settings tables below.
+// An id keeps its meaning across config reloads.
+// (ContextId lives in context_registry.hpp)
+using LevelId = std::uint16_t;
+
+inline constexpr LevelId INVALID_LEVEL_ID = UINT16_MAX;
+
+// Lets the name maps be searched with a std::string_view without allocating
+struct StringViewHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+};
+
+using NameIndexMap = std::unordered_map<std::string, int, StringViewHash, std::equal_to<>>;
+
+class RateLimiter;
 
 struct LoggerSettings
 {
@@ -17,6 +52,31 @@ struct LoggerSettings
         std::string logFilenameFormat = "log_%Y-%m-%d_%H-%M-%S.txt";
         int logRotationDays = 7;
         std::string flushMode = "instant";
+        std::string queueMode = "deque";         // "deque" (mutex), "ring" (lock-free) or "per_thread"
+        int queueCapacity = DEFAULT_QUEUE_CAPACITY;
+        int threadQueueCapacity = DEFAULT_THREAD_QUEUE_CAPACITY;   // per producer, "per_thread" mode
+        int fileBufferSize = DEFAULT_FILE_BUFFER_SIZE;             // bytes FileBackend gathers per write()
+        int batchSize = DEFAULT_BATCH_SIZE;                        // max messages per backend dispatch
+        std::int64_t mmapSegmentSize = DEFAULT_MMAP_SEGMENT_SIZE;  // MmapFileBackend preallocation
+        std::string mmapMsync = "none";                            // "none", "async" or "sync" per batch
+        std::int64_t rotationSize = 100 * 1024 * 1024;             // bytes per log file, 0 = no size limit
+        std::int64_t rotationInterval = 86400;                     // seconds per log file, 0 = no time limit
+        bool compressRotated = true;                               // gzip rotated files (needs zlib)
+        std::string backpressurePolicy = "block";                  // "block", "drop_newest", "drop_oldest" or "block_timeout"
+        std::int64_t queueMaxMessages = DEFAULT_QUEUE_MAX_MESSAGES; // queued messages before backpressure, 0 = no limit
+        std::int64_t queueMaxBytes = DEFAULT_QUEUE_MAX_BYTES;       // queued bytes before backpressure, 0 = no limit
+        int blockTimeoutMs = DEFAULT_BLOCK_TIMEOUT_MS;              // "block_timeout": wait before dropping
+        std::string dispatchMode = "serial";                       // "serial" or "fan_out" (one worker per backend)
+        std::string backendOverflowPolicy = "drop_oldest";         // "fan_out" queue full: "drop_oldest" or "drop_newest"
+        std::string waitStrategy = "adaptive";                     // idle consumer: "spin", "adaptive" or "interval"
+        int waitSpinUs = DEFAULT_WAIT_SPIN_US;                      // "adaptive": spin this long, then yield as long, then park
+        int waitIntervalUs = DEFAULT_WAIT_INTERVAL_US;              // "interval": poll period
+        bool crashHandler = false;                                 // write queued messages on fatal signals
+        std::string shmRingName = "mylogger";                      // ShmRingBackend segments are "/<name>.<pid>.<n>"
+        std::int64_t shmRingSize = DEFAULT_SHM_RING_SIZE;           // ring bytes per writer process
+        int shmPollMs = DEFAULT_SHM_POLL_MS;                        // mylogger-collector: pause between sweeps
+        int suppressionReportInterval = DEFAULT_SUPPRESSION_REPORT_INTERVAL; // seconds between "N messages suppressed" records
+        std::int64_t coalesceWindowMs = 0;                         // fold repeats of one message within this window, 0 = off
     };
 
     struct Format {
@@ -40,21 +100,24 @@ struct LoggerSettings
     struct Levels {
         std::array<bool, MAX_LEVELS> enabledArray = {};
         std::array<int, MAX_LEVELS> severitiesArray = {};
-        std::unordered_map<std::string, int> levelIndexMap;
-        std::vector<std::string> levelNames;
+        NameIndexMap levelIndexMap;
+        std::vector<std::string> levelNames;      // indexed by LevelId
+
+        // Indexed by Level: its LevelId, and its severity or LEVEL_DISABLED
+        std::array<LevelId, TYPED_LEVEL_COUNT> typedIds = {};
+        std::array<int, TYPED_LEVEL_COUNT> typedSeverities = {};
     };
 
     struct Colors {
         std::string colorMode = "level";
         std::array<std::string, MAX_LEVELS> logColorArray = {};
-        std::array<std::string, MAX_CONTEXTS> contextColorArray = {};
         std::unordered_map<std::string, std::string> parsedLogColors;
     };
 
+    // Contexts listed in [contexts]; runtime ids live in contextRegistry
     struct Contexts {
-        std::unordered_map<std::string, int> contextIndexMap;
-        std::array<int, MAX_CONTEXTS> contextSeverityArray = {};
         std::vector<std::string> contextNames;
+        int defaultSeverity = 0;                  // for contexts not listed in [contexts]
     };
 
     // All settings grouped into one config
@@ -68,8 +131,56 @@ struct LoggerSettings
         Contexts  contexts;
     } config;
 
+    // Path the Logger loads and writes back its configuration from
+    std::string configPath = "config/logger.conf";
+
+    // Bumped by every (re)load; backends compare it to refresh derived state
+    std::uint64_t generation = 0;
+
+    // Every context seen so far (configured or discovered while logging);
+    // shared by all copies, so ids survive reloads (see SettingsSnapshots)
+    std::shared_ptr<ContextRegistry> contextRegistry = std::make_shared<ContextRegistry>();
+
+    // Minimum severity per ContextId, rebuilt by every load and published with
+    // the rest of the snapshot. Ids registered after the load use the default.
+    std::vector<int> contextSeverities;
+
+    // contextSeverities folded into Levels::typedSeverities, per ContextId
+    std::vector<std::uint8_t> typedLevelMasks;
+    std::uint8_t defaultTypedLevelMask = 0;
+
+    // Sampling and rate limits from [contexts]; null when no context has any.
+    // Rebuilt by every load, so a reload starts with full buckets.
+    std::shared_ptr<RateLimiter> rateLimiter;
+
     // Constructor
     LoggerSettings();
+
+    // Id -> name lookups used by the backends
+    std::string_view levelName(LevelId id) const;
+    std::string_view contextName(ContextId id) const;
+
+    // Minimum severity a message needs to pass for `id`
+    int contextSeverity(ContextId id) const {
+        return id < contextSeverities.size() ? contextSeverities[id] : config.contexts.defaultSeverity;
+    }
+
+    // Bit L set when a typed Level L message passes for `id`: switched on and
+    // at or above the context's minimum. One load decides log<Level::X>().
+    std::uint8_t typedLevelMask(ContextId id) const {
+        return id < typedLevelMasks.size() ? typedLevelMasks[id] : defaultTypedLevelMask;
+    }
+
+    // Level with the highest severity; used for the logger's own notices
+    LevelId mostSevereLevel() const;
+
+    // Resolve a name to its id; INVALID_* when unknown
+    LevelId findLevel(std::string_view name) const;
+    ContextId findContext(std::string_view name) const;
+
+    // Returns the id of `name`, registering it first if needed (lock-free).
+    // Only touches the shared registry, so it is allowed on a snapshot.
+    ContextId addContext(std::string_view name) const;
 };
 
 class LoggerConfig {
@@ -93,6 +204,7 @@ private:
     static void loadDisplay(const toml::table& config, LoggerSettings& settings);
     static void loadLevels(const toml::table& config, LoggerSettings& settings);
     static void loadSeverities(const toml::table& config, LoggerSettings& settings);
+    static void resolveTypedLevels(LoggerSettings& settings);
     static void loadColors(const toml::table& config, LoggerSettings& settings);
     static void loadContexts(const toml::table& config, LoggerSettings& settings);
 };
@@ -2,6 +2,17 @@
 #define LOGGER_CORE_HPP
 
 #include "myLogger/logger_config.hpp"
+#include "myLogger/settings_snapshots.hpp"
+#include "myLogger/deferred_format.hpp"
+#include "myLogger/message_payload.hpp"
+#include "myLogger/log_fields.hpp"
+#include "myLogger/rate_limiter.hpp"
+#include "myLogger/crash_handler.hpp"
+#include "myLogger/timestamp_formatter.hpp"
+#include "myLogger/mpmc_ring_buffer.hpp"
+#include "myLogger/spsc_ring_buffer.hpp"
+#include <algorithm>
+#include <iterator>
 #include <atomic>
 #include <mutex>
 #include <thread>
@@ -13,32 +24,174 @@
 #include <sstream>
 #include <iomanip>
 #include <ctime>
+#include <memory>
+#include <cstdint>
+#include <span>
+#include <charconv>
+#include <cstring>
 
-#define MAX_BATCH_SIZE 256  // Batching limit for efficiency
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
 
+// Holds no heap memory of its own: the text is inline (or in a recycled
+// slab) and the timestamp is rendered into a fixed buffer.
 struct LogMessage {
-    std::string level;
-    std::string context;
-    std::string message;
-    std::string timestamp;
+    LevelId level = INVALID_LEVEL_ID;
+    ContextId context = INVALID_CONTEXT_ID;
+    MessagePayload message;
+    LogFields fields;          // structured key/value pairs, packed
+    std::int64_t timeNs = 0;   // capture time, nanoseconds since epoch
+    DeferredArgs deferred;     // format + raw args, rendered on the consumer
+
+    // Rendered from timeNs on the consumer thread (see stampTime)
+    std::array<char, MAX_TIMESTAMP_LENGTH> timestampBuffer{};
+    std::uint8_t timestampLength = 0;
 
-    LogMessage(std::string_view lvl, std::string_view ctx, std::string_view msg)
+    LogMessage() = default;
+    LogMessage(LevelId lvl, ContextId ctx, std::string_view msg)
         : level(lvl), context(ctx), message(msg) {}
 
-    void setTimestamp(std::string_view ts) {
-        timestamp = ts;
+    std::string_view timestamp() const {
+        return {timestampBuffer.data(), timestampLength};
+    }
+
+    void stampTime(std::string_view format) {
+        timestampLength = static_cast<std::uint8_t>(
+            formatTimestamp(timeNs, format, timestampBuffer.data(), timestampBuffer.size()));
+    }
+
+    // Queues `format` and `args` for the consumer to render. String arguments
+    // too long for the argument buffer are rendered here instead.
+    template <DeferredFormatArg... Args>
+    void captureFormat(DeferredFormatString format, const Args&... args) {
+        if (deferred.capture(format, args...)) return;
+
+        thread_local std::string text;
+        text.clear();
+        deferred_detail::formatValues(text, format.c_str(), deferred_detail::toStored(args)...);
+        message.assign(text);
+    }
+
+    // Renders a deferred format string into `message` (consumer thread only).
+    // `scratch` is the consumer's reusable formatting buffer.
+    void materialize(std::string& scratch) {
+        if (!deferred.pending()) return;
+        scratch.clear();
+        deferred.formatInto(scratch);
+        message.assign(scratch);
+        deferred.formatFn = nullptr;
     }
 };
 
+//------------------------------------------------------------------------------
+// DuplicateCoalescer: "last message repeated N times" (coalesce_window_ms)
+//
+// Consecutive records with the same level, context, text and fields are
+// folded into the first one plus a repeat count, as long as they arrive
+// within the window that starts at the first one. The count is written as
+// its own record when the run ends: on a different message, when the window
+// closes, or at shutdown. Consumer thread only.
+//
+// A record is compared with the run's first record directly while both are
+// in the same batch; only a run that spans batches is matched by hash. With
+// no duplicates, the cost per record is comparing level, context and two
+// lengths with the previous record.
+//------------------------------------------------------------------------------
+class DuplicateCoalescer {
+public:
+    // Folds repeats in `batch` in place. If the run still open from the
+    // previous batch ends at the first record, its summary goes to
+    // `leading`, which must be dispatched before `batch`.
+    void apply(std::vector<LogMessage>& batch, std::int64_t windowNs,
+               const LoggerSettings::Format& format, std::vector<LogMessage>& leading);
+
+    // Writes the pending summary to `summary` if its window has closed by
+    // `nowNs` (or at all, with `force`). Returns false when there is nothing to write.
+    bool flushExpired(std::int64_t nowNs, std::int64_t windowNs, bool force,
+                      const LoggerSettings::Format& format, LogMessage& summary);
+
+private:
+    bool active = false;
+    LevelId level = INVALID_LEVEL_ID;
+    ContextId context = INVALID_CONTEXT_ID;
+    const LogMessage* anchor = nullptr;     // the run's first record while it is in the current batch
+    std::string runMessage;                 // its message and field bytes once it has left
+    std::string runFields;                  // (reused across runs)
+    std::int64_t startNs = 0;
+    std::int64_t lastNs = 0;
+    std::uint64_t repeats = 0;
+
+    bool continuesRun(const LogMessage& log) const;
+    void startRun(const LogMessage& log);
+    void writeSummary(LogMessage& into, const LoggerSettings::Format& format);
+};
+
+enum class QueueMode {
+    Deque,      // mutex + std::deque
+    Ring,       // shared lock-free MPMC ring
+    PerThread   // one SPSC ring per producer thread
+};
+
+// What enqueueLog() does once queue_max_messages / queue_max_bytes is reached
+enum class BackpressurePolicy {
+    Block,          // wait for the consumer to make room
+    DropNewest,     // discard the incoming message
+    DropOldest,     // discard the oldest queued message (newest in "per_thread" mode)
+    BlockTimeout    // wait up to block_timeout_ms, then discard the incoming message
+};
+
+inline BackpressurePolicy parseBackpressurePolicy(std::string_view name) {
+    if (name == "drop_newest")   return BackpressurePolicy::DropNewest;
+    if (name == "drop_oldest")   return BackpressurePolicy::DropOldest;
+    if (name == "block_timeout") return BackpressurePolicy::BlockTimeout;
+    return BackpressurePolicy::Block;
+}
+
+// How the consumer waits while the queue is empty
+enum class WaitStrategy {
+    Spin,       // busy-polls; lowest latency, keeps one core busy
+    Adaptive,   // spins, then yields, then parks until a producer signals
+    Interval    // sleeps wait_interval_us between polls; producers never signal
+};
+
+inline WaitStrategy parseWaitStrategy(std::string_view name) {
+    if (name == "spin")     return WaitStrategy::Spin;
+    if (name == "interval") return WaitStrategy::Interval;
+    return WaitStrategy::Adaptive;
+}
+
+// Spin-loop hint for the CPU
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Ring owned jointly by a producer thread and the consumer; whichever side
+// lets go last frees it.
+struct ProducerRing {
+    explicit ProducerRing(std::size_t capacity) : ring(capacity) {}
+
+    SpscRingBuffer<LogMessage> ring;
+    std::atomic<bool> retired{false};   // producer thread has exited
+};
+
 template <typename Backends>
 class LoggerCore {
 public:
     LoggerCore();
     ~LoggerCore();
 
-    void enqueueLog(LogMessage&& logMsg, const LoggerSettings& settings);
+    void enqueueLog(LogMessage&& logMsg);
     void shutdown();
-    void setBackends(Backends& backends, LoggerSettings& settings);
+    void setBackends(Backends& backends, const SettingsSnapshots& settings);
+
+    // Messages discarded by the backpressure policy since startup
+    std::uint64_t droppedMessages(LevelId level) const;
+    std::uint64_t droppedMessages() const;
 
 private:
     std::thread logThread;
@@ -47,126 +200,844 @@ private:
     std::mutex mutex;
     std::atomic<int> queueSize{0};
 
+    QueueMode queueMode{QueueMode::Deque};
     std::deque<LogMessage> logQueue;
+    std::unique_ptr<MpmcRingBuffer<LogMessage>> logRing;
     Backends* m_backends{nullptr};
-    LoggerSettings* m_settings{nullptr};
+    const SettingsSnapshots* m_settings{nullptr};   // read once per batch
+    std::size_t batchSize{DEFAULT_BATCH_SIZE};   // messages handed to the backends at once
+
+    // PerThread mode: rings registered by producers, swept by the consumer
+    const std::uint64_t coreId{nextCoreId()};
+    std::size_t threadRingCapacity{DEFAULT_THREAD_QUEUE_CAPACITY};
+    std::mutex ringsMutex;
+    std::vector<std::shared_ptr<ProducerRing>> producerRings;
+    std::atomic<std::uint64_t> ringsVersion{0};
+    std::vector<std::size_t> runEnds;        // consumer only: end of each ring's run in the batch
+    std::vector<LogMessage> mergeBuffer;     // consumer only: other half of the run merge
+
+    // Backpressure: producers reserve room in queueSize/queuedBytes before pushing
+    BackpressurePolicy backpressure{BackpressurePolicy::Block};
+    std::size_t maxQueuedMessages{DEFAULT_QUEUE_MAX_MESSAGES};   // 0 = no limit
+    std::size_t maxQueuedBytes{DEFAULT_QUEUE_MAX_BYTES};         // 0 = no limit
+    std::chrono::milliseconds blockTimeout{DEFAULT_BLOCK_TIMEOUT_MS};
+    std::atomic<std::int64_t> queuedBytes{0};
+    std::mutex spaceMutex;
+    std::condition_variable spaceCondition;
+    std::atomic<int> spaceWaiters{0};   // producers blocked in admit()
+    std::array<std::atomic<std::uint64_t>, MAX_LEVELS> droppedPerLevel{};
+    std::array<std::uint64_t, MAX_LEVELS> droppedReported{};   // consumer thread only
+
+    // Per-context sampling/rate limits: the limiter the last summary came
+    // from (a reload replaces it) and when the next summary is due
+    std::shared_ptr<RateLimiter> summarizedLimiter;              // consumer thread only
+    std::chrono::steady_clock::time_point nextSuppressionSummary{};
+
+    DuplicateCoalescer coalescer;   // consumer thread only
+
+    // Idle consumer. Producers only notify logCondition while it is parked.
+    WaitStrategy waitStrategy{WaitStrategy::Adaptive};
+    std::chrono::microseconds waitSpin{DEFAULT_WAIT_SPIN_US};
+    std::chrono::microseconds waitInterval{DEFAULT_WAIT_INTERVAL_US};
+    std::atomic<bool> consumerParked{false};
+
+    // crash_handler: settings of the latest batch (held by the consumer
+    // thread) and a render buffer reserved up front
+    std::atomic<const LoggerSettings*> crashSettings{nullptr};
+    std::atomic<const std::vector<LogMessage>*> crashBatch{nullptr};   // batch being dispatched
+    std::string crashScratch;
+    bool crashHandlerRegistered{false};
+
+    // "fan_out": batch vectors come back here once every worker has written
+    // them, so the consumer keeps refilling the same few allocations
+    struct SpareBatches {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<std::vector<LogMessage>>> vectors;
+    };
+    const std::shared_ptr<SpareBatches> spareBatches{std::make_shared<SpareBatches>()};
 
     void processQueue();
-};
+    bool workPending() const;
+    void waitForWork();
+    void wakeConsumer();
+    void wakeProducers();
+    void drainDeque(std::vector<LogMessage>& batch);
+    void drainRing(std::vector<LogMessage>& batch);
+    void drainThreadRings(std::vector<LogMessage>& batch,
+                          std::vector<std::shared_ptr<ProducerRing>>& rings,
+                          std::uint64_t& seenVersion);
+    void mergeRuns(std::vector<LogMessage>& batch);
+    bool threadRingsEmpty(const std::vector<std::shared_ptr<ProducerRing>>& rings) const;
+    ProducerRing& threadRing();
+
+    bool reserve(std::size_t bytes);
+    void release(std::size_t count, std::size_t bytes);
+    bool admit(std::size_t bytes);
+    bool evictOldest();
+    template <typename Ring>
+    bool pushToRing(Ring& ring, LogMessage& logMsg, std::size_t bytes, bool canEvict);
+    void recordDrop(LevelId level);
+    void emergencyDrain(int signal);
+    void reportDrops(const LoggerSettings& settings);
+    void reportSuppressed(const LoggerSettings& settings, bool force);
+    void writeSuppressed(RateLimiter& limiter, const LoggerSettings& settings);
+    void flushRepeats(const LoggerSettings& settings, bool force);
+    void dispatch(std::vector<LogMessage>& batch, const LoggerSettings& settings);
+
+    // Queued footprint counted against queue_max_bytes
+    static std::size_t footprint(const LogMessage& logMsg) {
+        return sizeof(LogMessage) + logMsg.message.size() + logMsg.fields.size();
+    }
 
-std::string getCurrentTimestamp(const std::string& format);
+    static std::uint64_t nextCoreId() {
+        static std::atomic<std::uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+};
 
 template <typename Backends>
-LoggerCore<Backends>::LoggerCore() {
-    logThread = std::thread(&LoggerCore::processQueue, this);
-}
+LoggerCore<Backends>::LoggerCore() = default;
 
 template <typename Backends>
 LoggerCore<Backends>::~LoggerCore() {
-    m_backends->flush();
     shutdown();
 }
 
+// The consumer thread is started here rather than in the constructor so the
+// queue can be sized from the loaded settings before anything reads it.
 template <typename Backends>
-void LoggerCore<Backends>::setBackends(Backends& backends, LoggerSettings& settings) {
+void LoggerCore<Backends>::setBackends(Backends& backends, const SettingsSnapshots& settings) {
     m_backends = &backends;
     m_settings = &settings;
+
+    // Queue shape is fixed at startup; later reloads do not resize it
+    const auto& general = settings.current().config.general;
+    batchSize = static_cast<std::size_t>(general.batchSize > 0 ? general.batchSize : DEFAULT_BATCH_SIZE);
+
+    if (general.queueMode == "ring") {
+        queueMode = QueueMode::Ring;
+        logRing = std::make_unique<MpmcRingBuffer<LogMessage>>(
+            static_cast<std::size_t>(general.queueCapacity > 0 ? general.queueCapacity : DEFAULT_QUEUE_CAPACITY));
+    } else if (general.queueMode == "per_thread") {
+        queueMode = QueueMode::PerThread;
+        threadRingCapacity = static_cast<std::size_t>(
+            general.threadQueueCapacity > 0 ? general.threadQueueCapacity : DEFAULT_THREAD_QUEUE_CAPACITY);
+    } else {
+        queueMode = QueueMode::Deque;
+    }
+
+    backpressure = parseBackpressurePolicy(general.backpressurePolicy);
+    maxQueuedMessages = static_cast<std::size_t>(std::max<std::int64_t>(general.queueMaxMessages, 0));
+    maxQueuedBytes = static_cast<std::size_t>(std::max<std::int64_t>(general.queueMaxBytes, 0));
+    blockTimeout = std::chrono::milliseconds(std::max(general.blockTimeoutMs, 0));
+
+    waitStrategy = parseWaitStrategy(general.waitStrategy);
+    waitSpin = std::chrono::microseconds(std::max(general.waitSpinUs, 0));
+    waitInterval = std::chrono::microseconds(std::max(general.waitIntervalUs, 1));
+
+    crashSettings.store(&settings.current(), std::memory_order_release);
+    if (general.crashHandler && !crashHandlerRegistered) {
+        crashScratch.reserve(64 * 1024);
+        CrashHandler::install();
+        crashHandlerRegistered = CrashHandler::add(this, [](void* owner, int signal) {
+            static_cast<LoggerCore*>(owner)->emergencyDrain(signal);
+        });
+    }
+
+    if (!logThread.joinable()) {
+        logThread = std::thread(&LoggerCore::processQueue, this);
+    }
 }
 
 template <typename Backends>
-void LoggerCore<Backends>::enqueueLog(LogMessage&& logMsg, const LoggerSettings& settings) {
-    if (settings.config.format.enableTimestamps) {
-        logMsg.setTimestamp(getCurrentTimestamp(settings.config.format.timestampFormat));
+void LoggerCore<Backends>::enqueueLog(LogMessage&& logMsg) {
+    if (exitFlag.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    logMsg.timeNs = currentTimeNs();
+
+    const std::size_t bytes = footprint(logMsg);
+    if (!admit(bytes)) {
+        recordDrop(logMsg.level);
+        return;
+    }
+
+    if (queueMode == QueueMode::PerThread) {
+        // Only the consumer may pop an SPSC ring, so drop_oldest cannot evict here
+        if (pushToRing(threadRing().ring, logMsg, bytes, false)) {
+            wakeConsumer();
+        }
+        return;
+    }
+
+    if (queueMode == QueueMode::Ring) {
+        // Lock-free path; a full ring is handled like a full queue
+        if (pushToRing(*logRing, logMsg, bytes, true)) {
+            wakeConsumer();
+        }
+        return;
     }
 
     {
         std::unique_lock<std::mutex> lock(mutex);
         logQueue.emplace_back(std::move(logMsg));
-        queueSize.fetch_add(1, std::memory_order_release);
     }
 
-    logCondition.notify_one();
+    wakeConsumer();
 }
 
+//------------------------------------------------------------------------------
+// Backpressure
+//------------------------------------------------------------------------------
+
+// Claims room for one message of `bytes`. A message always fits into an
+// empty queue, however large it is.
 template <typename Backends>
-void LoggerCore<Backends>::processQueue() {
+bool LoggerCore<Backends>::reserve(std::size_t bytes) {
+    // seq_cst: ordered against the consumer raising consumerParked (see wakeConsumer)
+    const auto count = static_cast<std::size_t>(queueSize.fetch_add(1, std::memory_order_seq_cst));
+    const auto total = static_cast<std::size_t>(
+        queuedBytes.fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_acq_rel));
 
-    while (!exitFlag.load(std::memory_order_acquire)) {
-        std::vector<LogMessage> batch;
-        batch.reserve(MAX_BATCH_SIZE);
+    const bool fits = (maxQueuedMessages == 0 || count < maxQueuedMessages)
+                   && (maxQueuedBytes == 0 || total + bytes <= maxQueuedBytes);
+    if (fits || count == 0) return true;
 
-        {
-            std::unique_lock<std::mutex> lock(mutex);
-            logCondition.wait_for(lock, std::chrono::milliseconds(10), [this] {
-                return !logQueue.empty() || exitFlag.load();
-            });
+    release(1, bytes);
+    return false;
+}
+
+template <typename Backends>
+void LoggerCore<Backends>::release(std::size_t count, std::size_t bytes) {
+    queueSize.fetch_sub(static_cast<int>(count), std::memory_order_acq_rel);
+    queuedBytes.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_acq_rel);
+}
+
+// Applies the backpressure policy until the message has reserved room;
+// false means it has to be dropped.
+template <typename Backends>
+bool LoggerCore<Backends>::admit(std::size_t bytes) {
+    if (reserve(bytes)) return true;
 
-            while (!logQueue.empty() && batch.size() < MAX_BATCH_SIZE) {
-                batch.emplace_back(std::move(logQueue.front()));
-                logQueue.pop_front();
+    switch (backpressure) {
+        case BackpressurePolicy::DropNewest:
+            return false;
+
+        case BackpressurePolicy::DropOldest:
+            while (evictOldest()) {
+                if (reserve(bytes)) return true;
+            }
+            return reserve(bytes);
+
+        case BackpressurePolicy::Block:
+        case BackpressurePolicy::BlockTimeout: {
+            const auto deadline = std::chrono::steady_clock::now() + blockTimeout;
+            bool reserved = false;
+            // Nobody drains the queue once shutdown() has begun
+            const auto roomOrExit = [&] {
+                reserved = reserve(bytes);
+                return reserved || exitFlag.load(std::memory_order_acquire);
+            };
+
+            // Raised before the first retry. A consumer whose release() comes
+            // after a failed retry sees it (see wakeProducers) and takes
+            // spaceMutex before notifying, so no wakeup falls in between.
+            spaceWaiters.fetch_add(1, std::memory_order_seq_cst);
+            {
+                std::unique_lock<std::mutex> lock(spaceMutex);
+                wakeConsumer();
+                if (backpressure == BackpressurePolicy::BlockTimeout) {
+                    spaceCondition.wait_until(lock, deadline, roomOrExit);
+                } else {
+                    spaceCondition.wait(lock, roomOrExit);
+                }
             }
+            spaceWaiters.fetch_sub(1, std::memory_order_relaxed);
+            return reserved;
         }
+    }
+    return false;
+}
 
-        for (auto& logMsg : batch) {
-            if (m_backends && m_settings) {
-                m_backends->dispatchLog(logMsg, *m_settings);
+// Consumer side of admit(): a futex call only when a producer is blocked
+template <typename Backends>
+void LoggerCore<Backends>::wakeProducers() {
+    // Our release() read-modify-writes the counters a failed reserve() did,
+    // so it synchronizes with that producer's earlier spaceWaiters increment
+    if (spaceWaiters.load(std::memory_order_acquire) == 0) return;
+
+    { std::lock_guard<std::mutex> lock(spaceMutex); }
+    spaceCondition.notify_all();
+}
+
+// Discards the message at the head of the queue; false when there is none
+// (or, in "per_thread" mode, none this thread may take).
+template <typename Backends>
+bool LoggerCore<Backends>::evictOldest() {
+    LogMessage victim;
+    if (queueMode == QueueMode::Deque) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (logQueue.empty()) return false;
+        victim = std::move(logQueue.front());
+        logQueue.pop_front();
+    } else if (queueMode == QueueMode::Ring) {
+        if (!logRing->tryPop(victim)) return false;
+    } else {
+        return false;
+    }
+
+    release(1, footprint(victim));
+    recordDrop(victim.level);
+    return true;
+}
+
+// Pushes a message that already holds its reservation. A ring can fill up
+// before the configured limits do; that is treated the same way.
+template <typename Backends>
+template <typename Ring>
+bool LoggerCore<Backends>::pushToRing(Ring& ring, LogMessage& logMsg, std::size_t bytes, bool canEvict) {
+    const auto deadline = std::chrono::steady_clock::now() + blockTimeout;
+    while (!ring.tryPush(std::move(logMsg))) {
+        const bool giveUp =
+            backpressure == BackpressurePolicy::DropNewest
+            || (backpressure == BackpressurePolicy::DropOldest && !(canEvict && evictOldest()))
+            || (backpressure == BackpressurePolicy::BlockTimeout && std::chrono::steady_clock::now() >= deadline)
+            || exitFlag.load(std::memory_order_acquire);
+        if (giveUp) {
+            release(1, bytes);
+            recordDrop(logMsg.level);
+            return false;
+        }
+        wakeConsumer();
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+template <typename Backends>
+void LoggerCore<Backends>::recordDrop(LevelId level) {
+    if (level < MAX_LEVELS) {
+        droppedPerLevel[level].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename Backends>
+std::uint64_t LoggerCore<Backends>::droppedMessages(LevelId level) const {
+    return level < MAX_LEVELS ? droppedPerLevel[level].load(std::memory_order_relaxed) : 0;
+}
+
+template <typename Backends>
+std::uint64_t LoggerCore<Backends>::droppedMessages() const {
+    std::uint64_t total = 0;
+    for (const auto& count : droppedPerLevel) {
+        total += count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// Called by the consumer once the queue has drained: writes one
+// "N messages dropped" record covering the drops since the last report.
+template <typename Backends>
+void LoggerCore<Backends>::reportDrops(const LoggerSettings& settings) {
+    std::uint64_t total = 0;
+    std::string perLevel;
+    for (std::size_t level = 0; level < MAX_LEVELS; ++level) {
+        const std::uint64_t dropped = droppedPerLevel[level].load(std::memory_order_relaxed);
+        const std::uint64_t fresh = dropped - droppedReported[level];
+        if (fresh == 0) continue;
+        droppedReported[level] = dropped;
+        total += fresh;
+        perLevel += perLevel.empty() ? " (" : ", ";
+        perLevel += settings.levelName(static_cast<LevelId>(level));
+        perLevel += ": ";
+        perLevel += std::to_string(fresh);
+    }
+    if (total == 0) return;
+
+    // Reported at the most severe configured level so it survives filtering
+    LogMessage report{settings.mostSevereLevel(), settings.addContext("LOGGER"),
+                      std::to_string(total) + " messages dropped" + perLevel + ")"};
+    report.timeNs = currentTimeNs();
+    if (settings.config.format.enableTimestamps) {
+        report.stampTime(settings.config.format.timestampFormat);
+    }
+
+    std::vector<LogMessage> batch;
+    batch.push_back(std::move(report));
+    dispatch(batch, settings);
+}
+
+// Called by the consumer after every batch and while idle: every
+// suppression_report_interval seconds (and at shutdown) writes one
+// "N messages suppressed" record per context that sampling or its rate
+// limit held back.
+template <typename Backends>
+void LoggerCore<Backends>::reportSuppressed(const LoggerSettings& settings, bool force) {
+    // A reload built a new limiter; whatever the old one counted goes out first
+    if (summarizedLimiter != settings.rateLimiter) {
+        if (summarizedLimiter) writeSuppressed(*summarizedLimiter, settings);
+        summarizedLimiter = settings.rateLimiter;
+    }
+    if (!summarizedLimiter) return;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (!force && now < nextSuppressionSummary) return;
+    nextSuppressionSummary = now + std::chrono::seconds(std::max(settings.config.general.suppressionReportInterval, 1));
+    writeSuppressed(*summarizedLimiter, settings);
+}
+
+template <typename Backends>
+void LoggerCore<Backends>::writeSuppressed(RateLimiter& limiter, const LoggerSettings& settings) {
+    struct Summary {
+        ContextId context = INVALID_CONTEXT_ID;
+        LevelId level = INVALID_LEVEL_ID;   // most severe level suppressed; the record is written at it
+        std::uint64_t total = 0;
+        std::string perLevel{};
+    };
+    std::vector<Summary> summaries;
+    limiter.collectSuppressed([&](ContextId context, LevelId level, std::uint64_t count) {
+        if (summaries.empty() || summaries.back().context != context) {
+            summaries.push_back({context, level});
+        }
+        Summary& summary = summaries.back();
+        if (settings.config.levels.severitiesArray[level] >= settings.config.levels.severitiesArray[summary.level]) {
+            summary.level = level;
+        }
+        summary.total += count;
+        summary.perLevel += summary.perLevel.empty() ? " (" : ", ";
+        summary.perLevel += settings.levelName(level);
+        summary.perLevel += ": ";
+        summary.perLevel += std::to_string(count);
+    });
+    if (summaries.empty()) return;
+
+    std::vector<LogMessage> batch;
+    const std::int64_t timeNs = currentTimeNs();
+    for (const auto& summary : summaries) {
+        LogMessage report{summary.level, summary.context,
+                          std::to_string(summary.total) + " messages suppressed" + summary.perLevel + ")"};
+        report.timeNs = timeNs;
+        if (settings.config.format.enableTimestamps) {
+            report.stampTime(settings.config.format.timestampFormat);
+        }
+        batch.push_back(std::move(report));
+    }
+    dispatch(batch, settings);
+}
+
+// Called by the consumer while idle: writes the "repeated N times" record of
+// a run whose window has closed, or of any run at shutdown or once
+// coalescing has been switched off.
+template <typename Backends>
+void LoggerCore<Backends>::flushRepeats(const LoggerSettings& settings, bool force) {
+    const std::int64_t windowNs = settings.config.general.coalesceWindowMs * 1'000'000;
+    LogMessage summary;
+    if (!coalescer.flushExpired(currentTimeNs(), windowNs, force || windowNs <= 0, settings.config.format, summary)) {
+        return;
+    }
+
+    std::vector<LogMessage> batch;
+    batch.push_back(std::move(summary));
+    dispatch(batch, settings);
+}
+
+//------------------------------------------------------------------------------
+// Emergency Drain (inside the fatal-signal handler, see CrashHandler)
+//
+// Writes the batch the consumer is dispatching (or else the backends'
+// buffered bytes) and then every queued record, without allocating or
+// blocking: records are read in place (popping them without moving out runs
+// no destructors), and a mutex-guarded queue is skipped when its lock is
+// taken. Records of the in-flight batch may appear twice. Batches queued for
+// "fan_out" workers are not covered.
+//------------------------------------------------------------------------------
+template <typename Backends>
+void LoggerCore<Backends>::emergencyDrain(int signal) {
+    const LoggerSettings* settings = crashSettings.load(std::memory_order_acquire);
+    if (!settings || !m_backends) return;
+
+    std::size_t written = 0;
+    auto writeOne = [&](const LogMessage& logMsg) {
+        std::string_view text = logMsg.message;
+        if (logMsg.deferred.pending()) {
+            crashScratch.clear();
+            logMsg.deferred.formatInto(crashScratch);
+            text = crashScratch;
+        }
+        m_backends->emergencyWrite(logMsg.timeNs, settings->levelName(logMsg.level),
+                                   settings->contextName(logMsg.context), text, *settings);
+        ++written;
+    };
+
+    // The backend buffer can only hold part of the in-flight batch
+    if (const auto* inFlight = crashBatch.load(std::memory_order_acquire)) {
+        for (const auto& logMsg : *inFlight) writeOne(logMsg);
+    } else {
+        m_backends->emergencyFlush();
+    }
+
+    switch (queueMode) {
+        case QueueMode::Ring:
+            logRing->popBulk(logRing->getCapacity(), [&](LogMessage&& logMsg) { writeOne(logMsg); });
+            break;
+        case QueueMode::PerThread: {
+            std::unique_lock<std::mutex> lock(ringsMutex, std::try_to_lock);
+            if (!lock.owns_lock()) break;
+            for (const auto& producer : producerRings) {
+                producer->ring.popBulk(threadRingCapacity, [&](LogMessage&& logMsg) { writeOne(logMsg); });
             }
+            break;
+        }
+        case QueueMode::Deque: {
+            std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+            if (!lock.owns_lock()) break;
+            for (const auto& logMsg : logQueue) writeOne(logMsg);
+            lock.release();   // left locked: the consumer must not write these again before the process dies
+            break;
         }
+    }
 
-        if (m_settings && m_settings->config.general.flushMode == "batch") {
-            m_backends->flush();
+    char note[80] = "Fatal signal ";
+    char* p = note + std::strlen(note);
+    p = std::to_chars(p, note + sizeof(note), signal).ptr;
+    const char middle[] = ", queued messages written: ";
+    std::memcpy(p, middle, sizeof(middle) - 1);
+    p = std::to_chars(p + sizeof(middle) - 1, note + sizeof(note), written).ptr;
+    m_backends->emergencyWrite(currentTimeNs(), settings->levelName(settings->mostSevereLevel()), "LOGGER",
+                               std::string_view(note, static_cast<std::size_t>(p - note)), *settings);
+}
+
+// Hands a materialized batch to the backends: written right here in "serial"
+// dispatch mode, or shared with the per-backend workers in "fan_out" mode
+// (which swaps a recycled, empty vector into `batch`).
+template <typename Backends>
+void LoggerCore<Backends>::dispatch(std::vector<LogMessage>& batch, const LoggerSettings& settings) {
+    if (m_backends->fanOut()) {
+        std::unique_ptr<std::vector<LogMessage>> published;
+        {
+            std::lock_guard<std::mutex> lock(spareBatches->mutex);
+            if (!spareBatches->vectors.empty()) {
+                published = std::move(spareBatches->vectors.back());
+                spareBatches->vectors.pop_back();
+            }
         }
+        if (!published) {
+            published = std::make_unique<std::vector<LogMessage>>();
+            published->reserve(batchSize);
+        }
+        published->swap(batch);
+
+        // The last worker to finish clears the batch (returning its slabs) and recycles the vector
+        m_backends->publish(std::shared_ptr<const std::vector<LogMessage>>(published.release(),
+            [spare = spareBatches](const std::vector<LogMessage>* written) {
+                auto* vector = const_cast<std::vector<LogMessage>*>(written);
+                vector->clear();
+                std::lock_guard<std::mutex> lock(spare->mutex);
+                spare->vectors.emplace_back(vector);
+            }));
+        return;
+    }
+
+    m_backends->dispatchBatch(std::span<const LogMessage>(batch), settings);
+
+    // "instant" backends already flushed per message; otherwise one flush per batch
+    if (settings.config.general.flushMode != "instant") {
+        m_backends->flush();
     }
 }
 
 template <typename Backends>
-void LoggerCore<Backends>::shutdown() {
+void LoggerCore<Backends>::drainDeque(std::vector<LogMessage>& batch) {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (!logQueue.empty() && batch.size() < batchSize) {
+        batch.emplace_back(std::move(logQueue.front()));
+        logQueue.pop_front();
+    }
+}
+
+template <typename Backends>
+void LoggerCore<Backends>::drainRing(std::vector<LogMessage>& batch) {
+    logRing->popBulk(batchSize, [&batch](LogMessage&& logMsg) {
+        batch.emplace_back(std::move(logMsg));
+    });
+}
+
+// Returns the calling thread's ring for this core, registering one on first use.
+// The thread_local holder marks its rings retired when the thread exits; the
+// consumer frees a retired ring once it has been drained.
+template <typename Backends>
+ProducerRing& LoggerCore<Backends>::threadRing() {
+    struct ThreadRings {
+        struct Entry {
+            std::uint64_t coreId;
+            std::shared_ptr<ProducerRing> ring;
+        };
+        std::vector<Entry> entries;
+        std::uint64_t lastCoreId = 0;
+        ProducerRing* lastRing = nullptr;
+
+        ~ThreadRings() {
+            for (auto& entry : entries) {
+                entry.ring->retired.store(true, std::memory_order_release);
+            }
+        }
+    };
+    thread_local ThreadRings local;
+
+    if (local.lastCoreId == coreId) {
+        return *local.lastRing;
+    }
+
+    for (auto& entry : local.entries) {
+        if (entry.coreId == coreId) {
+            local.lastCoreId = coreId;
+            local.lastRing = entry.ring.get();
+            return *entry.ring;
+        }
+    }
+
+    // Forget rings of cores that have since shut down (we are the only owner left)
+    std::erase_if(local.entries, [](const auto& entry) { return entry.ring.use_count() == 1; });
+
+    auto ring = std::make_shared<ProducerRing>(threadRingCapacity);
     {
-        std::unique_lock<std::mutex> lock(mutex);
-        exitFlag.store(true, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        producerRings.push_back(ring);
+        ringsVersion.fetch_add(1, std::memory_order_release);
     }
+    local.entries.push_back({coreId, ring});
+    local.lastCoreId = coreId;
+    local.lastRing = ring.get();
+    return *ring;
+}
 
-    logCondition.notify_all();
+template <typename Backends>
+bool LoggerCore<Backends>::threadRingsEmpty(const std::vector<std::shared_ptr<ProducerRing>>& rings) const {
+    for (const auto& producer : rings) {
+        if (!producer->ring.empty()) return false;
+    }
+    return true;
+}
 
-    while (!logQueue.empty()) {
-        std::vector<LogMessage> batch;
-        batch.reserve(MAX_BATCH_SIZE);
+// Sweeps every registered ring round-robin, then orders the batch by capture
+// time so output from different threads interleaves chronologically. Each
+// ring's messages are already in order, so merging the runs is enough.
+template <typename Backends>
+void LoggerCore<Backends>::drainThreadRings(std::vector<LogMessage>& batch,
+                                            std::vector<std::shared_ptr<ProducerRing>>& rings,
+                                            std::uint64_t& seenVersion) {
+    if (seenVersion != ringsVersion.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        rings = producerRings;
+        seenVersion = ringsVersion.load(std::memory_order_relaxed);
+    }
 
-        {
+    const std::size_t share = rings.empty() ? batchSize
+                                            : std::max<std::size_t>(32, batchSize / rings.size());
+    bool anyRetired = false;
+    runEnds.clear();
+    for (const auto& producer : rings) {
+        if (producer->ring.popBulk(share, [&batch](LogMessage&& logMsg) {
+                batch.emplace_back(std::move(logMsg));
+            }) > 0) {
+            runEnds.push_back(batch.size());
+        }
+        anyRetired |= producer->retired.load(std::memory_order_acquire);
+    }
+    mergeRuns(batch);
+
+    if (anyRetired) {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        std::erase_if(producerRings, [](const auto& producer) {
+            return producer->retired.load(std::memory_order_acquire) && producer->ring.empty();
+        });
+        ringsVersion.fetch_add(1, std::memory_order_release);
+    }
+}
+
+// Stable bottom-up merge of the runs listed in runEnds, ping-ponging between
+// `batch` and mergeBuffer. Unlike std::stable_sort it allocates nothing once
+// both vectors have grown to the batch size.
+template <typename Backends>
+void LoggerCore<Backends>::mergeRuns(std::vector<LogMessage>& batch) {
+    const auto earlier = [](const LogMessage& a, const LogMessage& b) { return a.timeNs < b.timeNs; };
+    while (runEnds.size() > 1) {
+        mergeBuffer.clear();
+        std::size_t begin = 0;
+        std::size_t merged = 0;
+        for (std::size_t run = 0; run < runEnds.size(); run += 2) {
+            const std::size_t middle = runEnds[run];
+            const std::size_t end = run + 1 < runEnds.size() ? runEnds[run + 1] : middle;
+            std::merge(std::make_move_iterator(batch.begin() + begin), std::make_move_iterator(batch.begin() + middle),
+                       std::make_move_iterator(batch.begin() + middle), std::make_move_iterator(batch.begin() + end),
+                       std::back_inserter(mergeBuffer), earlier);
+            runEnds[merged++] = end;
+            begin = end;
+        }
+        runEnds.resize(merged);
+        batch.swap(mergeBuffer);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Consumer Wakeup
+//------------------------------------------------------------------------------
+
+// queueSize is claimed before a message is pushed, so it may briefly run
+// ahead of what can be drained; the consumer then just polls again.
+template <typename Backends>
+bool LoggerCore<Backends>::workPending() const {
+    return queueSize.load(std::memory_order_seq_cst) > 0 || exitFlag.load(std::memory_order_seq_cst);
+}
+
+// Returns once there may be something to drain, waiting per wait_strategy
+template <typename Backends>
+void LoggerCore<Backends>::waitForWork() {
+    if (workPending()) return;
+
+    switch (waitStrategy) {
+        case WaitStrategy::Spin:
+            while (!workPending()) cpuRelax();
+            return;
+
+        case WaitStrategy::Interval:
+            std::this_thread::sleep_for(waitInterval);
+            return;
+
+        case WaitStrategy::Adaptive: {
+            using Clock = std::chrono::steady_clock;
+            const auto spinUntil = Clock::now() + waitSpin;
+            do {
+                for (int i = 0; i < 64; ++i) {
+                    if (workPending()) return;
+                    cpuRelax();
+                }
+            } while (Clock::now() < spinUntil);
+
+            const auto yieldUntil = Clock::now() + waitSpin;
+            do {
+                if (workPending()) return;
+                std::this_thread::yield();
+            } while (Clock::now() < yieldUntil);
+
+            // Park. The flag is raised under the mutex, and a producer that
+            // sees it takes the mutex before notifying, so no wakeup is lost.
+            // The timeout is only a safety net.
             std::unique_lock<std::mutex> lock(mutex);
-            while (!logQueue.empty() && batch.size() < MAX_BATCH_SIZE) {
-                batch.emplace_back(std::move(logQueue.front()));
-                logQueue.pop_front();
-            }
+            consumerParked.store(true, std::memory_order_seq_cst);
+            logCondition.wait_for(lock, std::chrono::milliseconds(100), [this] { return workPending(); });
+            consumerParked.store(false, std::memory_order_relaxed);
+            return;
         }
+    }
+}
 
+// Producer side: a futex call only when the consumer is actually parked
+template <typename Backends>
+void LoggerCore<Backends>::wakeConsumer() {
+    // Either the consumer sees our queueSize claim before it parks, or we
+    // see it parked here (both sides are seq_cst)
+    if (!consumerParked.load(std::memory_order_seq_cst)) return;
+
+    { std::lock_guard<std::mutex> lock(mutex); }
+    logCondition.notify_one();
+}
+
+template <typename Backends>
+void LoggerCore<Backends>::processQueue() {
+    if (crashHandlerRegistered) CrashHandler::prepareThread();
+
+    // Both live for the whole thread; clearing keeps their capacity
+    std::vector<LogMessage> batch;
+    batch.reserve(batchSize);
+    mergeBuffer.reserve(batchSize);
+    std::string scratch;
+    std::vector<std::shared_ptr<ProducerRing>> rings;
+    std::uint64_t seenVersion = 0;
+
+    for (;;) {
+        // Read the flag before draining so everything enqueued ahead of
+        // shutdown() is dispatched before the thread exits.
+        const bool exiting = exitFlag.load(std::memory_order_acquire);
+
+        waitForWork();
+        batch.clear();
+        switch (queueMode) {
+            case QueueMode::Ring:      drainRing(batch); break;
+            case QueueMode::PerThread: drainThreadRings(batch, rings, seenVersion); break;
+            case QueueMode::Deque:     drainDeque(batch); break;
+        }
+
+        // One snapshot per batch; a reload takes effect from the next one
+        const LoggerSettings& settings = m_settings->current();
+        crashSettings.store(&settings, std::memory_order_release);
+
+        if (batch.empty()) {
+            flushRepeats(settings, exiting);
+            reportDrops(settings);
+            reportSuppressed(settings, exiting);
+            if (exiting) break;
+            continue;
+        }
+
+        // From here on the crash handler writes the batch if we die
+        crashBatch.store(&batch, std::memory_order_release);
+
+        std::size_t bytes = 0;
+        for (const auto& logMsg : batch) {
+            bytes += footprint(logMsg);
+        }
+        release(batch.size(), bytes);
+        wakeProducers();
+
+        const auto& format = settings.config.format;
         for (auto& logMsg : batch) {
-            if (m_backends && m_settings) {
-                m_backends->dispatchLog(logMsg, *m_settings);
+            logMsg.materialize(scratch);
+            if (format.enableTimestamps) {
+                logMsg.stampTime(format.timestampFormat);
             }
         }
+
+        const std::int64_t coalesceWindowNs = settings.config.general.coalesceWindowMs * 1'000'000;
+        if (coalesceWindowNs > 0) {
+            std::vector<LogMessage> leading;
+            coalescer.apply(batch, coalesceWindowNs, format, leading);
+            if (!leading.empty()) dispatch(leading, settings);
+        }
+        dispatch(batch, settings);
+        crashBatch.store(nullptr, std::memory_order_release);
+
+        if (queueSize.load(std::memory_order_acquire) == 0) {
+            reportDrops(settings);
+        }
+        reportSuppressed(settings, false);
+    }
+}
+
+template <typename Backends>
+void LoggerCore<Backends>::shutdown() {
+    if (crashHandlerRegistered) {
+        CrashHandler::remove(this);
+        crashHandlerRegistered = false;
     }
 
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        exitFlag.store(true, std::memory_order_release);
+    }
+
+    logCondition.notify_all();
+    { std::lock_guard<std::mutex> lock(spaceMutex); }
+    spaceCondition.notify_all();   // blocked producers give up
+
     if (logThread.joinable()) {
         logThread.join();
     }
-}
 
-inline std::string getCurrentTimestamp(const std::string& format) {
-    std::time_t t = std::time(nullptr);
-    std::tm tm{};
-#if defined(_WIN32)
-    localtime_s(&tm, &t);
-#else
-    localtime_r(&t, &tm);
-#endif
-    char buf[64] = {0};
-    if (format == "ISO") {
-        std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", &tm);
-    } else {
-        std::strftime(buf, sizeof(buf), format.c_str(), &tm);
+    if (m_backends) {
+        m_backends->flush();
     }
-    return std::string(buf);
 }
 
 #endif // LOGGER_CORE_HPP
@@ -0,0 +1,136 @@
+#ifndef MESSAGE_PAYLOAD_HPP
+#define MESSAGE_PAYLOAD_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#define MESSAGE_INLINE_CAPACITY 112   // Payload bytes stored inside the LogMessage itself
+
+//------------------------------------------------------------------------------
+// SlabArena: Process-wide pool of fixed-size buffers for oversized payloads
+//
+// Slabs come in a few size classes. The thread that drops a message
+// (normally the consumer) pushes its slab onto the class's lock-free return
+// list; a producer that runs out of slabs takes that whole list over into a
+// thread-local cache with one exchange. Slabs are never given back to the
+// allocator, so it only sees traffic until the pool has grown to the number
+// of oversized messages in flight. Payloads above the largest class go to
+// the heap directly.
+//------------------------------------------------------------------------------
+class SlabArena {
+public:
+    static constexpr std::array<std::size_t, 4> SLAB_SIZES{256, 1024, 4096, 16384};
+
+    static SlabArena& instance();
+
+    // `bytes` decides the size class; pass the same value to release()
+    char* acquire(std::size_t bytes);
+    void release(char* slab, std::size_t bytes);
+
+    // True when a slab acquired for `a` bytes is the one acquire(b) would hand out
+    static bool sameSlab(std::size_t a, std::size_t b) {
+        const std::size_t slabClass = sizeClass(a);
+        return slabClass < SLAB_SIZES.size() && slabClass == sizeClass(b);
+    }
+
+    // Index into SLAB_SIZES, or SLAB_SIZES.size() for a heap allocation
+    static std::size_t sizeClass(std::size_t bytes) {
+        std::size_t slabClass = 0;
+        while (slabClass < SLAB_SIZES.size() && bytes > SLAB_SIZES[slabClass]) ++slabClass;
+        return slabClass;
+    }
+
+    // Overlaid on the first bytes of a free slab
+    struct FreeSlab {
+        FreeSlab* next;
+    };
+
+    // Puts a whole list back onto the return list (exiting threads' caches)
+    void giveBack(std::size_t slabClass, FreeSlab* first);
+
+private:
+    SlabArena() = default;
+
+    std::array<std::atomic<FreeSlab*>, SLAB_SIZES.size()> returned{};
+};
+
+//------------------------------------------------------------------------------
+// MessagePayload: Message text with a fixed inline capacity
+//
+// Up to MESSAGE_INLINE_CAPACITY bytes live in the object; longer text spills
+// into a SlabArena slab that travels with the message through the queue.
+// Reads like a std::string_view.
+//------------------------------------------------------------------------------
+class MessagePayload {
+public:
+    MessagePayload() = default;
+    MessagePayload(std::string_view text) { assign(text); }
+
+    MessagePayload(const MessagePayload& other) { assign(other.view()); }
+    MessagePayload(MessagePayload&& other) noexcept { take(other); }
+
+    MessagePayload& operator=(const MessagePayload& other) {
+        if (this != &other) assign(other.view());
+        return *this;
+    }
+
+    MessagePayload& operator=(MessagePayload&& other) noexcept {
+        if (this != &other) {
+            clear();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~MessagePayload() { clear(); }
+
+    void assign(std::string_view text) {
+        // A slab of the right size class is kept rather than swapped
+        if (spill && (text.size() <= MESSAGE_INLINE_CAPACITY || !SlabArena::sameSlab(length, text.size()))) {
+            clear();
+        }
+        if (!spill && text.size() > MESSAGE_INLINE_CAPACITY) {
+            spill = SlabArena::instance().acquire(text.size());
+        }
+        length = static_cast<std::uint32_t>(text.size());
+        std::memcpy(spill ? spill : inlineData.data(), text.data(), text.size());
+    }
+
+    void clear() {
+        if (spill) {
+            SlabArena::instance().release(spill, length);
+            spill = nullptr;
+        }
+        length = 0;
+    }
+
+    const char* data() const { return spill ? spill : inlineData.data(); }
+    std::size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    bool spilled() const { return spill != nullptr; }
+
+    std::string_view view() const { return {data(), length}; }
+    operator std::string_view() const { return view(); }
+
+private:
+    std::uint32_t length = 0;
+    char* spill = nullptr;   // slab holding the text when length > MESSAGE_INLINE_CAPACITY
+    std::array<char, MESSAGE_INLINE_CAPACITY> inlineData;
+
+    // Steals the slab, or copies just the used inline bytes
+    void take(MessagePayload& other) {
+        length = other.length;
+        spill = other.spill;
+        if (!spill) {
+            std::memcpy(inlineData.data(), other.inlineData.data(), length);
+        }
+        other.spill = nullptr;
+        other.length = 0;
+    }
+};
+
+#endif // MESSAGE_PAYLOAD_HPP
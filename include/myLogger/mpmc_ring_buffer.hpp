@@ -0,0 +1,135 @@
+#ifndef MPMC_RING_BUFFER_HPP
+#define MPMC_RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+#define CACHE_LINE_SIZE 64
+
+//------------------------------------------------------------------------------
+// MpmcRingBuffer: Bounded lock-free multi-producer/multi-consumer queue
+//
+// Preallocated array of cache-line sized cells, each carrying a sequence
+// number that tells producers and consumers whose turn it is (Vyukov style).
+// Producers never take a lock; a full ring makes tryPush() return false.
+//------------------------------------------------------------------------------
+template <typename T>
+class MpmcRingBuffer {
+public:
+    explicit MpmcRingBuffer(std::size_t requestedCapacity)
+        : capacity(roundUpToPowerOfTwo(requestedCapacity < 2 ? 2 : requestedCapacity))
+        , mask(capacity - 1)
+        , cells(std::make_unique<Cell[]>(capacity))
+    {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRingBuffer(const MpmcRingBuffer&) = delete;
+    MpmcRingBuffer& operator=(const MpmcRingBuffer&) = delete;
+
+    // Moves `value` into the ring only on success; leaves it untouched when full.
+    template <typename U>
+    bool tryPush(U&& value) {
+        std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = std::forward<U>(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& out) {
+        std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(cell.data);
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Claims up to `maxItems` consecutive ready cells with a single CAS and
+    // hands each one to `consume(T&&)`. Returns the number of items consumed.
+    template <typename F>
+    std::size_t popBulk(std::size_t maxItems, F&& consume) {
+        std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        std::size_t count;
+        for (;;) {
+            count = 0;
+            while (count < maxItems) {
+                const std::size_t seq = cells[(pos + count) & mask].sequence.load(std::memory_order_acquire);
+                if (seq != pos + count + 1) break;
+                ++count;
+            }
+            if (count == 0) return 0;
+            if (dequeuePos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) break;
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            Cell& cell = cells[(pos + i) & mask];
+            consume(std::move(cell.data));
+            cell.sequence.store(pos + i + mask + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    bool empty() const {
+        const std::size_t pos = dequeuePos.load(std::memory_order_acquire);
+        return cells[pos & mask].sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+    std::size_t size() const {
+        const std::size_t head = enqueuePos.load(std::memory_order_acquire);
+        const std::size_t tail = dequeuePos.load(std::memory_order_acquire);
+        return head > tail ? head - tail : 0;
+    }
+
+    std::size_t getCapacity() const { return capacity; }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Cell {
+        std::atomic<std::size_t> sequence{0};
+        T data{};
+    };
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t v) {
+        std::size_t p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+
+    const std::size_t capacity;
+    const std::size_t mask;
+    std::unique_ptr<Cell[]> cells;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueuePos{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeuePos{0};
+};
+
+#endif // MPMC_RING_BUFFER_HPP
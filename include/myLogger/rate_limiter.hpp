@@ -0,0 +1,101 @@
+#ifndef RATE_LIMITER_HPP
+#define RATE_LIMITER_HPP
+
+#include "myLogger/logger_config.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// One context/level pair's limits as written in [contexts]
+struct LimitRule {
+    double rate = 0;     // messages per second, 0 = no limit
+    double burst = 0;    // messages let through at once, 0 = one second's worth
+    double sample = 1;   // fraction kept, drawn at random per message
+};
+
+//------------------------------------------------------------------------------
+// RateLimiter: Per-context sampling and token buckets, applied in shouldLog()
+//
+//   [contexts]
+//   NETWORK = { level = "INFO", rate = 1000, burst = 5000, DEBUG = { sample = 0.01 } }
+//
+// Producers never take a lock and only write shared memory when a message
+// gets through:
+// - Sampling draws from a per-thread generator.
+// - The bucket is a single "theoretical arrival time" (GCRA). Taking a
+//   token is one CAS, and refusing one is a plain load, so a flood that is
+//   being cut down leaves the cache line shared.
+// - Suppressed counts go to one of a few cache-line shards picked per
+//   thread. The logger thread collects them for the periodic summary.
+//
+// Built by each config load; contexts without limits cost one null check.
+//------------------------------------------------------------------------------
+class RateLimiter {
+public:
+    static constexpr std::size_t SHARD_COUNT = 8;
+
+    RateLimiter() = default;
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    // Installs `rules` (indexed by LevelId) for `context`; returns false when none of them limits anything
+    bool setRules(ContextId context, const std::array<LimitRule, MAX_LEVELS>& rules);
+
+    bool empty() const { return contexts.empty(); }
+
+    // false: the message is suppressed (and counted)
+    bool admit(LevelId level, ContextId context) {
+        if (context >= contexts.size() || level >= MAX_LEVELS) return true;
+        ContextState* state = contexts[context].get();
+        if (state == nullptr || !state->rules[level].limited) return true;
+        return admitLimited(*state, level);
+    }
+
+    // Calls visit(context, level, count) for everything suppressed since the
+    // previous call, then starts counting from zero (logger thread)
+    template <typename Visit>
+    void collectSuppressed(Visit&& visit) {
+        for (std::size_t context = 0; context < contexts.size(); ++context) {
+            ContextState* state = contexts[context].get();
+            if (state == nullptr) continue;
+            for (std::size_t level = 0; level < MAX_LEVELS; ++level) {
+                std::uint64_t count = 0;
+                for (auto& shard : state->shards) {
+                    count += shard.suppressed[level].exchange(0, std::memory_order_relaxed);
+                }
+                if (count != 0) visit(static_cast<ContextId>(context), static_cast<LevelId>(level), count);
+            }
+        }
+    }
+
+private:
+    struct Rule {
+        bool limited = false;                  // sampled or bucketed
+        bool sampled = false;
+        std::uint64_t sampleThreshold = 0;     // kept when a 64-bit draw is below it
+        std::int64_t intervalNs = 0;           // 1 / rate, 0 = no bucket
+        std::int64_t toleranceNs = 0;          // (burst - 1) intervals
+    };
+
+    struct alignas(64) Bucket {
+        std::atomic<std::int64_t> arrival{0};   // steady-clock ns the bucket is full again
+    };
+
+    struct alignas(64) Shard {
+        std::array<std::atomic<std::uint64_t>, MAX_LEVELS> suppressed{};
+    };
+
+    struct ContextState {
+        std::array<Rule, MAX_LEVELS> rules;
+        std::array<Bucket, MAX_LEVELS> buckets;
+        std::array<Shard, SHARD_COUNT> shards;
+    };
+
+    std::vector<std::unique_ptr<ContextState>> contexts;   // by ContextId; null = no limits
+
+    bool admitLimited(ContextState& state, LevelId level);
+};
+
+#endif // RATE_LIMITER_HPP
@@ -0,0 +1,78 @@
+#ifndef SETTINGS_SNAPSHOTS_HPP
+#define SETTINGS_SNAPSHOTS_HPP
+
+#include "myLogger/logger_config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// SettingsSnapshots: RCU-style publication of immutable LoggerSettings
+//
+// A reload parses into a fresh copy of the current snapshot and publish()es
+// it; published snapshots are never modified again. Every thread keeps its
+// own reference to the snapshot it last used, so current() costs a single
+// acquire load of the version while nothing changed, and only takes the
+// lock once per thread after a reload. The per-thread cache has a slot per
+// cell id (modulo CACHE_SLOTS), so threads that use several loggers in turn
+// stay on the fast path. A snapshot is freed by whichever
+// thread drops the last reference - readers never see it go away mid-use.
+//
+// The ContextRegistry is shared by all snapshots (it is concurrent already),
+// so context ids stay valid across reloads. Everything a reload changes,
+// per-context severities included, belongs to the snapshot and switches
+// over with it in one publish().
+//------------------------------------------------------------------------------
+class SettingsSnapshots {
+public:
+    SettingsSnapshots() = default;
+
+    SettingsSnapshots(const SettingsSnapshots&) = delete;
+    SettingsSnapshots& operator=(const SettingsSnapshots&) = delete;
+
+    // The calling thread's view of the newest snapshot. The reference stays
+    // valid until this thread calls current() again, on any SettingsSnapshots.
+    const LoggerSettings& current() const {
+        const std::uint64_t version = publishedVersion.load(std::memory_order_acquire);
+        const LastUsed& cached = lastUsed[id % CACHE_SLOTS];
+        if (cached.id == id && cached.version == version) {
+            return *cached.snapshot;
+        }
+        return refresh();
+    }
+
+    // Shared ownership of the newest snapshot, for holders outside current()'s rules
+    std::shared_ptr<const LoggerSettings> latest() const;
+
+    void publish(std::shared_ptr<const LoggerSettings> next);
+
+private:
+    // The calling thread's most recent current() result per cell, in the
+    // slot `id % CACHE_SLOTS`. Plain data, so the fast path reads it without
+    // a TLS init guard; the references that keep snapshots alive live in
+    // refresh().
+    struct LastUsed {
+        std::uint64_t id;        // 0: none yet (cell ids start at 1)
+        std::uint64_t version;
+        const LoggerSettings* snapshot;
+    };
+    static constexpr std::size_t CACHE_SLOTS = 8;
+    static inline thread_local constinit LastUsed lastUsed[CACHE_SLOTS]{};
+
+    const LoggerSettings& refresh() const;
+
+    static std::uint64_t nextId() {
+        static std::atomic<std::uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    const std::uint64_t id{nextId()};
+    std::atomic<std::uint64_t> publishedVersion{0};
+    mutable std::mutex mutex;
+    std::shared_ptr<const LoggerSettings> snapshot;   // guarded by mutex
+};
+
+#endif // SETTINGS_SNAPSHOTS_HPP
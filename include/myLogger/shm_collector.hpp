@@ -0,0 +1,56 @@
+#ifndef SHM_COLLECTOR_HPP
+#define SHM_COLLECTOR_HPP
+
+#include "myLogger/backends/file_backend.hpp"
+#include "myLogger/logger_config.hpp"
+#include "myLogger/shm_ring.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// ShmCollector: The reading end of ShmRingBackend (mylogger-collector)
+//
+// Each sweep maps rings named "/<shm_ring_name>.*" that appeared since the
+// last one, takes every published record, orders the sweep by capture time
+// and writes it through a FileBackend configured from the same settings
+// (log_directory, log_filename_format, rotation). Read positions are handed
+// back only after the write, so a collector that dies loses nothing; its
+// successor starts where it stopped. Drops counted by a writer are reported
+// as a LOGGER line. A ring whose writer shut down or died is removed once
+// drained. Finding rings needs a listable /dev/shm (Linux).
+//------------------------------------------------------------------------------
+class ShmCollector {
+public:
+    explicit ShmCollector(const LoggerSettings& settings);
+    ~ShmCollector();
+
+    ShmCollector(const ShmCollector&) = delete;
+    ShmCollector& operator=(const ShmCollector&) = delete;
+
+    // One sweep; returns the number of records written
+    std::size_t poll();
+
+    // Sweeps every shm_poll_ms until `stop` is set, then once more
+    void run(const std::atomic<bool>& stop);
+
+    std::size_t ringCount() const { return sources.size(); }
+
+private:
+    struct Source {
+        std::string name;
+        ShmRing ring;
+        std::uint64_t dropped = 0;   // as of the current sweep
+    };
+
+    LoggerSettings settings;
+    FileBackend output;
+    std::vector<std::unique_ptr<Source>> sources;
+    std::vector<LogMessage> batch;
+
+    void discover();
+    LevelId internLevel(std::string_view name);
+};
+
+#endif // SHM_COLLECTOR_HPP
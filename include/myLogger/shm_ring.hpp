@@ -0,0 +1,104 @@
+#ifndef SHM_RING_HPP
+#define SHM_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+//------------------------------------------------------------------------------
+// ShmRing: Byte ring in a named POSIX shared-memory segment, written by one
+// process (ShmRingBackend) and read by another (mylogger-collector)
+//
+//   segment := header (one page) data[capacity]
+//   record  := length:u32 levelLength:u16 contextLength:u16 timeNs:i64
+//              level context text             (padded to 8 bytes; length excludes padding)
+//
+// A record never wraps: when it does not fit before the end of the data area
+// the writer leaves a length word with SHM_RECORD_WRAP set and starts over at
+// offset 0. Positions only grow; the writer publishes writePos once per batch
+// and the reader publishes readPos once it has stored what it took. Neither
+// side waits for the other and neither makes a syscall after setup: a full
+// ring makes tryWrite() fail, and the caller counts the record in `dropped`.
+//------------------------------------------------------------------------------
+inline constexpr std::uint64_t SHM_RING_MAGIC = 0x474E5252474F4C4DULL;   // "MLOGRRNG"
+inline constexpr std::uint32_t SHM_RING_VERSION = 1;
+inline constexpr std::uint32_t SHM_RECORD_WRAP = 0x80000000u;
+
+struct ShmRingHeader {
+    std::atomic<std::uint64_t> magic;   // stored last by create(); readers ignore the segment until set
+    std::uint32_t version;
+    std::uint32_t capacity;             // data bytes, a power of two
+    std::int32_t pid;                   // writer process
+    std::atomic<std::uint32_t> closed;  // writer has shut down; nothing more will be published
+
+    alignas(64) std::atomic<std::uint64_t> writePos;
+    alignas(64) std::atomic<std::uint64_t> readPos;
+    std::atomic<std::uint64_t> droppedReported;       // reader's share of `dropped`, survives reader restarts
+    alignas(64) std::atomic<std::uint64_t> dropped;   // records the writer could not fit
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "ShmRing needs address-free 64-bit atomics");
+
+// One record as seen by the reader; the views point into the segment and are
+// valid until commit()
+struct ShmRecord {
+    std::int64_t timeNs = 0;
+    std::string_view level;
+    std::string_view context;
+    std::string_view text;
+};
+
+class ShmRing {
+public:
+    ShmRing() = default;
+    ~ShmRing();
+
+    ShmRing(const ShmRing&) = delete;
+    ShmRing& operator=(const ShmRing&) = delete;
+
+    // Writer: creates `name` (replacing a stale segment of that name) with at
+    // least `capacity` data bytes. False when shared memory is unavailable.
+    bool create(const std::string& name, std::size_t capacity);
+
+    // Reader: maps a segment made by create(). False until the writer has
+    // finished initializing it.
+    bool attach(const std::string& name);
+
+    // Unmaps; `markClosed` tells the reader the writer is done
+    void close(bool markClosed = false);
+
+    static void unlink(const std::string& name);
+
+    bool isOpen() const { return header != nullptr; }
+
+    // Writer side. Copies the record without publishing it; false when the ring is full.
+    bool tryWrite(std::int64_t timeNs, std::string_view level, std::string_view context, std::string_view text);
+    void publish();
+    void countDropped(std::uint64_t count);
+
+    // Reader side. next() walks the published records; commit() hands the
+    // space back to the writer and remembers how many drops were reported.
+    bool next(ShmRecord& record);
+    void commit(std::uint64_t droppedReported);
+    std::uint64_t droppedReported() const;
+
+    std::uint64_t dropped() const;
+    bool closed() const;
+    int writerPid() const;
+
+private:
+    ShmRingHeader* header = nullptr;
+    char* data = nullptr;
+    std::size_t mappedSize = 0;
+    std::uint64_t capacity = 0;
+    std::uint64_t mask = 0;
+
+    std::uint64_t localPos = 0;    // writer: next write position, reader: next read position
+    std::uint64_t cachedPos = 0;   // writer: last seen readPos, reader: last seen writePos
+
+    bool map(int fd, std::size_t size);
+};
+
+#endif // SHM_RING_HPP
@@ -0,0 +1,98 @@
+#ifndef SPSC_RING_BUFFER_HPP
+#define SPSC_RING_BUFFER_HPP
+
+#include "myLogger/mpmc_ring_buffer.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+//------------------------------------------------------------------------------
+// SpscRingBuffer: Bounded wait-free single-producer/single-consumer queue
+//
+// Head and tail live on separate cache lines and each side keeps a cached
+// copy of the other's index, so the shared lines are only touched when the
+// cached view says the ring looks full (producer) or empty (consumer).
+//------------------------------------------------------------------------------
+template <typename T>
+class SpscRingBuffer {
+public:
+    explicit SpscRingBuffer(std::size_t requestedCapacity)
+        : capacity(roundUpToPowerOfTwo(requestedCapacity < 2 ? 2 : requestedCapacity))
+        , mask(capacity - 1)
+        , slots(std::make_unique<T[]>(capacity))
+    {}
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    // Producer side. Moves `value` into the ring only on success.
+    template <typename U>
+    bool tryPush(U&& value) {
+        const std::size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head - cachedTail >= capacity) {
+            cachedTail = tailIndex.load(std::memory_order_acquire);
+            if (head - cachedTail >= capacity) return false;
+        }
+        slots[head & mask] = std::forward<U>(value);
+        headIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns the oldest element without removing it.
+    T* front() {
+        const std::size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail == cachedHead) {
+            cachedHead = headIndex.load(std::memory_order_acquire);
+            if (tail == cachedHead) return nullptr;
+        }
+        return &slots[tail & mask];
+    }
+
+    // Consumer side. Drops the element returned by front().
+    void pop() {
+        tailIndex.store(tailIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer side. Hands up to `maxItems` elements to `consume(T&&)`.
+    template <typename F>
+    std::size_t popBulk(std::size_t maxItems, F&& consume) {
+        const std::size_t tail = tailIndex.load(std::memory_order_relaxed);
+        cachedHead = headIndex.load(std::memory_order_acquire);
+        std::size_t count = cachedHead - tail;
+        if (count > maxItems) count = maxItems;
+        for (std::size_t i = 0; i < count; ++i) {
+            consume(std::move(slots[(tail + i) & mask]));
+        }
+        tailIndex.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    bool empty() const {
+        return headIndex.load(std::memory_order_acquire) == tailIndex.load(std::memory_order_acquire);
+    }
+
+    std::size_t size() const {
+        return headIndex.load(std::memory_order_acquire) - tailIndex.load(std::memory_order_acquire);
+    }
+
+    std::size_t getCapacity() const { return capacity; }
+
+private:
+    static std::size_t roundUpToPowerOfTwo(std::size_t v) {
+        std::size_t p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+
+    const std::size_t capacity;
+    const std::size_t mask;
+    std::unique_ptr<T[]> slots;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> headIndex{0};
+    std::size_t cachedTail{0};   // producer-owned
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tailIndex{0};
+    std::size_t cachedHead{0};   // consumer-owned
+};
+
+#endif // SPSC_RING_BUFFER_HPP
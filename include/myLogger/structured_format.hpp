@@ -0,0 +1,39 @@
+#ifndef STRUCTURED_FORMAT_HPP
+#define STRUCTURED_FORMAT_HPP
+
+#include "myLogger/log_fields.hpp"
+#include "myLogger/text_escape.hpp"
+#include <string>
+#include <string_view>
+
+//------------------------------------------------------------------------------
+// Text encodings selected by log_format
+//
+//   plain   2024-05-01T12:00:00 [INFO] APP: message user_id=42
+//   json    {"time":"2024-05-01T12:00:00","level":"INFO","context":"APP","msg":"message","user_id":42}
+//   logfmt  time=2024-05-01T12:00:00 level=INFO context=APP msg=message user_id=42
+//
+// "binary" is handled by BinaryLogEncoder; text backends fall back to plain.
+// Everything appends to the caller's buffer and formats numbers on the
+// stack, so a reused buffer makes encoding allocation-free. The time key is
+// left out when timestamps are disabled.
+//------------------------------------------------------------------------------
+enum class LogFormat {
+    Plain,
+    Json,
+    Logfmt,
+    Binary
+};
+
+// Unknown names mean Plain
+LogFormat parseLogFormat(std::string_view name);
+
+// One complete line, newline included
+void appendRecordLine(LogFormat format, std::string_view timestamp, std::string_view level,
+                      std::string_view context, std::string_view message, const LogFields& fields,
+                      std::string& out);
+
+// " key=value ..." as appended to plain lines
+void appendPlainFields(const LogFields& fields, std::string& out);
+
+#endif // STRUCTURED_FORMAT_HPP
@@ -0,0 +1,64 @@
+#ifndef TEXT_ESCAPE_HPP
+#define TEXT_ESCAPE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+//------------------------------------------------------------------------------
+// Escaping and UTF-8 validation for text that leaves the process
+//
+// Log text is mostly printable ASCII, so the work is finding the few bytes
+// that need attention. A kernel scans 16 (SSE2) or 32 (AVX2) bytes per step
+// for them, and everything in between is appended as one run. Anything
+// non-ASCII stops the scan and is validated as a UTF-8 sequence. Valid
+// sequences are copied through. Invalid bytes become U+FFFD, so JSON output
+// is always valid UTF-8.
+//
+// The kernel is picked once from the CPU's features. Scalar is used on
+// other architectures and as the reference in tests.
+//------------------------------------------------------------------------------
+enum class SimdLevel {
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+// Each scan returns the first index >= `from` holding a byte of its class,
+// or `size` when there is none
+struct EscapeKernel {
+    SimdLevel level;
+    // '"', '\\', controls, DEL and non-ASCII
+    std::size_t (*findJsonSpecial)(const char* data, std::size_t size, std::size_t from);
+    // Anything that makes a logfmt value need quotes, plus non-ASCII
+    std::size_t (*findLogfmtSpecial)(const char* data, std::size_t size, std::size_t from);
+    // Controls other than '\t', DEL and non-ASCII
+    std::size_t (*findTerminalSpecial)(const char* data, std::size_t size, std::size_t from);
+    // Bytes with the high bit set
+    std::size_t (*findNonAscii)(const char* data, std::size_t size, std::size_t from);
+};
+
+// Best kernel this CPU supports, chosen on first use
+const EscapeKernel& escapeKernel();
+
+// A specific kernel, or nullptr when it is not built in or not supported by this CPU
+const EscapeKernel* escapeKernelFor(SimdLevel level);
+
+const char* simdLevelName(SimdLevel level);
+
+// Length of the well-formed UTF-8 sequence at the start of `text`, 0 when it is not one
+std::size_t utf8SequenceLength(std::string_view text);
+
+bool isValidUtf8(std::string_view text, const EscapeKernel& kernel = escapeKernel());
+
+// `text` as the inside of a JSON string literal (quotes not included)
+void appendJsonEscaped(std::string_view text, std::string& out, const EscapeKernel& kernel = escapeKernel());
+
+// `text` as a logfmt value, quoted only when it has to be
+void appendLogfmtValue(std::string_view text, std::string& out, const EscapeKernel& kernel = escapeKernel());
+
+// `text` made safe for a terminal: controls other than '\t' (including ESC)
+// become "\xNN", and invalid UTF-8 becomes U+FFFD
+void appendTerminalSafe(std::string_view text, std::string& out, const EscapeKernel& kernel = escapeKernel());
+
+#endif // TEXT_ESCAPE_HPP
@@ -0,0 +1,69 @@
+#ifndef TIMESTAMP_FORMATTER_HPP
+#define TIMESTAMP_FORMATTER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#define MAX_TIMESTAMP_LENGTH 48
+
+//------------------------------------------------------------------------------
+// Timestamp formatting
+//
+// `format` is one of:
+//   "ISO"     2024-05-01T12:34:56
+//   "ISO_MS"  2024-05-01T12:34:56.123
+//   "ISO_US"  2024-05-01T12:34:56.123456
+//   "ISO_NS"  2024-05-01T12:34:56.123456789
+//   anything else is treated as a strftime() pattern (second resolution)
+//
+// The date/time prefix is cached per thread and per second; only the
+// sub-second digits are written for every call. For the ISO formats the
+// local UTC offset is looked up again only when a cached offset may have
+// gone stale (at most every 15 minutes, which covers DST switches);
+// strftime patterns get localtime_r once per second, so %z and %Z work.
+//------------------------------------------------------------------------------
+
+// Capture time for a log record, nanoseconds since the Unix epoch
+inline std::int64_t currentTimeNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Writes the formatted timestamp into `out` (not NUL-terminated) and returns its
+// length; output longer than `capacity` is truncated.
+std::size_t formatTimestamp(std::int64_t timeNs, std::string_view format, char* out, std::size_t capacity);
+
+// Local time minus UTC at `timeNs`, in seconds (uses localtime_r)
+std::int64_t localUtcOffset(std::int64_t timeNs);
+
+// Same as formatTimestamp for the ISO formats, with the UTC offset given by
+// the caller (see localUtcOffset); strftime patterns give ISO_NS. Uses no
+// caches, locks or locale, so it is safe in a signal handler.
+std::size_t formatTimestampAtOffset(std::int64_t timeNs, std::int64_t utcOffset, std::string_view format,
+                                    char* out, std::size_t capacity);
+
+inline constexpr char DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Writes `value` as exactly `width` decimal digits, zero padded, two digits per step
+inline char* writeFixedDigits(char* out, std::uint32_t value, int width) {
+    int i = width;
+    while (i >= 2) {
+        const std::uint32_t pair = (value % 100) * 2;
+        value /= 100;
+        out[--i] = DIGIT_PAIRS[pair + 1];
+        out[--i] = DIGIT_PAIRS[pair];
+    }
+    if (i == 1) {
+        out[0] = static_cast<char>('0' + value % 10);
+    }
+    return out + width;
+}
+
+#endif // TIMESTAMP_FORMATTER_HPP
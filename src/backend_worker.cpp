@@ -0,0 +1,102 @@
+#include "myLogger/backend_worker.hpp"
+#include <algorithm>
+
+BackendWorker::BackendWorker(WriteFn write, FlushFn flush, const Options& opts)
+    : writeFn(std::move(write))
+    , flushFn(std::move(flush))
+    , options(opts)
+{
+    thread = std::thread(&BackendWorker::run, this);
+}
+
+BackendWorker::~BackendWorker() {
+    stop();
+}
+
+//------------------------------------------------------------------------------
+// Producer Side (logger thread)
+//------------------------------------------------------------------------------
+void BackendWorker::post(const SharedLogBatch& batch) {
+    if (!batch || batch->empty()) return;
+    const std::size_t count = batch->size();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    auto fits = [&] {
+        return options.maxQueuedMessages == 0 || counters.queuedMessages == 0
+            || counters.queuedMessages + count <= options.maxQueuedMessages;
+    };
+
+    if (options.policy == OverflowPolicy::DropOldest) {
+        while (!fits() && !pending.empty()) {
+            counters.queuedMessages -= pending.front()->size();
+            counters.droppedMessages += pending.front()->size();
+            pending.pop_front();
+        }
+    }
+    if (!fits() || stopping) {
+        counters.droppedMessages += count;
+        return;
+    }
+
+    pending.push_back(batch);
+    counters.queuedMessages += count;
+    counters.peakQueuedMessages = std::max(counters.peakQueuedMessages, counters.queuedMessages);
+    lock.unlock();
+    wake.notify_one();
+}
+
+void BackendWorker::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    progress.wait(lock, [this] { return pending.empty() && !busy; });
+}
+
+void BackendWorker::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    progress.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+BackendStats BackendWorker::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+//------------------------------------------------------------------------------
+// Worker Thread
+//------------------------------------------------------------------------------
+void BackendWorker::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this] { return !pending.empty() || stopping; });
+        if (pending.empty()) return;   // stopping, and everything is written
+
+        const SharedLogBatch batch = std::move(pending.front());
+        pending.pop_front();
+        busy = true;
+        lock.unlock();
+
+        writeFn(std::span<const LogMessage>(*batch));
+        const bool idle = [&] {
+            std::lock_guard<std::mutex> guard(mutex);
+            return pending.empty();
+        }();
+        if (idle && options.flushWhenIdle) {
+            flushFn();
+        }
+        const std::int64_t lagNs = currentTimeNs() - batch->back().timeNs;
+
+        lock.lock();
+        busy = false;
+        counters.queuedMessages -= batch->size();
+        counters.writtenMessages += batch->size();
+        counters.lastLagNs = lagNs;
+        counters.maxLagNs = std::max(counters.maxLagNs, lagNs);
+        progress.notify_all();
+    }
+}
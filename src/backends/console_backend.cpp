@@ -1,5 +1,7 @@
 #include "myLogger/backends/console_backend.hpp"
 #include "myLogger/logger_config.hpp"
+#include <cerrno>
+#include <unistd.h>
 
 struct RGB {
     int r, g, b;
@@ -69,36 +71,128 @@ int ConsoleBackend::hexToAnsiColor(const std::string& hexColor) {
 // Setup Console Logging
 //------------------------------------------------------------------------------
 void ConsoleBackend::setup(const LoggerSettings& settings) {
+    isTty = ::isatty(STDOUT_FILENO) != 0;
+    rebuildStyles(settings);
+}
+
+//------------------------------------------------------------------------------
+// Rendering Tables
+//------------------------------------------------------------------------------
+std::string ConsoleBackend::ansiColorFor(const LoggerSettings& settings, const std::string& key) const {
+    if (!colorize) return {};
+    const auto& parsed = settings.config.colors.parsedLogColors;
+    const auto it = parsed.find(key);
+    return "\033[" + std::to_string(hexToAnsiColor(it != parsed.end() ? it->second : "#FFFFFF")) + "m";
+}
+
+// Color comes from the level or the context, depending on color_mode
+ConsoleBackend::Style ConsoleBackend::buildStyle(const LoggerSettings& settings, std::string_view name, bool isLevel) const {
+    Style style;
+    if (isLevel != colorByContext) {
+        style.color = ansiColorFor(settings, (isLevel ? "level_" : "context_") + std::string(name));
+    }
+    if (isLevel && !hideLevelTag) {
+        style.tag = "[" + std::string(name) + "] ";
+    } else if (!isLevel && !hideContextTag) {
+        style.tag = std::string(name) + ": ";
+    }
+    return style;
+}
 
+// Everything appendLine() needs per level and context, resolved once per config load
+void ConsoleBackend::rebuildStyles(const LoggerSettings& settings) {
     colorMode = settings.config.colors.colorMode;
     hideLevelTag = settings.config.display.hideLevelTag;
     hideContextTag = settings.config.display.hideContextTag;
+    colorize = settings.config.display.enableColors && isTty;
+    colorByContext = colorMode == "context";
+    format = parseLogFormat(settings.config.format.logFormat);
+    reset = colorize ? "\033[0m" : "";
+
+    levelStyles.clear();
+    for (const auto& name : settings.config.levels.levelNames) {
+        levelStyles.push_back(buildStyle(settings, name, true));
+    }
+    unknownLevel = buildStyle(settings, settings.levelName(INVALID_LEVEL_ID), true);
+
+    contextStyles.clear();
+    unknownContext = buildStyle(settings, settings.contextName(INVALID_CONTEXT_ID), false);
+    stylesGeneration = settings.generation;
+}
+
+// Contexts can be registered after setup; their style is built on first use
+const ConsoleBackend::Style& ConsoleBackend::contextStyle(ContextId context, const LoggerSettings& settings) {
+    if (context < contextStyles.size()) return contextStyles[context];
+    if (context >= settings.contextRegistry->size()) return unknownContext;
+
+    while (contextStyles.size() <= context) {
+        const auto id = static_cast<ContextId>(contextStyles.size());
+        contextStyles.push_back(buildStyle(settings, settings.contextName(id), false));
+    }
+    return contextStyles[context];
 }
 
 //------------------------------------------------------------------------------
 // Write Log Message to Console with Applied Settings
 //------------------------------------------------------------------------------
 void ConsoleBackend::write(const LogMessage& log, const LoggerSettings& settings) {
-    const char* reset = "\033[0m";
-    auto& colors = settings.config.colors;
-    auto& display = settings.config.display;
+    if (settings.generation != stylesGeneration) rebuildStyles(settings);
 
-    // ✅ Fetch the latest settings directly from LoggerSettings
-    std::string colorMode = colors.colorMode;
-    bool hideLevelTag = display.hideLevelTag;
-    bool hideContextTag = display.hideContextTag;
+    batchBuffer.clear();
+    appendLine(log, settings, batchBuffer);
+    writeOut(batchBuffer);
+}
 
-    std::string key = (colorMode == "context") ? "context_" + std::string(log.context)
-                                               : "level_" + std::string(log.level);
+//------------------------------------------------------------------------------
+// Write a Whole Batch with One Syscall
+//------------------------------------------------------------------------------
+void ConsoleBackend::writeBatch(std::span<const LogMessage> batch, const LoggerSettings& settings) {
+    if (settings.generation != stylesGeneration) rebuildStyles(settings);
 
-    std::string hexColor = colors.parsedLogColors.contains(key) ? colors.parsedLogColors.at(key) : "#FFFFFF";
-    int ansiColor = hexToAnsiColor(hexColor);
-    std::string ansiCode = "\033[" + std::to_string(ansiColor) + "m";
+    batchBuffer.clear();
+    for (const auto& log : batch) {
+        appendLine(log, settings, batchBuffer);
+    }
+    writeOut(batchBuffer);
+}
 
-    std::string levelTag = hideLevelTag ? "" : ("[" + std::string(log.level) + "] ");
-    std::string contextTag = hideContextTag ? "" : (std::string(log.context) + ": ");
+void ConsoleBackend::writeOut(const std::string& data) {
+    std::cout.flush();   // keep ordering with anything already sent through std::cout
+    const char* pos = data.data();
+    std::size_t remaining = data.size();
+    while (remaining > 0) {
+        const ssize_t written = ::write(STDOUT_FILENO, pos, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        pos += written;
+        remaining -= static_cast<std::size_t>(written);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Format One Line from the Precomputed Pieces
+//------------------------------------------------------------------------------
+void ConsoleBackend::appendLine(const LogMessage& log, const LoggerSettings& settings, std::string& out) {
+    if (format == LogFormat::Json || format == LogFormat::Logfmt) {
+        appendRecordLine(format, log.timestamp(), settings.levelName(log.level), settings.contextName(log.context),
+                         log.message, log.fields, out);
+        return;
+    }
 
-    std::cout << ansiCode << log.timestamp << " " << levelTag << contextTag << log.message << reset << "\n";
+    const Style& level = log.level < levelStyles.size() ? levelStyles[log.level] : unknownLevel;
+    const Style& context = contextStyle(log.context, settings);
+
+    out += colorByContext ? context.color : level.color;
+    out += log.timestamp();
+    out += ' ';
+    out += level.tag;
+    out += context.tag;
+    appendTerminalSafe(log.message, out);   // no raw escape sequences from message text
+    appendPlainFields(log.fields, out);
+    out += reset;
+    out += '\n';
 }
 
 //------------------------------------------------------------------------------
@@ -51,7 +51,6 @@ namespace {
 }
 
 void ConsoleBackend::setup(const LoggerSettings& settings) {
-    (void)settings;
     vtEnabled = false;
     HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
     if (hOut != INVALID_HANDLE_VALUE) {
@@ -64,6 +63,7 @@ void ConsoleBackend::setup(const LoggerSettings& settings) {
         }
     }
     isTty = _isatty(_fileno(stdout)) != 0;
+    rebuildStyles(settings);
 }
 
 void ConsoleBackend::shutdown() {
@@ -73,56 +73,107 @@ void ConsoleBackend::flush() {
     std::cout << std::flush;
 }
 
-void ConsoleBackend::write(const LogMessage& logMsg, const LoggerSettings& settings) {
-    const auto& cfg = settings.config;
+// Rendering tables: resolved once per config load, see console_backend.hpp
+string ConsoleBackend::ansiColorFor(const LoggerSettings& settings, const string& key) const {
+    if (!colorize) return {};
+    const auto& parsed = settings.config.colors.parsedLogColors;
+    const auto it = parsed.find(key);
+    return it != parsed.end() ? Ansi24(Trim(it->second)) : string{};
+}
 
-    string line;
-    if (cfg.format.enableTimestamps && !logMsg.timestamp.empty()) {
-        line += logMsg.timestamp; line += " ";
+ConsoleBackend::Style ConsoleBackend::buildStyle(const LoggerSettings& settings, std::string_view name, bool isLevel) const {
+    Style style;
+    if (isLevel != colorByContext) {
+        style.color = ansiColorFor(settings, (isLevel ? "level_" : "context_") + string(name));
+        if (style.color.empty() && colorize && isLevel) style.color = BasicAnsiFromLevel(string(name));
     }
-    if (!cfg.display.hideLevelTag) {
-        line += "["; line += logMsg.level; line += "] ";
+    if (isLevel && !hideLevelTag) {
+        style.tag = "[" + string(name) + "] ";
+    } else if (!isLevel && !hideContextTag) {
+        style.tag = string(name) + ": ";
     }
-    if (!cfg.display.hideContextTag) {
-        line += logMsg.context; line += ": ";
+    return style;
+}
+
+void ConsoleBackend::rebuildStyles(const LoggerSettings& settings) {
+    colorMode = settings.config.colors.colorMode;
+    hideLevelTag = settings.config.display.hideLevelTag;
+    hideContextTag = settings.config.display.hideContextTag;
+    colorize = settings.config.display.enableColors && vtEnabled && isTty;
+    colorByContext = colorMode == "context";
+    format = parseLogFormat(settings.config.format.logFormat);
+    reset = colorize ? "\x1b[0m" : "";
+
+    levelStyles.clear();
+    for (const auto& name : settings.config.levels.levelNames) {
+        levelStyles.push_back(buildStyle(settings, name, true));
     }
-    line += logMsg.message;
-
-    bool colorize = cfg.display.enableColors && vtEnabled;
-
-    if (colorize) {
-        string hex;
-        if (cfg.colors.colorMode == "level") {
-            auto it = cfg.levels.levelIndexMap.find(logMsg.level);
-            if (it != cfg.levels.levelIndexMap.end() && it->second < MAX_LEVELS)
-                hex = cfg.colors.logColorArray[it->second];
-            if (hex.empty() || hex == "#FFFFFFFF") {
-                auto pm = cfg.colors.parsedLogColors.find("level_" + logMsg.level);
-                if (pm != cfg.colors.parsedLogColors.end()) hex = pm->second;
-            }
-        } else if (cfg.colors.colorMode == "context") {
-            auto it = cfg.contexts.contextIndexMap.find(logMsg.context);
-            if (it != cfg.contexts.contextIndexMap.end() && it->second < MAX_CONTEXTS)
-                hex = cfg.colors.contextColorArray[it->second];
-            if (hex.empty() || hex == "#FFFFFFFF") {
-                auto pm = cfg.colors.parsedLogColors.find("context_" + logMsg.context);
-                if (pm != cfg.colors.parsedLogColors.end()) hex = pm->second;
-            }
-        }
+    unknownLevel = buildStyle(settings, settings.levelName(INVALID_LEVEL_ID), true);
 
-        string pre = Ansi24(Trim(hex));
-        if (pre.empty()) pre = BasicAnsiFromLevel(logMsg.level);
+    contextStyles.clear();
+    unknownContext = buildStyle(settings, settings.contextName(INVALID_CONTEXT_ID), false);
+    stylesGeneration = settings.generation;
+}
 
-        if (!pre.empty()) {
-            std::cout << pre << line << "\x1b[0m\n";
-        } else {
-            std::cout << line << '\n';
-        }
-    } else {
-        std::cout << line << '\n';
+const ConsoleBackend::Style& ConsoleBackend::contextStyle(ContextId context, const LoggerSettings& settings) {
+    if (context < contextStyles.size()) return contextStyles[context];
+    if (context >= settings.contextRegistry->size()) return unknownContext;
+
+    while (contextStyles.size() <= context) {
+        const auto id = static_cast<ContextId>(contextStyles.size());
+        contextStyles.push_back(buildStyle(settings, settings.contextName(id), false));
     }
+    return contextStyles[context];
+}
+
+void ConsoleBackend::write(const LogMessage& logMsg, const LoggerSettings& settings) {
+    if (settings.generation != stylesGeneration) rebuildStyles(settings);
+
+    batchBuffer.clear();
+    appendLine(logMsg, settings, batchBuffer);
+    std::cout.write(batchBuffer.data(), static_cast<std::streamsize>(batchBuffer.size()));
 
-    const string mode = Trim(cfg.general.flushMode);
+    const string mode = Trim(settings.config.general.flushMode);
     if (!(mode == "auto" || mode == "AUTO" || mode == "Auto")) std::cout << std::flush;
     assert(std::cout.good());
 }
+
+void ConsoleBackend::writeBatch(std::span<const LogMessage> batch, const LoggerSettings& settings) {
+    if (settings.generation != stylesGeneration) rebuildStyles(settings);
+
+    batchBuffer.clear();
+    for (const auto& logMsg : batch) {
+        appendLine(logMsg, settings, batchBuffer);
+    }
+    writeOut(batchBuffer);
+}
+
+// One write for the whole batch
+void ConsoleBackend::writeOut(const string& data) {
+    std::cout.write(data.data(), static_cast<std::streamsize>(data.size()));
+    std::cout << std::flush;
+    assert(std::cout.good());
+}
+
+void ConsoleBackend::appendLine(const LogMessage& logMsg, const LoggerSettings& settings, string& out) {
+    if (format == LogFormat::Json || format == LogFormat::Logfmt) {
+        appendRecordLine(format, logMsg.timestamp(), settings.levelName(logMsg.level), settings.contextName(logMsg.context),
+                         logMsg.message, logMsg.fields, out);
+        return;
+    }
+
+    const Style& level = logMsg.level < levelStyles.size() ? levelStyles[logMsg.level] : unknownLevel;
+    const Style& context = contextStyle(logMsg.context, settings);
+    const string& color = colorByContext ? context.color : level.color;
+
+    out += color;
+    if (settings.config.format.enableTimestamps && !logMsg.timestamp().empty()) {
+        out += logMsg.timestamp(); out += " ";
+    }
+    out += level.tag;
+    out += context.tag;
+    appendTerminalSafe(logMsg.message, out);   // no raw escape sequences from message text
+    appendPlainFields(logMsg.fields, out);
+    if (!color.empty()) out += reset;
+    out += '\n';
+}
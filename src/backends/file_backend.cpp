@@ -1,4 +1,83 @@
 #include "myLogger/backends/file_backend.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+    constexpr std::int64_t UTC_OFFSET_RECHECK_NS = 15LL * 60 * 1'000'000'000;
+
+    // Emergency lines: level and context are cut to MAX_NAME bytes, and
+    // escaping grows a byte to at most ESCAPE_GROWTH bytes ("\u001f")
+    constexpr std::size_t EMERGENCY_LINE_CAPACITY = 64 * 1024;
+    constexpr std::size_t MAX_NAME = 256;
+    constexpr std::size_t ESCAPE_GROWTH = 6;
+    constexpr std::size_t EMERGENCY_TEXT_ROOM =
+        EMERGENCY_LINE_CAPACITY - ESCAPE_GROWTH * (2 * MAX_NAME + MAX_TIMESTAMP_LENGTH) - 64;
+
+    const LogFields NO_FIELDS;
+
+    // At most `size` bytes of `text`, not ending inside a UTF-8 sequence
+    std::string_view cutText(std::string_view text, std::size_t size) {
+        if (text.size() <= size) return text;
+        while (size > 0 && (static_cast<unsigned char>(text[size]) & 0xC0) == 0x80) --size;
+        return text.substr(0, size);
+    }
+
+    int openAppend(const std::string& path) {
+#if defined(_WIN32)
+        return ::_open(path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        return ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+#endif
+    }
+
+    // Writes all of `data`, retrying short writes and EINTR
+    bool writeAll(int fd, const char* data, std::size_t size) {
+        while (size > 0) {
+#if defined(_WIN32)
+            const int written = ::_write(fd, data, static_cast<unsigned>(size));
+#else
+            const ssize_t written = ::write(fd, data, size);
+#endif
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+
+    void syncToDisk(int fd) {
+#if defined(_WIN32)
+        ::_commit(fd);
+#elif defined(__APPLE__)
+        ::fsync(fd);
+#else
+        ::fdatasync(fd);
+#endif
+    }
+
+    void closeFile(int fd) {
+#if defined(_WIN32)
+        ::_close(fd);
+#else
+        ::close(fd);
+#endif
+    }
+
+} // namespace
 
 //------------------------------------------------------------------------------
 // Generate a Log Filename Based on the Config Format
@@ -11,47 +90,271 @@ std::string FileBackend::resolveFilename(const std::string& format) {
     return filename.str();
 }
 
+//------------------------------------------------------------------------------
+// Resolve the Log File Path
+//------------------------------------------------------------------------------
+std::string FileBackend::prepareLogFilePath(const LoggerSettings& settings) {
+    std::filesystem::path logDir = settings.config.general.logDirectory;
+    if (!std::filesystem::exists(logDir)) {
+        std::filesystem::create_directories(logDir);
+    }
+
+    return settings.config.general.logDirectory + "/" + resolveFilename(settings.config.general.logFilenameFormat);
+}
+
 //------------------------------------------------------------------------------
 // Setup File Logging
 //------------------------------------------------------------------------------
 void FileBackend::setup(const LoggerSettings& settings) {
     if (settings.config.backends.enableFile) {
-        std::filesystem::path logDir = settings.config.general.logDirectory;
-        if (!std::filesystem::exists(logDir)) {
-            std::filesystem::create_directories(logDir);
-        }
+        shutdown();   // a repeated setup() starts over on the new file
 
-        logFilePath = settings.config.general.logDirectory + "/" + resolveFilename(settings.config.general.logFilenameFormat);
-
-        std::ofstream testFile(logFilePath, std::ios::app);
-        if (!testFile) {
+        format = parseLogFormat(settings.config.format.logFormat);
+        logFilePath = prepareLogFilePath(settings);
+        openFile(settings);
+        if (fd < 0) {
             throw std::runtime_error("[FileBackend] Failed to open log file: " + logFilePath);
         }
+
+        bufferCapacity = static_cast<std::size_t>(std::max(settings.config.general.fileBufferSize, 0));
+        buffer.reserve(bufferCapacity);
+        emergencyLine.reserve(EMERGENCY_LINE_CAPACITY);
+        escapeKernel();   // picked now, not first in a signal handler
+
+        const std::int64_t now = currentTimeNs();
+        refreshUtcOffset(now);
+        rotator.configure(settings, logFilePath, now);
+    }
+}
+
+// The fatal-signal path cannot call localtime_r; the record timestamps
+// re-check the offset the same way (see timestamp_formatter.hpp)
+void FileBackend::refreshUtcOffset(std::int64_t timeNs) {
+    utcOffset.store(localUtcOffset(timeNs), std::memory_order_relaxed);
+    utcOffsetCheckNs = timeNs + UTC_OFFSET_RECHECK_NS;
+}
+
+// Opens `logFilePath` for appending; a binary log gets its header (new file)
+// and a fresh session, since encoder state does not carry across files.
+void FileBackend::openFile(const LoggerSettings& settings) {
+    fd = openAppend(logFilePath);
+    if (fd < 0) return;
+
+    std::error_code ec;
+    const auto existing = std::filesystem::file_size(logFilePath, ec);
+    fileSize = ec ? 0 : static_cast<std::uint64_t>(existing);
+
+    if (format == LogFormat::Binary) {
+        if (fileSize == 0) BinaryLogEncoder::appendFileHeader(buffer);
+        encoder.beginSession(settings, buffer);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Rotate: finish the old file and open the next one
+//------------------------------------------------------------------------------
+void FileBackend::rotate(std::int64_t timeNs, const LoggerSettings& settings) {
+    writeBuffer();
+    closeFile(fd);
+
+    const std::string closedPath = logFilePath;
+    logFilePath = rotator.nextPath(prepareLogFilePath(settings));
+    openFile(settings);
+    if (fd < 0) {
+        std::cerr << "[FileBackend] Failed to open rotated log file: " << logFilePath << ", retrying\n";
+        reopenPending = true;
+    }
+    rotator.retire(closedPath, logFilePath, timeNs);
+}
+
+// True when the file is open, retrying a failed rotation first; otherwise
+// the `records` about to be written are counted as lost
+bool FileBackend::ensureOpen(std::size_t records, const LoggerSettings& settings) {
+    if (fd >= 0) return true;
+    if (!reopenPending) return false;   // file logging is off or shut down
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(logFilePath).parent_path(), ec);
+    openFile(settings);
+    if (fd < 0) {
+        lostMessages += records;
+        return false;
     }
+    reopenPending = false;
+    std::cerr << "[FileBackend] Reopened log file: " << logFilePath << " (" << lostMessages
+              << " messages lost so far)\n";
+    return true;
+}
+
+// The rotation inside appendRecord() failed: drop what is buffered for it
+void FileBackend::loseBuffered(std::size_t records) {
+    buffer.clear();
+    lostMessages += records;
 }
 
 //------------------------------------------------------------------------------
 // Write Log Message to File
 //------------------------------------------------------------------------------
-void FileBackend::write(const LogMessage& log, [[maybe_unused]] const LoggerSettings& settings) {
-    std::ofstream logFile(logFilePath, std::ios::app);
-    if (logFile.is_open()) {
-        logFile << log.timestamp << " [" << log.level << "] " << log.context << ": " << log.message << "\n";
+void FileBackend::write(const LogMessage& log, const LoggerSettings& settings) {
+    if (!ensureOpen(1, settings)) return;
+
+    appendRecord(log, settings);
+    if (fd < 0) {
+        loseBuffered(1);
+        return;
+    }
+
+    if (settings.config.general.flushMode == "instant") {
+        writeBuffer();
+        syncToDisk(fd);
+    } else if (buffer.size() >= bufferCapacity) {
+        writeBuffer();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Write a Whole Batch with One Syscall
+//------------------------------------------------------------------------------
+void FileBackend::writeBatch(std::span<const LogMessage> batch, const LoggerSettings& settings) {
+    if (!ensureOpen(batch.size(), settings)) return;
 
-        if (settings.config.general.flushMode == "instant") {
-            logFile.flush();
+    if (settings.config.general.flushMode == "instant") {
+        for (const auto& log : batch) {
+            write(log, settings);
         }
+        return;
+    }
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        appendRecord(batch[i], settings);
+        if (fd < 0) {
+            loseBuffered(batch.size() - i);
+            return;
+        }
+        if (buffer.size() >= bufferCapacity) {
+            writeBuffer();
+        }
+    }
+    writeBuffer();
+}
+
+//------------------------------------------------------------------------------
+// Buffer One Record, Rotating First if It Belongs in the Next File
+//------------------------------------------------------------------------------
+void FileBackend::appendRecord(const LogMessage& log, const LoggerSettings& settings) {
+    if (log.timeNs >= utcOffsetCheckNs) refreshUtcOffset(log.timeNs);
+
+    const std::size_t start = buffer.size();
+    encodeRecord(log, settings);
+    if (rotator.due(fileSize + start, buffer.size() - start, log.timeNs)) {
+        // Encode again in the new file; binary records depend on per-file state
+        buffer.resize(start);
+        rotate(log.timeNs, settings);
+        encodeRecord(log, settings);
+    }
+}
+
+void FileBackend::encodeRecord(const LogMessage& log, const LoggerSettings& settings) {
+    if (format == LogFormat::Binary) {
+        encoder.append(log, settings, buffer);
+    } else {
+        appendText(log, settings, format, buffer);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Format One Line into the Buffer
+//------------------------------------------------------------------------------
+void FileBackend::appendLine(const LogMessage& log, const LoggerSettings& settings, std::string& out) {
+    appendText(log, settings, LogFormat::Plain, out);
+}
+
+void FileBackend::appendText(const LogMessage& log, const LoggerSettings& settings, LogFormat format, std::string& out) {
+    appendRecordLine(format, log.timestamp(), settings.levelName(log.level), settings.contextName(log.context),
+                     log.message, log.fields, out);
+}
+
+//------------------------------------------------------------------------------
+// Write Buffered Lines (one syscall, short writes aside)
+//------------------------------------------------------------------------------
+void FileBackend::writeBuffer() {
+    writeRange(buffer.data(), buffer.size());
+    buffer.clear();
+}
+
+void FileBackend::writeRange(const char* data, std::size_t size) {
+    if (size == 0 || fd < 0) return;
 
-        logFile.close();
+    if (!writeAll(fd, data, size)) {
+        std::cerr << "[FileBackend] Failed to write log file: " << logFilePath << "\n";
+        return;   // size-based rotation counts only what reached the file
     }
+    fileSize += size;
+}
+
+//------------------------------------------------------------------------------
+// Flush
+//------------------------------------------------------------------------------
+void FileBackend::flush() {
+    writeBuffer();
 }
 
 //------------------------------------------------------------------------------
-// Flush (No-op for file backend)
+// Shutdown
 //------------------------------------------------------------------------------
-void FileBackend::flush() {}
+void FileBackend::shutdown() {
+    if (fd >= 0) {
+        writeBuffer();
+        closeFile(fd);
+        fd = -1;
+    }
+    reopenPending = false;
+    rotator.shutdown();
+}
 
 //------------------------------------------------------------------------------
-// Shutdown (No-op for file backend)
+// Fatal-Signal Path: write() on the open descriptor, no allocation or locks
 //------------------------------------------------------------------------------
-void FileBackend::shutdown() {}
+void FileBackend::emergencyFlush() {
+    if (fd < 0) return;
+    if (writeAll(fd, buffer.data(), buffer.size())) fileSize += buffer.size();
+    buffer.clear();
+}
+
+void FileBackend::emergencyWrite(std::int64_t timeNs, std::string_view level, std::string_view context,
+                                 std::string_view text, const LoggerSettings& settings) {
+    if (fd < 0 || format == LogFormat::Binary) return;
+
+    char stamp[MAX_TIMESTAMP_LENGTH];
+    std::size_t stampLength = 0;
+    if (settings.config.format.enableTimestamps) {
+        stampLength = formatTimestampAtOffset(timeNs, utcOffset.load(std::memory_order_relaxed),
+                                              settings.config.format.timestampFormat, stamp, sizeof(stamp));
+    }
+    const std::string_view timestamp(stamp, stampLength);
+    level = cutText(level, MAX_NAME);
+    context = cutText(context, MAX_NAME);
+
+    // Only the one thread running the crash handler gets here, and the
+    // reserved line buffer is never outgrown, so nothing is allocated
+    emergencyLine.clear();
+    if (format == LogFormat::Plain && text.size() > EMERGENCY_TEXT_ROOM) {
+        // Plain text is not escaped and can go out in three writes
+        appendRecordLine(format, timestamp, level, context, {}, NO_FIELDS, emergencyLine);
+        emergencyLine.pop_back();
+        writeAll(fd, emergencyLine.data(), emergencyLine.size());
+        writeAll(fd, text.data(), text.size());
+        writeAll(fd, "\n", 1);
+        fileSize += emergencyLine.size() + text.size() + 1;
+        return;
+    }
+
+    const std::size_t room = format == LogFormat::Plain ? EMERGENCY_TEXT_ROOM : EMERGENCY_TEXT_ROOM / ESCAPE_GROWTH;
+    appendRecordLine(format, timestamp, level, context, cutText(text, room), NO_FIELDS, emergencyLine);
+    writeAll(fd, emergencyLine.data(), emergencyLine.size());
+    fileSize += emergencyLine.size();
+}
+
+FileBackend::~FileBackend() {
+    shutdown();
+}
@@ -0,0 +1,233 @@
+#include "myLogger/backends/mmap_file_backend.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MYLOGGER_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    // "logs/app.txt" + 2 -> "logs/app.2.txt"
+    std::string segmentName(const std::string& basePath, int index) {
+        if (index == 0) return basePath;
+        const std::filesystem::path path(basePath);
+        auto name = path.parent_path() / path.stem();
+        return name.string() + "." + std::to_string(index) + path.extension().string();
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Setup
+//------------------------------------------------------------------------------
+void MmapFileBackend::setup(const LoggerSettings& settings) {
+    shutdown();   // a repeated setup() starts over on the new file
+    if (!settings.config.backends.enableFile) return;
+
+    const auto& general = settings.config.general;
+    segmentSize = static_cast<std::size_t>(std::max<std::int64_t>(general.mmapSegmentSize, 4096));
+    syncPolicy = general.mmapMsync == "sync"  ? SyncPolicy::Sync
+               : general.mmapMsync == "async" ? SyncPolicy::Async
+                                              : SyncPolicy::None;
+
+    format = parseLogFormat(settings.config.format.logFormat);
+    if (format == LogFormat::Binary) {
+        throw std::runtime_error("[MmapFileBackend] log_format = \"binary\" is not supported; "
+                                 "use FileBackend or UringFileBackend");
+    }
+    basePath = FileBackend::prepareLogFilePath(settings);
+
+    // Carry on in the newest segment an earlier run left behind
+    segmentIndex = 0;
+    while (std::filesystem::exists(segmentName(basePath, segmentIndex + 1))) {
+        ++segmentIndex;
+    }
+    mapped = openSegment(segmentSize);
+    if (!mapped) {
+        std::cerr << "[MmapFileBackend] Cannot map " << basePath << ", using buffered write(2)\n";
+        fallback.setup(settings);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Write Log Message
+//------------------------------------------------------------------------------
+void MmapFileBackend::write(const LogMessage& log, const LoggerSettings& settings) {
+    if (!mapped) {
+        fallback.write(log, settings);
+        return;
+    }
+
+    append(log, settings);
+    if (settings.config.general.flushMode == "instant") {
+        syncRange(true);
+    }
+}
+
+void MmapFileBackend::writeBatch(std::span<const LogMessage> batch, const LoggerSettings& settings) {
+    if (!mapped) {
+        fallback.writeBatch(batch, settings);
+        return;
+    }
+
+    const bool instant = settings.config.general.flushMode == "instant";
+    for (const auto& log : batch) {
+        append(log, settings);
+        if (instant) syncRange(true);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Flush: apply the msync policy to what was written since the last flush
+//------------------------------------------------------------------------------
+void MmapFileBackend::flush() {
+    if (!mapped) {
+        fallback.flush();
+        return;
+    }
+
+    if (syncPolicy != SyncPolicy::None) {
+        syncRange(syncPolicy == SyncPolicy::Sync);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Shutdown
+//------------------------------------------------------------------------------
+void MmapFileBackend::shutdown() {
+    if (mapped) {
+        closeSegment();
+        mapped = false;
+    }
+    fallback.shutdown();
+}
+
+MmapFileBackend::~MmapFileBackend() {
+    shutdown();
+}
+
+//------------------------------------------------------------------------------
+// Copy One Record into the Mapping, Rolling the Segment When Full
+//------------------------------------------------------------------------------
+void MmapFileBackend::append(const LogMessage& log, const LoggerSettings& settings) {
+    line.clear();
+    FileBackend::appendText(log, settings, format, line);
+
+    if (writePos + line.size() > mappedSize) {
+        closeSegment();
+        ++segmentIndex;
+        if (!openSegment(std::max(segmentSize, line.size()))) {
+            std::cerr << "[MmapFileBackend] Failed to open segment " << segmentName(basePath, segmentIndex) << "\n";
+            return;
+        }
+    }
+
+    std::memcpy(mapping + writePos, line.data(), line.size());
+    writePos += line.size();
+}
+
+#if defined(MYLOGGER_HAS_MMAP)
+
+namespace {
+
+    bool truncateTo(int fd, std::size_t size) {
+        return ftruncate(fd, static_cast<off_t>(size)) == 0;
+    }
+
+    // Length of the file without its trailing NUL bytes. A segment that was
+    // not closed (crash, kill) still has its zero-filled, preallocated tail;
+    // records end in '\n', so the scan stops at the last one.
+    std::size_t usedLength(int fd, std::size_t size) {
+        char chunk[64 * 1024];
+        while (size > 0) {
+            const std::size_t length = std::min(size, sizeof(chunk));
+            const ssize_t got = pread(fd, chunk, length, static_cast<off_t>(size - length));
+            if (got != static_cast<ssize_t>(length)) break;   // keep what we know
+            for (std::size_t i = length; i > 0; --i) {
+                if (chunk[i - 1] != '\0') return size - length + i;
+            }
+            size -= length;
+        }
+        return size;
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Segment Lifecycle
+//------------------------------------------------------------------------------
+bool MmapFileBackend::openSegment(std::size_t minSize) {
+    currentPath = segmentName(basePath, segmentIndex);
+    fd = open(currentPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+
+    // Continue after whatever an earlier run left in the file
+    const off_t existing = lseek(fd, 0, SEEK_END);
+    writePos = existing > 0 ? usedLength(fd, static_cast<std::size_t>(existing)) : 0;
+    mappedSize = std::max(minSize, writePos + minSize);
+
+#if defined(__linux__)
+    const bool reserved = fallocate(fd, 0, 0, static_cast<off_t>(mappedSize)) == 0;
+#else
+    const bool reserved = false;
+#endif
+    if (!reserved && ftruncate(fd, static_cast<off_t>(mappedSize)) != 0) {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+
+    void* addr = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        truncateTo(fd, writePos);
+        close(fd);
+        fd = -1;
+        return false;
+    }
+
+    mapping = static_cast<char*>(addr);
+    syncedPos = writePos;
+    return true;
+}
+
+void MmapFileBackend::closeSegment() {
+    if (fd < 0) return;
+
+    if (syncPolicy != SyncPolicy::None) {
+        syncRange(syncPolicy == SyncPolicy::Sync);
+    }
+    munmap(mapping, mappedSize);
+    mapping = nullptr;
+
+    // Drop the preallocated tail so readers see the real length
+    if (!truncateTo(fd, writePos)) {
+        std::cerr << "[MmapFileBackend] Failed to truncate " << currentPath << "\n";
+    }
+    close(fd);
+    fd = -1;
+    mappedSize = writePos = syncedPos = 0;
+}
+
+void MmapFileBackend::syncRange(bool wait) {
+    if (!mapping || syncedPos >= writePos) return;
+
+    // msync() wants a page-aligned start
+    const auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const std::size_t start = syncedPos & ~(pageSize - 1);
+    msync(mapping + start, writePos - start, wait ? MS_SYNC : MS_ASYNC);
+    syncedPos = writePos;
+}
+
+#else // !MYLOGGER_HAS_MMAP
+
+bool MmapFileBackend::openSegment(std::size_t) { return false; }
+void MmapFileBackend::closeSegment() {}
+void MmapFileBackend::syncRange(bool) {}
+
+#endif // MYLOGGER_HAS_MMAP
@@ -0,0 +1,119 @@
+#include "myLogger/backends/shm_ring_backend.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+    // Tells apart the rings of several loggers in one process
+    std::atomic<int> ringSequence{0};
+
+    int processId() {
+#if defined(_WIN32)
+        return ::_getpid();
+#else
+        return static_cast<int>(::getpid());
+#endif
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Setup
+//------------------------------------------------------------------------------
+void ShmRingBackend::setup(const LoggerSettings& settings) {
+    shutdown();   // a repeated setup() starts over on a new ring
+    if (!settings.config.backends.enableFile) return;
+
+    const auto& general = settings.config.general;
+    name = "/" + general.shmRingName + "." + std::to_string(processId()) + "." + std::to_string(ringSequence.fetch_add(1));
+    if (!ring.create(name, static_cast<std::size_t>(std::max<std::int64_t>(general.shmRingSize, 0)))) {
+        std::cerr << "[ShmRingBackend] Cannot create shared memory ring " << name << ", writing a log file instead\n";
+        name.clear();
+        fallback.setup(settings);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Write Log Message
+//------------------------------------------------------------------------------
+void ShmRingBackend::write(const LogMessage& log, const LoggerSettings& settings) {
+    if (!ring.isOpen()) {
+        fallback.write(log, settings);
+        return;
+    }
+
+    append(log, settings);
+    ring.publish();
+}
+
+void ShmRingBackend::writeBatch(std::span<const LogMessage> batch, const LoggerSettings& settings) {
+    if (!ring.isOpen()) {
+        fallback.writeBatch(batch, settings);
+        return;
+    }
+
+    for (const auto& log : batch) {
+        append(log, settings);
+    }
+    ring.publish();
+}
+
+// Records carry text only; structured fields travel as a plain " key=value" suffix
+void ShmRingBackend::append(const LogMessage& log, const LoggerSettings& settings) {
+    std::string_view text = log.message;
+    if (!log.fields.empty()) {
+        scratch.assign(text);
+        appendPlainFields(log.fields, scratch);
+        text = scratch;
+    }
+    if (!ring.tryWrite(log.timeNs, settings.levelName(log.level), settings.contextName(log.context), text)) {
+        ring.countDropped(1);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Flush: records are published per batch already
+//------------------------------------------------------------------------------
+void ShmRingBackend::flush() {
+    if (!ring.isOpen()) fallback.flush();
+}
+
+//------------------------------------------------------------------------------
+// Shutdown: the collector drains what is left and removes the segment
+//------------------------------------------------------------------------------
+void ShmRingBackend::shutdown() {
+    ring.close(true);
+    name.clear();
+    fallback.shutdown();
+}
+
+ShmRingBackend::~ShmRingBackend() {
+    shutdown();
+}
+
+//------------------------------------------------------------------------------
+// Fatal-Signal Path
+//------------------------------------------------------------------------------
+void ShmRingBackend::emergencyFlush() {
+    if (!ring.isOpen()) fallback.emergencyFlush();
+}
+
+void ShmRingBackend::emergencyWrite(std::int64_t timeNs, std::string_view level, std::string_view context,
+                                    std::string_view text, const LoggerSettings& settings) {
+    if (!ring.isOpen()) {
+        fallback.emergencyWrite(timeNs, level, context, text, settings);
+        return;
+    }
+
+    if (!ring.tryWrite(timeNs, level, context, text)) {
+        ring.countDropped(1);
+    }
+    ring.publish();
+}
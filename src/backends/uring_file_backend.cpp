@@ -0,0 +1,436 @@
+#include "myLogger/backends/uring_file_backend.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define MYLOGGER_HAS_IO_URING 1
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#if defined(MYLOGGER_HAS_IO_URING)
+
+//------------------------------------------------------------------------------
+// Ring Mappings
+//------------------------------------------------------------------------------
+struct UringFileBackend::Ring {
+    int ringFd = -1;
+    bool fixedBuffers = false;
+
+    void* sqPtr = MAP_FAILED;
+    std::size_t sqSize = 0;
+    void* cqPtr = MAP_FAILED;
+    std::size_t cqSize = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    std::size_t sqesSize = 0;
+
+    unsigned* sqTail = nullptr;
+    unsigned* sqMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqMask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+    ~Ring() {
+        if (sqes != MAP_FAILED) munmap(sqes, sqesSize);
+        if (cqPtr != MAP_FAILED && cqPtr != sqPtr) munmap(cqPtr, cqSize);
+        if (sqPtr != MAP_FAILED) munmap(sqPtr, sqSize);
+        if (ringFd >= 0) close(ringFd);
+    }
+};
+
+namespace {
+
+    int uringEnter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+        int result;
+        do {
+            result = static_cast<int>(syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+        } while (result < 0 && errno == EINTR);
+        return result;
+    }
+
+    template <typename T>
+    T* ringField(void* base, unsigned offset) {
+        return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Log File (no O_APPEND: every write carries its own offset)
+//------------------------------------------------------------------------------
+bool UringFileBackend::openLogFile() {
+    fd = open(logFilePath.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+
+    const off_t end = lseek(fd, 0, SEEK_END);
+    fileOffset = end > 0 ? static_cast<std::uint64_t>(end) : 0;
+    return true;
+}
+
+void UringFileBackend::closeLogFile() {
+    if (fd >= 0) close(fd);
+    fd = -1;
+}
+
+void UringFileBackend::syncLogFile() {
+    fdatasync(fd);
+}
+
+//------------------------------------------------------------------------------
+// Create the Ring and Register the Buffer Pool
+//------------------------------------------------------------------------------
+bool UringFileBackend::initRing() {
+    auto r = std::make_unique<Ring>();
+
+    io_uring_params params{};
+    r->ringFd = static_cast<int>(syscall(__NR_io_uring_setup, URING_BUFFER_COUNT * 2, &params));
+    if (r->ringFd < 0) return false;
+
+    r->sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    r->cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) {
+        r->sqSize = r->cqSize = std::max(r->sqSize, r->cqSize);
+    }
+
+    r->sqPtr = mmap(nullptr, r->sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->ringFd, IORING_OFF_SQ_RING);
+    if (r->sqPtr == MAP_FAILED) return false;
+
+    r->cqPtr = singleMmap ? r->sqPtr
+                          : mmap(nullptr, r->cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                 r->ringFd, IORING_OFF_CQ_RING);
+    if (r->cqPtr == MAP_FAILED) return false;
+
+    r->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    r->sqes = static_cast<io_uring_sqe*>(mmap(nullptr, r->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                              r->ringFd, IORING_OFF_SQES));
+    if (r->sqes == MAP_FAILED) return false;
+
+    r->sqTail  = ringField<unsigned>(r->sqPtr, params.sq_off.tail);
+    r->sqMask  = ringField<unsigned>(r->sqPtr, params.sq_off.ring_mask);
+    r->sqArray = ringField<unsigned>(r->sqPtr, params.sq_off.array);
+    r->cqHead  = ringField<unsigned>(r->cqPtr, params.cq_off.head);
+    r->cqTail  = ringField<unsigned>(r->cqPtr, params.cq_off.tail);
+    r->cqMask  = ringField<unsigned>(r->cqPtr, params.cq_off.ring_mask);
+    r->cqes    = ringField<io_uring_cqe>(r->cqPtr, params.cq_off.cqes);
+
+    // Registered buffers skip the per-write page pinning; plain writes still work without them
+    std::vector<iovec> iovecs;
+    for (auto& buffer : buffers) {
+        iovecs.push_back({buffer.data.get(), bufferCapacity});
+    }
+    r->fixedBuffers = syscall(__NR_io_uring_register, r->ringFd, IORING_REGISTER_BUFFERS,
+                              iovecs.data(), static_cast<unsigned>(iovecs.size())) == 0;
+
+    ring = std::move(r);
+    return true;
+}
+
+void UringFileBackend::closeRing() {
+    ring.reset();   // unmapping and closing the ring fd also drops the registered buffers
+}
+
+//------------------------------------------------------------------------------
+// Submit the Current Buffer (does not wait)
+//------------------------------------------------------------------------------
+void UringFileBackend::submitCurrent() {
+    Buffer& buffer = buffers[current];
+    if (buffer.size == 0) return;
+
+    if (ringFailed) {
+        writeAt(buffer.data.get(), buffer.size, fileOffset);
+        fileOffset += buffer.size;
+        buffer.size = 0;
+        return;
+    }
+
+    const unsigned tail = *ring->sqTail;
+    const unsigned index = tail & *ring->sqMask;
+    io_uring_sqe* sqe = &ring->sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = ring->fixedBuffers ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<std::uint64_t>(buffer.data.get());
+    sqe->len = static_cast<std::uint32_t>(buffer.size);
+    sqe->off = fileOffset;
+    buffer.offset = fileOffset;
+    sqe->buf_index = static_cast<std::uint16_t>(current);
+    sqe->user_data = current;
+    ring->sqArray[index] = index;
+    std::atomic_ref<unsigned>(*ring->sqTail).store(tail + 1, std::memory_order_release);
+
+    fileOffset += buffer.size;
+    buffer.inFlight = true;
+    ++inFlight;
+
+    if (uringEnter(ring->ringFd, 1, 0, 0) < 0) {
+        std::cerr << "[UringFileBackend] io_uring_enter failed: " << std::strerror(errno)
+                  << "; continuing with synchronous writes\n";
+        abandonRing();
+        return;
+    }
+
+    // Format the next batch into a buffer the kernel is not using
+    for (std::size_t i = 1; i <= buffers.size(); ++i) {
+        const std::size_t next = (current + i) % buffers.size();
+        if (!buffers[next].inFlight) {
+            current = next;
+            return;
+        }
+    }
+
+    // Whole pool in flight: this is the only place the consumer waits on the disk
+    reapCompletions(1);
+    for (std::size_t i = 0; i < buffers.size(); ++i) {
+        if (!buffers[i].inFlight) {
+            current = i;
+            return;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Reap Completions
+//------------------------------------------------------------------------------
+void UringFileBackend::reapCompletions(unsigned minComplete) {
+    if (ringFailed) return;
+
+    unsigned reaped = 0;
+    for (;;) {
+        unsigned head = *ring->cqHead;
+        const unsigned tail = std::atomic_ref<unsigned>(*ring->cqTail).load(std::memory_order_acquire);
+
+        while (head != tail) {
+            const io_uring_cqe& cqe = ring->cqes[head & *ring->cqMask];
+            Buffer& buffer = buffers[cqe.user_data];
+
+            if (cqe.res < 0) {
+                std::cerr << "[UringFileBackend] Write failed: " << std::strerror(-cqe.res) << "\n";
+            } else if (static_cast<std::size_t>(cqe.res) < buffer.size) {
+                // Short write: finish the rest synchronously at its own offset
+                const auto done = static_cast<std::size_t>(cqe.res);
+                writeAt(buffer.data.get() + done, buffer.size - done, buffer.offset + done);
+            }
+
+            buffer.size = 0;
+            buffer.inFlight = false;
+            --inFlight;
+            ++head;
+            ++reaped;
+        }
+        std::atomic_ref<unsigned>(*ring->cqHead).store(head, std::memory_order_release);
+
+        if (reaped >= minComplete || inFlight == 0) return;
+        if (uringEnter(ring->ringFd, 0, 1, IORING_ENTER_GETEVENTS) < 0) {
+            std::cerr << "[UringFileBackend] Waiting for completions failed: " << std::strerror(errno)
+                      << "; continuing with synchronous writes\n";
+            abandonRing();
+            return;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Abandon the Ring (io_uring_enter failed)
+//------------------------------------------------------------------------------
+// Whether the kernel took a submitted write or not is unknown, so every
+// in-flight buffer is written again at its own offset. The bytes are the
+// same, so a late kernel write is harmless as long as the buffer is never
+// reused: it is retired and replaced. inFlight drops to 0, so waitAll()
+// returns and nothing is submitted to the ring again.
+void UringFileBackend::abandonRing() {
+    for (auto& buffer : buffers) {
+        if (!buffer.inFlight) continue;
+        writeAt(buffer.data.get(), buffer.size, buffer.offset);
+        retired.push_back(std::move(buffer.data));
+        buffer.data = std::make_unique<char[]>(bufferCapacity);
+        buffer.size = 0;
+        buffer.inFlight = false;
+    }
+    inFlight = 0;
+    ringFailed = true;
+}
+
+void UringFileBackend::writeAt(const char* data, std::size_t size, std::uint64_t offset) {
+    while (size > 0) {
+        const ssize_t written = pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "[UringFileBackend] Write failed: " << std::strerror(errno) << "\n";
+            return;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+        offset += static_cast<std::uint64_t>(written);
+    }
+}
+
+#else // !MYLOGGER_HAS_IO_URING
+
+struct UringFileBackend::Ring {};
+
+bool UringFileBackend::openLogFile() { return false; }
+void UringFileBackend::closeLogFile() {}
+void UringFileBackend::syncLogFile() {}
+bool UringFileBackend::initRing() { return false; }
+void UringFileBackend::closeRing() {}
+void UringFileBackend::submitCurrent() {}
+void UringFileBackend::reapCompletions(unsigned) {}
+void UringFileBackend::writeAt(const char*, std::size_t, std::uint64_t) {}
+void UringFileBackend::abandonRing() {}
+
+#endif // MYLOGGER_HAS_IO_URING
+
+//------------------------------------------------------------------------------
+// Constructor / Destructor
+//------------------------------------------------------------------------------
+UringFileBackend::UringFileBackend() = default;
+
+UringFileBackend::~UringFileBackend() {
+    shutdown();
+}
+
+//------------------------------------------------------------------------------
+// Setup
+//------------------------------------------------------------------------------
+void UringFileBackend::setup(const LoggerSettings& settings) {
+    shutdown();   // a repeated setup() starts over on the new file
+    if (!settings.config.backends.enableFile) return;
+
+    format = parseLogFormat(settings.config.format.logFormat);
+    bufferCapacity = static_cast<std::size_t>(std::max(settings.config.general.fileBufferSize, 4096));
+    buffers.resize(URING_BUFFER_COUNT);
+    for (auto& buffer : buffers) {
+        buffer.data = std::make_unique<char[]>(bufferCapacity);
+    }
+    current = 0;
+    inFlight = 0;
+    ringFailed = false;
+
+    logFilePath = FileBackend::prepareLogFilePath(settings);
+    if (openLogFile() && initRing()) {
+        if (format == LogFormat::Binary) {
+            line.clear();
+            if (fileOffset == 0) BinaryLogEncoder::appendFileHeader(line);
+            encoder.beginSession(settings, line);
+            appendLine();
+        }
+        return;
+    }
+
+    closeLogFile();
+    buffers.clear();
+    std::cerr << "[UringFileBackend] io_uring unavailable, using buffered write(2)\n";
+    fallback.setup(settings);
+}
+
+//------------------------------------------------------------------------------
+// Write Log Message
+//------------------------------------------------------------------------------
+void UringFileBackend::write(const LogMessage& log, const LoggerSettings& settings) {
+    if (!ring) {
+        fallback.write(log, settings);
+        return;
+    }
+
+    append(log, settings);
+    if (settings.config.general.flushMode == "instant") {
+        submitCurrent();
+        waitAll();
+        syncLogFile();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Write a Whole Batch (one submission)
+//------------------------------------------------------------------------------
+void UringFileBackend::writeBatch(std::span<const LogMessage> batch, const LoggerSettings& settings) {
+    if (!ring) {
+        fallback.writeBatch(batch, settings);
+        return;
+    }
+
+    if (settings.config.general.flushMode == "instant") {
+        for (const auto& log : batch) {
+            write(log, settings);
+        }
+        return;
+    }
+
+    for (const auto& log : batch) {
+        append(log, settings);
+    }
+    submitCurrent();
+    reapCompletions(0);
+}
+
+//------------------------------------------------------------------------------
+// Copy One Formatted Record into the Current Buffer
+//------------------------------------------------------------------------------
+void UringFileBackend::append(const LogMessage& log, const LoggerSettings& settings) {
+    line.clear();
+    if (format == LogFormat::Binary) {
+        encoder.append(log, settings, line);
+    } else {
+        FileBackend::appendText(log, settings, format, line);
+    }
+    appendLine();
+}
+
+void UringFileBackend::appendLine() {
+    if (buffers[current].size + line.size() > bufferCapacity) {
+        submitCurrent();
+    }
+
+    if (line.size() > bufferCapacity) {
+        // Larger than a whole buffer: claim its range and write it directly
+        writeAt(line.data(), line.size(), fileOffset);
+        fileOffset += line.size();
+        return;
+    }
+
+    Buffer& buffer = buffers[current];
+    std::memcpy(buffer.data.get() + buffer.size, line.data(), line.size());
+    buffer.size += line.size();
+}
+
+//------------------------------------------------------------------------------
+// Flush: submit what is buffered; completion is reaped later
+//------------------------------------------------------------------------------
+void UringFileBackend::flush() {
+    if (!ring) {
+        fallback.flush();
+        return;
+    }
+    submitCurrent();
+}
+
+void UringFileBackend::waitAll() {
+    while (inFlight > 0) {
+        reapCompletions(1);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Shutdown
+//------------------------------------------------------------------------------
+void UringFileBackend::shutdown() {
+    if (ring) {
+        submitCurrent();
+        waitAll();
+        closeRing();
+        closeLogFile();
+        buffers.clear();
+        retired.clear();
+    }
+    fallback.shutdown();
+}
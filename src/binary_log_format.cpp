@@ -0,0 +1,314 @@
+#include "myLogger/binary_log_format.hpp"
+#include "myLogger/timestamp_formatter.hpp"
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <unordered_map>
+
+namespace {
+
+    //--------------------------------------------------------------------------
+    // LEB128 varints
+    //--------------------------------------------------------------------------
+    std::size_t varintSize(std::uint64_t value) {
+        std::size_t size = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            ++size;
+        }
+        return size;
+    }
+
+    void appendVarint(std::string& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out += static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+
+    std::uint64_t zigzag(std::int64_t value) {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    std::int64_t unzigzag(std::uint64_t value) {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    void appendDefinition(std::string& out, BinaryRecordType type, std::uint64_t id, std::string_view name) {
+        appendVarint(out, 1 + varintSize(id) + name.size());
+        out += static_cast<char>(type);
+        appendVarint(out, id);
+        out += name;
+    }
+
+    bool markDefined(std::vector<bool>& defined, std::size_t id) {
+        if (id >= defined.size()) defined.resize(id + 1, false);
+        if (defined[id]) return false;
+        defined[id] = true;
+        return true;
+    }
+
+    //--------------------------------------------------------------------------
+    // Reading
+    //--------------------------------------------------------------------------
+    enum class ReadResult { Ok, End, Truncated };
+
+    ReadResult readVarint(std::istream& in, std::uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const int byte = in.get();
+            if (byte == std::char_traits<char>::eof()) return shift == 0 ? ReadResult::End : ReadResult::Truncated;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return ReadResult::Ok;
+        }
+        return ReadResult::Truncated;
+    }
+
+    struct Cursor {
+        const char* pos;
+        const char* end;
+
+        bool varint(std::uint64_t& value) {
+            value = 0;
+            for (int shift = 0; shift < 64 && pos < end; shift += 7) {
+                const auto byte = static_cast<unsigned char>(*pos++);
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return true;
+            }
+            return false;
+        }
+
+        std::string_view rest() const { return {pos, static_cast<std::size_t>(end - pos)}; }
+    };
+
+    // The fields of a FieldMessage; string views point into the record body
+    bool readFields(Cursor& cursor, std::vector<LogField>& fields) {
+        fields.clear();
+        std::uint64_t count = 0;
+        if (!cursor.varint(count)) return false;
+        for (std::uint64_t i = 0; i < count; ++i) {
+            std::uint64_t keyLength = 0;
+            if (!cursor.varint(keyLength) || keyLength + 1 > cursor.rest().size()) return false;
+            LogField field;
+            field.key = {cursor.pos, keyLength};
+            cursor.pos += keyLength;
+            const auto type = static_cast<FieldType>(*cursor.pos++);
+
+            std::uint64_t value = 0;
+            switch (type) {
+                case FieldType::Int:
+                    if (!cursor.varint(value)) return false;
+                    field.value = FieldValue(unzigzag(value));
+                    break;
+                case FieldType::UInt:
+                    if (!cursor.varint(value)) return false;
+                    field.value = FieldValue(value);
+                    break;
+                case FieldType::Bool:
+                    if (cursor.rest().empty()) return false;
+                    field.value = FieldValue(*cursor.pos++ != 0);
+                    break;
+                case FieldType::Double: {
+                    if (cursor.rest().size() < sizeof(double)) return false;
+                    double number = 0;
+                    std::memcpy(&number, cursor.pos, sizeof(double));
+                    cursor.pos += sizeof(double);
+                    field.value = FieldValue(number);
+                    break;
+                }
+                case FieldType::String:
+                    if (!cursor.varint(value) || value > cursor.rest().size()) return false;
+                    field.value = FieldValue(std::string_view{cursor.pos, value});
+                    cursor.pos += value;
+                    break;
+                default:
+                    return false;
+            }
+            fields.push_back(field);
+        }
+        return true;
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Encoder
+//------------------------------------------------------------------------------
+void BinaryLogEncoder::appendFileHeader(std::string& out) {
+    out.append(BINARY_LOG_MAGIC, BINARY_LOG_MAGIC_LENGTH);
+    out += static_cast<char>(BINARY_LOG_VERSION);
+}
+
+void BinaryLogEncoder::beginSession(const LoggerSettings& settings, std::string& out) {
+    previousTimeNs = 0;
+    levelsDefined.clear();
+    contextsDefined.clear();
+
+    const auto& format = settings.config.format;
+    const std::uint64_t flags = format.enableTimestamps ? 1 : 0;
+    appendVarint(out, 1 + varintSize(flags) + varintSize(format.timestampFormat.size()) + format.timestampFormat.size());
+    out += static_cast<char>(BinaryRecordType::Session);
+    appendVarint(out, flags);
+    appendVarint(out, format.timestampFormat.size());
+    out += format.timestampFormat;
+}
+
+void BinaryLogEncoder::append(const LogMessage& log, const LoggerSettings& settings, std::string& out) {
+    if (markDefined(levelsDefined, log.level)) {
+        appendDefinition(out, BinaryRecordType::Level, log.level, settings.levelName(log.level));
+    }
+    if (markDefined(contextsDefined, log.context)) {
+        appendDefinition(out, BinaryRecordType::Context, log.context, settings.contextName(log.context));
+    }
+
+    const std::uint64_t delta = zigzag(log.timeNs - previousTimeNs);
+    previousTimeNs = log.timeNs;
+
+    if (log.fields.empty()) {
+        appendVarint(out, 1 + varintSize(delta) + varintSize(log.level) + varintSize(log.context) + log.message.size());
+        out += static_cast<char>(BinaryRecordType::Message);
+        appendVarint(out, delta);
+        appendVarint(out, log.level);
+        appendVarint(out, log.context);
+        out += log.message;
+        return;
+    }
+
+    body.clear();
+    body += static_cast<char>(BinaryRecordType::FieldMessage);
+    appendVarint(body, delta);
+    appendVarint(body, log.level);
+    appendVarint(body, log.context);
+    appendVarint(body, log.message.size());
+    body += log.message;
+
+    std::uint64_t count = 0;
+    log.fields.forEach([&count](std::string_view, const FieldValue&) { ++count; });
+    appendVarint(body, count);
+    log.fields.forEach([this](std::string_view key, const FieldValue& value) {
+        appendVarint(body, key.size());
+        body += key;
+        body += static_cast<char>(value.type);
+        switch (value.type) {
+            case FieldType::Int:    appendVarint(body, zigzag(value.i)); break;
+            case FieldType::UInt:   appendVarint(body, value.u); break;
+            case FieldType::Bool:   body += static_cast<char>(value.u ? 1 : 0); break;
+            case FieldType::Double: body.append(reinterpret_cast<const char*>(&value.d), sizeof(double)); break;
+            case FieldType::String:
+                appendVarint(body, value.s.size());
+                body += value.s;
+                break;
+        }
+    });
+
+    appendVarint(out, body.size());
+    out += body;
+}
+
+//------------------------------------------------------------------------------
+// Decoder
+//------------------------------------------------------------------------------
+bool decodeBinaryLog(std::istream& in, std::ostream& out, std::string& error, LogFormat format) {
+    char magic[BINARY_LOG_MAGIC_LENGTH + 1] = {};
+    if (!in.read(magic, sizeof(magic)) ||
+        std::string_view(magic, BINARY_LOG_MAGIC_LENGTH) != std::string_view(BINARY_LOG_MAGIC)) {
+        error = "not a binary log file";
+        return false;
+    }
+    if (static_cast<std::uint8_t>(magic[BINARY_LOG_MAGIC_LENGTH]) != BINARY_LOG_VERSION) {
+        error = "unsupported binary log version " + std::to_string(static_cast<unsigned char>(magic[BINARY_LOG_MAGIC_LENGTH]));
+        return false;
+    }
+
+    std::unordered_map<std::uint64_t, std::string> levels;
+    std::unordered_map<std::uint64_t, std::string> contexts;
+    auto lookup = [](const auto& names, std::uint64_t id) -> std::string_view {
+        const auto it = names.find(id);
+        return it != names.end() ? std::string_view{it->second} : std::string_view{"UNKNOWN"};
+    };
+
+    bool timestamps = true;
+    std::string timestampFormat = "ISO";
+    std::int64_t timeNs = 0;
+    std::string body;
+    std::string line;
+    std::vector<LogField> parsedFields;
+    LogFields fields;
+
+    auto writeLine = [&](std::uint64_t level, std::uint64_t context, std::string_view text) {
+        char stamp[MAX_TIMESTAMP_LENGTH];
+        const std::size_t stampLength = timestamps ? formatTimestamp(timeNs, timestampFormat, stamp, sizeof(stamp)) : 0;
+        line.clear();
+        appendRecordLine(format, {stamp, stampLength}, lookup(levels, level), lookup(contexts, context), text, fields, line);
+        out << line;
+    };
+
+    for (std::size_t index = 0;; ++index) {
+        std::uint64_t length = 0;
+        const ReadResult result = readVarint(in, length);
+        if (result == ReadResult::End) return true;
+        if (result == ReadResult::Truncated) {
+            error = "truncated record length at record " + std::to_string(index);
+            return false;
+        }
+
+        body.resize(length);
+        if (length == 0 || !in.read(body.data(), static_cast<std::streamsize>(length))) {
+            error = "truncated record " + std::to_string(index);
+            return false;
+        }
+
+        Cursor cursor{body.data() + 1, body.data() + body.size()};
+        std::uint64_t a = 0, b = 0, c = 0;
+        switch (static_cast<BinaryRecordType>(body[0])) {
+            case BinaryRecordType::Session:
+                if (!cursor.varint(a) || !cursor.varint(b) || b > cursor.rest().size()) break;
+                timestamps = a & 1;
+                timestampFormat.assign(cursor.pos, b);
+                timeNs = 0;
+                levels.clear();
+                contexts.clear();
+                continue;
+
+            case BinaryRecordType::Level:
+                if (!cursor.varint(a)) break;
+                levels[a] = std::string(cursor.rest());
+                continue;
+
+            case BinaryRecordType::Context:
+                if (!cursor.varint(a)) break;
+                contexts[a] = std::string(cursor.rest());
+                continue;
+
+            case BinaryRecordType::Message: {
+                if (!cursor.varint(a) || !cursor.varint(b) || !cursor.varint(c)) break;
+                timeNs += unzigzag(a);
+                fields.clear();
+                writeLine(b, c, cursor.rest());
+                continue;
+            }
+
+            case BinaryRecordType::FieldMessage: {
+                std::uint64_t textLength = 0;
+                if (!cursor.varint(a) || !cursor.varint(b) || !cursor.varint(c) || !cursor.varint(textLength) ||
+                    textLength > cursor.rest().size()) break;
+                timeNs += unzigzag(a);
+                const std::string_view text{cursor.pos, textLength};
+                cursor.pos += textLength;
+                if (!readFields(cursor, parsedFields)) break;
+                fields.assign(parsedFields);
+                writeLine(b, c, text);
+                continue;
+            }
+
+            default:
+                error = "unknown record type " + std::to_string(static_cast<unsigned char>(body[0]))
+                      + " at record " + std::to_string(index);
+                return false;
+        }
+
+        error = "malformed record " + std::to_string(index);
+        return false;
+    }
+}
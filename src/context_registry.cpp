@@ -0,0 +1,140 @@
+#include "myLogger/context_registry.hpp"
+#include <bit>
+#include <functional>
+
+//------------------------------------------------------------------------------
+// Segment Addressing
+//------------------------------------------------------------------------------
+// Segment k holds (64 << k) ids, so id -> (segment, offset) is a bit scan.
+ContextRegistry::SegmentIndex ContextRegistry::locate(ContextId id) {
+    const std::uint64_t n = static_cast<std::uint64_t>(id) + (std::uint64_t{1} << FIRST_SEGMENT_BITS);
+    const unsigned width = static_cast<unsigned>(std::bit_width(n));
+    const std::size_t segment = width - FIRST_SEGMENT_BITS - 1;
+    return {segment, static_cast<std::size_t>(n - (std::uint64_t{1} << (width - 1)))};
+}
+
+std::size_t ContextRegistry::segmentSize(std::size_t segment) {
+    return std::size_t{1} << (segment + FIRST_SEGMENT_BITS);
+}
+
+//------------------------------------------------------------------------------
+// Constructor / Destructor
+//------------------------------------------------------------------------------
+ContextRegistry::ContextRegistry() = default;
+
+ContextRegistry::~ContextRegistry() {
+    // Alias entries (lost insert races) are only reachable through the id table
+    const ContextId count = nextId.load(std::memory_order_acquire);
+    for (ContextId id = 0; id < count; ++id) {
+        Slot* slot = slotFor(id);
+        const Entry* entry = slot ? slot->entry.load(std::memory_order_acquire) : nullptr;
+        if (entry && find(entry->name) != id) {
+            delete entry;
+        }
+    }
+
+    for (auto& bucket : buckets) {
+        Entry* entry = bucket.load(std::memory_order_acquire);
+        while (entry) {
+            Entry* next = entry->next;
+            delete entry;
+            entry = next;
+        }
+    }
+
+    for (auto& segment : segments) {
+        delete[] segment.load(std::memory_order_acquire);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Lookup (wait-free)
+//------------------------------------------------------------------------------
+const ContextRegistry::Entry* ContextRegistry::findEntry(std::string_view name, std::size_t hash,
+                                                         const Entry* from) const {
+    for (const Entry* entry = from; entry; entry = entry->next) {
+        if (entry->hash == hash && entry->name == name) return entry;
+    }
+    return nullptr;
+}
+
+ContextId ContextRegistry::find(std::string_view name) const {
+    const std::size_t hash = std::hash<std::string_view>{}(name);
+    const Entry* head = buckets[hash % BUCKET_COUNT].load(std::memory_order_acquire);
+    const Entry* entry = findEntry(name, hash, head);
+    return entry ? entry->id : INVALID_CONTEXT_ID;
+}
+
+ContextRegistry::Slot* ContextRegistry::slotFor(ContextId id) const {
+    const auto [segment, offset] = locate(id);
+    if (segment >= SEGMENT_COUNT) return nullptr;
+    Slot* base = segments[segment].load(std::memory_order_acquire);
+    return base ? &base[offset] : nullptr;
+}
+
+std::string_view ContextRegistry::name(ContextId id) const {
+    if (id >= size()) return "UNKNOWN";
+    const Slot* slot = slotFor(id);
+    const Entry* entry = slot ? slot->entry.load(std::memory_order_acquire) : nullptr;
+    return entry ? std::string_view{entry->name} : std::string_view{"UNKNOWN"};
+}
+
+//------------------------------------------------------------------------------
+// Insert (lock-free)
+//------------------------------------------------------------------------------
+ContextRegistry::Slot& ContextRegistry::ensureSlot(ContextId id) {
+    const auto [segment, offset] = locate(id);
+    Slot* base = segments[segment].load(std::memory_order_acquire);
+    if (!base) {
+        Slot* fresh = new Slot[segmentSize(segment)];
+        if (segments[segment].compare_exchange_strong(base, fresh, std::memory_order_acq_rel)) {
+            base = fresh;
+        } else {
+            delete[] fresh;   // another thread allocated it; `base` now holds theirs
+        }
+    }
+    return base[offset];
+}
+
+ContextId ContextRegistry::findOrAdd(std::string_view name) {
+    const std::size_t hash = std::hash<std::string_view>{}(name);
+    auto& bucket = buckets[hash % BUCKET_COUNT];
+
+    Entry* head = bucket.load(std::memory_order_acquire);
+    if (const Entry* existing = findEntry(name, hash, head)) {
+        return existing->id;
+    }
+
+    const ContextId id = nextId.fetch_add(1, std::memory_order_acq_rel);
+    if (locate(id).segment >= SEGMENT_COUNT) return INVALID_CONTEXT_ID;
+
+    auto* entry = new Entry{std::string(name), hash, id, head};
+    Slot& slot = ensureSlot(id);
+    slot.entry.store(entry, std::memory_order_release);
+
+    // Publish in the bucket; after a failed CAS, look for a racing insert of the same name
+    while (!bucket.compare_exchange_weak(entry->next, entry, std::memory_order_release,
+                                         std::memory_order_acquire)) {
+        if (const Entry* winner = findEntry(name, hash, entry->next)) {
+            return winner->id;   // our id stays behind as an alias of the same name
+        }
+    }
+    return id;
+}
+
+//------------------------------------------------------------------------------
+// Snapshot of Registered Names
+//------------------------------------------------------------------------------
+std::vector<std::string> ContextRegistry::names() const {
+    std::vector<std::string> result;
+    const ContextId count = static_cast<ContextId>(size());
+    result.reserve(count);
+    for (ContextId id = 0; id < count; ++id) {
+        const Slot* slot = slotFor(id);
+        const Entry* entry = slot ? slot->entry.load(std::memory_order_acquire) : nullptr;
+        if (entry && find(entry->name) == id) {
+            result.push_back(entry->name);
+        }
+    }
+    return result;
+}
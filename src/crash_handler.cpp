@@ -0,0 +1,122 @@
+#include "myLogger/crash_handler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <mutex>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    // A slot is claimed by CAS on `owner`; `drain` is published after it
+    struct Slot {
+        std::atomic<void*> owner{nullptr};
+        std::atomic<CrashHandler::DrainFn> drain{nullptr};
+    };
+
+    Slot slots[MAX_CRASH_DRAINS];
+    std::atomic<bool> draining{false};
+
+#if !defined(_WIN32)
+    // Disabled again before the memory goes, since the kernel keeps using it
+    struct AltStack {
+        std::unique_ptr<char[]> memory;
+
+        ~AltStack() {
+            if (!memory) return;
+            stack_t disable{};
+            disable.ss_flags = SS_DISABLE;
+            sigaltstack(&disable, nullptr);
+        }
+    };
+
+    thread_local AltStack altStack;
+
+    constexpr int FATAL_SIGNALS[] = {SIGSEGV, SIGABRT, SIGBUS, SIGFPE};
+    struct sigaction previousActions[sizeof(FATAL_SIGNALS) / sizeof(FATAL_SIGNALS[0])];
+
+    void onFatalSignal(int signal) {
+        const int savedErrno = errno;
+
+        if (draining.exchange(true)) {
+            // Another thread is draining and will take the process down
+            for (;;) pause();
+        }
+
+        for (auto& slot : slots) {
+            void* owner = slot.owner.load(std::memory_order_acquire);
+            const auto drain = slot.drain.load(std::memory_order_acquire);
+            if (owner && drain) drain(owner, signal);
+        }
+
+        // Hand the signal to whoever had it before us (by default: terminate, core dump)
+        for (std::size_t i = 0; i < sizeof(FATAL_SIGNALS) / sizeof(FATAL_SIGNALS[0]); ++i) {
+            if (FATAL_SIGNALS[i] == signal) sigaction(signal, &previousActions[i], nullptr);
+        }
+        errno = savedErrno;
+        raise(signal);
+    }
+#endif
+
+} // namespace
+
+void CrashHandler::install() {
+#if !defined(_WIN32)
+    static std::once_flag installed;
+    std::call_once(installed, [] {
+        struct sigaction action{};
+        action.sa_handler = onFatalSignal;
+        sigemptyset(&action.sa_mask);
+        // The signal stays blocked while the handler runs, so a fault inside
+        // the drain itself makes the kernel terminate the process right away
+        action.sa_flags = SA_ONSTACK;
+        for (std::size_t i = 0; i < sizeof(FATAL_SIGNALS) / sizeof(FATAL_SIGNALS[0]); ++i) {
+            sigaction(FATAL_SIGNALS[i], &action, &previousActions[i]);
+        }
+    });
+    prepareThread();
+#endif
+}
+
+void CrashHandler::prepareThread() {
+#if !defined(_WIN32)
+    if (altStack.memory) return;
+
+    // Someone else's stack is kept
+    stack_t current{};
+    if (sigaltstack(nullptr, &current) != 0 || !(current.ss_flags & SS_DISABLE)) return;
+
+    const std::size_t size = std::max<std::size_t>(CRASH_STACK_SIZE, SIGSTKSZ);
+    auto memory = std::make_unique<char[]>(size);
+    stack_t stack{};
+    stack.ss_sp = memory.get();
+    stack.ss_size = size;
+    if (sigaltstack(&stack, nullptr) == 0) {
+        altStack.memory = std::move(memory);
+    }
+#endif
+}
+
+bool CrashHandler::add(void* owner, DrainFn drain) {
+    for (auto& slot : slots) {
+        void* expected = nullptr;
+        if (slot.owner.compare_exchange_strong(expected, owner, std::memory_order_acq_rel)) {
+            slot.drain.store(drain, std::memory_order_release);
+            return true;
+        }
+    }
+    return false;
+}
+
+void CrashHandler::remove(void* owner) {
+    for (auto& slot : slots) {
+        if (slot.owner.load(std::memory_order_acquire) == owner) {
+            slot.drain.store(nullptr, std::memory_order_release);
+            slot.owner.store(nullptr, std::memory_order_release);
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#include "myLogger/logger_core.hpp"
+
+//------------------------------------------------------------------------------
+// Folding (consumer thread, once per batch)
+//------------------------------------------------------------------------------
+void DuplicateCoalescer::apply(std::vector<LogMessage>& batch, std::int64_t windowNs,
+                               const LoggerSettings::Format& format, std::vector<LogMessage>& leading) {
+    constexpr std::size_t NO_SLOT = static_cast<std::size_t>(-1);
+
+    // Records are compacted towards the front; the first repeat of a run
+    // keeps its slot so the summary can be written there in order
+    std::size_t out = 0;
+    std::size_t summarySlot = NO_SLOT;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        LogMessage& log = batch[i];
+        if (active && log.timeNs - startNs < windowNs && continuesRun(log)) {
+            ++repeats;
+            lastNs = log.timeNs;
+            if (summarySlot == NO_SLOT) {
+                summarySlot = out++;
+            }
+            continue;
+        }
+
+        if (repeats > 0) {
+            if (summarySlot != NO_SLOT) {
+                writeSummary(batch[summarySlot], format);
+            } else {
+                // Every repeat was in an earlier batch
+                leading.emplace_back();
+                writeSummary(leading.back(), format);
+            }
+            summarySlot = NO_SLOT;
+        }
+
+        if (out != i) batch[out] = std::move(log);
+        startRun(batch[out]);
+        ++out;
+    }
+
+    // The run may go on in the next batch; its count carries over
+    if (summarySlot != NO_SLOT) --out;
+    batch.erase(batch.begin() + static_cast<std::ptrdiff_t>(out), batch.end());
+
+    // The first record leaves with this batch; later ones are matched against a copy
+    if (anchor != nullptr) {
+        runMessage.assign(anchor->message.view());
+        runFields.assign(anchor->fields.bytes());
+        anchor = nullptr;
+    }
+}
+
+bool DuplicateCoalescer::flushExpired(std::int64_t nowNs, std::int64_t windowNs, bool force,
+                                      const LoggerSettings::Format& format, LogMessage& summary) {
+    if (!active) return false;
+    if (!force && nowNs - startNs < windowNs) return false;
+
+    active = false;
+    if (repeats == 0) return false;
+    writeSummary(summary, format);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+bool DuplicateCoalescer::continuesRun(const LogMessage& log) const {
+    if (log.level != level || log.context != context) return false;
+    if (anchor != nullptr) {
+        return log.message.view() == anchor->message.view() && log.fields.bytes() == anchor->fields.bytes();
+    }
+    return log.message.view() == runMessage && log.fields.bytes() == runFields;
+}
+
+void DuplicateCoalescer::startRun(const LogMessage& log) {
+    active = true;
+    level = log.level;
+    context = log.context;
+    anchor = &log;
+    startNs = log.timeNs;
+    lastNs = log.timeNs;
+    repeats = 0;
+}
+
+// Written at the run's level and context, stamped with its last repeat
+void DuplicateCoalescer::writeSummary(LogMessage& into, const LoggerSettings::Format& format) {
+    into.level = level;
+    into.context = context;
+    into.message.assign("last message repeated " + std::to_string(repeats) + " times");
+    into.fields.clear();
+    into.deferred.formatFn = nullptr;
+    into.timeNs = lastNs;
+    into.timestampLength = 0;
+    if (format.enableTimestamps) {
+        into.stampTime(format.timestampFormat);
+    }
+    repeats = 0;
+}
@@ -0,0 +1,319 @@
+#include "myLogger/log_rotator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#if defined(MYLOGGER_HAS_ZLIB)
+#include <zlib.h>
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    constexpr std::int64_t NANOS_PER_SECOND = 1'000'000'000;
+
+    void lowerThreadPriority() {
+#if defined(_WIN32)
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(__linux__)
+        // Linux applies nice values per thread
+        setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+#endif
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Configuration
+//------------------------------------------------------------------------------
+void LogRotator::configure(const LoggerSettings& settings, const std::string& activePath, std::int64_t openedAtNs) {
+    const auto& general = settings.config.general;
+    maxBytes = static_cast<std::uint64_t>(std::max<std::int64_t>(general.rotationSize, 0));
+    intervalNs = std::max<std::int64_t>(general.rotationInterval, 0) * NANOS_PER_SECOND;
+    {
+        // The helper thread may be compressing or sweeping right now
+        std::lock_guard<std::mutex> lock(mutex);
+        disposal = {general.compressRotated, general.logRotationDays,
+                    general.logDirectory, general.logFilenameFormat};
+    }
+
+    lastResolved = activePath;
+    sequence = 0;
+    scheduleNext(openedAtNs);
+    enqueue("", activePath);
+}
+
+// Interval boundaries are aligned to the epoch (e.g. midnight UTC for 86400)
+void LogRotator::scheduleNext(std::int64_t timeNs) {
+    nextRotationNs = intervalNs > 0 ? (timeNs / intervalNs + 1) * intervalNs : 0;
+}
+
+//------------------------------------------------------------------------------
+// Rotation Decision (consumer thread)
+//------------------------------------------------------------------------------
+bool LogRotator::due(std::uint64_t fileSize, std::uint64_t pendingBytes, std::int64_t timeNs) const {
+    if (fileSize == 0) return false;   // never rotate to leave an empty file behind
+    if (maxBytes > 0 && fileSize + pendingBytes > maxBytes) return true;
+    return intervalNs > 0 && timeNs >= nextRotationNs;
+}
+
+std::string LogRotator::nextPath(const std::string& resolved) {
+    namespace fs = std::filesystem;
+    auto taken = [](const std::string& candidate) {
+        return fs::exists(candidate) || fs::exists(candidate + ".gz");
+    };
+
+    if (resolved != lastResolved) {
+        lastResolved = resolved;
+        sequence = 0;
+        if (!taken(resolved)) return resolved;
+    }
+
+    // "app.txt" -> "app.1.txt", "app.2.txt", ...
+    const fs::path path(resolved);
+    const auto stem = (path.parent_path() / path.stem()).string();
+    std::string candidate;
+    do {
+        candidate = stem + "." + std::to_string(++sequence) + path.extension().string();
+    } while (taken(candidate));
+    return candidate;
+}
+
+void LogRotator::retire(const std::string& closedPath, const std::string& activePath, std::int64_t timeNs) {
+    scheduleNext(timeNs);
+    enqueue(closedPath, activePath);
+}
+
+//------------------------------------------------------------------------------
+// Helper Thread
+//------------------------------------------------------------------------------
+void LogRotator::enqueue(std::string path, const std::string& activePath) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(std::move(path));
+        active = activePath;
+        if (!helper.joinable()) {
+            stopping = false;
+            helper = std::thread(&LogRotator::run, this);
+        }
+    }
+    wake.notify_one();
+}
+
+void LogRotator::run() {
+    lowerThreadPriority();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this] { return !pending.empty() || stopping; });
+        if (pending.empty()) return;
+
+        const std::string path = std::move(pending.front());
+        pending.pop_front();
+        const Disposal policy = disposal;
+        const std::string activePath = active;
+        lock.unlock();
+
+#if defined(MYLOGGER_HAS_ZLIB)
+        if (!path.empty() && policy.compress) {
+            compressFile(path);
+        }
+#endif
+        sweepRetention(policy, activePath);
+
+        lock.lock();
+    }
+}
+
+void LogRotator::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    if (helper.joinable()) {
+        helper.join();
+    }
+}
+
+LogRotator::~LogRotator() {
+    shutdown();
+}
+
+//------------------------------------------------------------------------------
+// Retention: delete rotated logs older than log_rotation_days
+//------------------------------------------------------------------------------
+void LogRotator::sweepRetention(const Disposal& policy, const std::string& activePath) {
+    if (policy.retentionDays <= 0) return;
+
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    const auto cutoff = fs::file_time_type::clock::now() - std::chrono::hours(24) * policy.retentionDays;
+    const std::string_view format = std::string_view(policy.filenameFormat)
+                                        .substr(policy.filenameFormat.find_last_of('/') + 1);
+
+    for (const auto& entry : fs::directory_iterator(policy.logDirectory, ec)) {
+        if (!entry.is_regular_file(ec)) continue;
+        if (!isRotatedName(entry.path().filename().string(), format)) continue;
+        if (fs::equivalent(entry.path(), activePath, ec)) continue;
+
+        const auto modified = entry.last_write_time(ec);
+        if (!ec && modified < cutoff) {
+            fs::remove(entry.path(), ec);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Filename Matching: could log_filename_format have produced this name?
+//------------------------------------------------------------------------------
+namespace {
+
+    bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    // Shorthand conversions, spelled out
+    std::string_view expandConversion(char spec) {
+        switch (spec) {
+            case 'F': return "%Y-%m-%d";
+            case 'T': return "%H:%M:%S";
+            case 'R': return "%H:%M";
+            case 'D': return "%m/%d/%y";
+            default:  return {};
+        }
+    }
+
+    // Digits a numeric conversion prints; 0 for text conversions (names, zones)
+    int conversionWidth(char spec) {
+        switch (spec) {
+            case 'Y': case 'G': return 4;
+            case 'j': return 3;
+            case 'm': case 'd': case 'H': case 'I': case 'M': case 'S':
+            case 'y': case 'C': case 'g': case 'U': case 'W': case 'V': return 2;
+            case 'u': case 'w': return 1;
+            default:  return 0;
+        }
+    }
+
+    // Backtracking match of `name` against a strftime format
+    bool matchFormat(std::string_view name, std::string_view format) {
+        while (!format.empty()) {
+            if (format[0] != '%' || format.size() < 2) {
+                if (name.empty() || name[0] != format[0]) return false;
+                name.remove_prefix(1);
+                format.remove_prefix(1);
+                continue;
+            }
+
+            std::size_t specAt = 1;
+            if (format[specAt] == 'E' || format[specAt] == 'O') ++specAt;   // locale modifiers
+            if (specAt >= format.size()) return false;
+            const char spec = format[specAt];
+            format.remove_prefix(specAt + 1);
+
+            if (spec == '%' || spec == 'n' || spec == 't') {
+                const char literal = spec == '%' ? '%' : spec == 'n' ? '\n' : '\t';
+                if (name.empty() || name[0] != literal) return false;
+                name.remove_prefix(1);
+                continue;
+            }
+            if (const auto expanded = expandConversion(spec); !expanded.empty()) {
+                return matchFormat(name, std::string(expanded) + std::string(format));
+            }
+            if (spec == 'e') {   // day of month, space-padded
+                if (name.size() < 2 || !(name[0] == ' ' || isDigit(name[0])) || !isDigit(name[1])) return false;
+                name.remove_prefix(2);
+                continue;
+            }
+            if (const int width = conversionWidth(spec); width > 0) {
+                if (name.size() < static_cast<std::size_t>(width)) return false;
+                for (int i = 0; i < width; ++i) {
+                    if (!isDigit(name[static_cast<std::size_t>(i)])) return false;
+                }
+                name.remove_prefix(static_cast<std::size_t>(width));
+                continue;
+            }
+
+            // Text (month names, AM/PM, zones, epoch seconds): one or more
+            // characters, tried shortest first
+            for (std::size_t taken = 1; taken <= name.size(); ++taken) {
+                if (name[taken - 1] == '/' || name[taken - 1] == '.') break;
+                if (matchFormat(name.substr(taken), format)) return true;
+            }
+            return false;
+        }
+        return name.empty();
+    }
+
+} // namespace
+
+bool LogRotator::isRotatedName(std::string_view filename, std::string_view format) {
+    if (matchFormat(filename, format)) return true;
+
+    constexpr std::string_view GZ = ".gz";
+    if (filename.size() > GZ.size() && filename.substr(filename.size() - GZ.size()) == GZ) {
+        filename.remove_suffix(GZ.size());
+        if (matchFormat(filename, format)) return true;
+    }
+
+    // nextPath(): "app.txt" -> "app.N.txt", "app" -> "app.N"
+    auto isSequence = [](std::string_view digits) {
+        return !digits.empty() && std::all_of(digits.begin(), digits.end(), isDigit);
+    };
+    const std::filesystem::path path{std::string(filename)};
+    const std::string stem = path.stem().string();
+    const std::string extension = path.extension().string();
+    if (!extension.empty() && isSequence(std::string_view(extension).substr(1)) && matchFormat(stem, format)) {
+        return true;
+    }
+    const std::size_t dot = stem.rfind('.');
+    if (dot == std::string::npos || !isSequence(std::string_view(stem).substr(dot + 1))) return false;
+    return matchFormat(stem.substr(0, dot) + extension, format);
+}
+
+//------------------------------------------------------------------------------
+// Compression: "<path>" -> "<path>.gz", original removed on success
+//------------------------------------------------------------------------------
+bool LogRotator::compressFile(const std::string& path) {
+#if defined(MYLOGGER_HAS_ZLIB)
+    std::ifstream input(path, std::ios::binary);
+    if (!input) return false;
+
+    const std::string target = path + ".gz";
+    gzFile output = gzopen(target.c_str(), "wb6");
+    if (!output) return false;
+
+    std::vector<char> chunk(256 * 1024);
+    bool ok = true;
+    while (ok && input) {
+        input.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        const auto count = static_cast<unsigned>(input.gcount());
+        if (count > 0 && gzwrite(output, chunk.data(), count) != static_cast<int>(count)) {
+            ok = false;
+        }
+    }
+    ok = (gzclose(output) == Z_OK) && ok;
+    input.close();
+
+    std::error_code ec;
+    if (!ok) {
+        std::cerr << "[LogRotator] Failed to compress " << path << "\n";
+        std::filesystem::remove(target, ec);
+        return false;
+    }
+    std::filesystem::remove(path, ec);
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
@@ -1,4 +1,5 @@
 #include "myLogger/logger_config.hpp"
+#include "myLogger/rate_limiter.hpp"
 #include <filesystem>
 #include <iostream>
 #include <fstream>
@@ -10,13 +11,49 @@ LoggerSettings::LoggerSettings() {
     // Default all levels to "true" and "severity=0"
     config.levels.enabledArray.fill(true);
     config.levels.severitiesArray.fill(0);
+    config.levels.typedIds.fill(INVALID_LEVEL_ID);
+    config.levels.typedSeverities.fill(LEVEL_DISABLED);
 
     // Default to white for level/context colors
     config.colors.logColorArray.fill("#FFFFFFFF");
-    config.colors.contextColorArray.fill("#FFFFFFFF");
 
-    // Default context severity = 0
-    config.contexts.contextSeverityArray.fill(0);
+    // Ids hand out references into this vector; never let it reallocate
+    config.levels.levelNames.reserve(MAX_LEVELS);
+}
+
+//------------------------------------------------------------------------------
+// Id <-> Name Lookups
+//------------------------------------------------------------------------------
+std::string_view LoggerSettings::levelName(LevelId id) const {
+    return id < config.levels.levelNames.size() ? std::string_view{config.levels.levelNames[id]} : "UNKNOWN";
+}
+
+std::string_view LoggerSettings::contextName(ContextId id) const {
+    return contextRegistry->name(id);
+}
+
+LevelId LoggerSettings::mostSevereLevel() const {
+    const auto& levels = config.levels;
+    LevelId result = 0;
+    for (std::size_t level = 1; level < levels.levelNames.size() && level < MAX_LEVELS; ++level) {
+        if (levels.severitiesArray[level] > levels.severitiesArray[result]) {
+            result = static_cast<LevelId>(level);
+        }
+    }
+    return result;
+}
+
+LevelId LoggerSettings::findLevel(std::string_view name) const {
+    const auto it = config.levels.levelIndexMap.find(name);
+    return it == config.levels.levelIndexMap.end() ? INVALID_LEVEL_ID : static_cast<LevelId>(it->second);
+}
+
+ContextId LoggerSettings::findContext(std::string_view name) const {
+    return contextRegistry->find(name);
+}
+
+ContextId LoggerSettings::addContext(std::string_view name) const {
+    return contextRegistry->findOrAdd(name);
 }
 
 //------------------------------------------------------------------------------
@@ -39,6 +76,31 @@ void LoggerConfig::printConfigState(const LoggerSettings& settings) {
     printString("log_directory",        cfg.general.logDirectory);
     printString("log_filename_format",  cfg.general.logFilenameFormat);
     printString("flush_mode",           cfg.general.flushMode);
+    printString("queue_mode",           cfg.general.queueMode);
+    printString("queue_capacity",       std::to_string(cfg.general.queueCapacity));
+    printString("thread_queue_capacity", std::to_string(cfg.general.threadQueueCapacity));
+    printString("file_buffer_size",     std::to_string(cfg.general.fileBufferSize));
+    printString("batch_size",           std::to_string(cfg.general.batchSize));
+    printString("mmap_segment_size",    std::to_string(cfg.general.mmapSegmentSize));
+    printString("mmap_msync",           cfg.general.mmapMsync);
+    printString("rotation_size",        std::to_string(cfg.general.rotationSize));
+    printString("rotation_interval",    std::to_string(cfg.general.rotationInterval));
+    printBool("compress_rotated",       cfg.general.compressRotated);
+    printString("backpressure_policy",  cfg.general.backpressurePolicy);
+    printString("queue_max_messages",   std::to_string(cfg.general.queueMaxMessages));
+    printString("queue_max_bytes",      std::to_string(cfg.general.queueMaxBytes));
+    printString("block_timeout_ms",     std::to_string(cfg.general.blockTimeoutMs));
+    printString("dispatch_mode",        cfg.general.dispatchMode);
+    printString("backend_overflow_policy", cfg.general.backendOverflowPolicy);
+    printString("wait_strategy",        cfg.general.waitStrategy);
+    printString("wait_spin_us",         std::to_string(cfg.general.waitSpinUs));
+    printString("wait_interval_us",     std::to_string(cfg.general.waitIntervalUs));
+    printBool("crash_handler",          cfg.general.crashHandler);
+    printString("shm_ring_name",        cfg.general.shmRingName);
+    printString("shm_ring_size",        std::to_string(cfg.general.shmRingSize));
+    printString("shm_poll_ms",          std::to_string(cfg.general.shmPollMs));
+    printString("suppression_report_interval", std::to_string(cfg.general.suppressionReportInterval));
+    printString("coalesce_window_ms",   std::to_string(cfg.general.coalesceWindowMs));
 
     // ✅ Format
     printBool("log_timestamps",         cfg.format.enableTimestamps);
@@ -82,6 +144,7 @@ void LoggerConfig::loadOrGenerateConfig(const std::string& filepath, LoggerSetti
         generateDefaultConfig(filepath);
     }
     loadConfig(filepath, settings);
+    ++settings.generation;
 
     // ✅ Example: If "BENCHMARK_MODE" env var is set, disable console
     if (std::getenv("BENCHMARK_MODE")) {
@@ -102,6 +165,7 @@ void LoggerConfig::loadConfig(const std::string& filepath, LoggerSettings& setti
         loadDisplay(config, settings);
         loadLevels(config, settings);
         loadSeverities(config, settings);
+        resolveTypedLevels(settings);
         loadColors(config, settings);
         loadContexts(config, settings);
 
@@ -121,6 +185,31 @@ void LoggerConfig::loadGeneral(const toml::table& config, LoggerSettings& settin
         general.logFilenameFormat = config["general"]["log_filename_format"]  .value_or(general.logFilenameFormat);
         general.logRotationDays   = config["general"]["log_rotation_days"]    .value_or(general.logRotationDays);
         general.flushMode         = config["general"]["flush_mode"]           .value_or(general.flushMode);
+        general.queueMode         = config["general"]["queue_mode"]           .value_or(general.queueMode);
+        general.queueCapacity     = config["general"]["queue_capacity"]       .value_or(general.queueCapacity);
+        general.threadQueueCapacity = config["general"]["thread_queue_capacity"].value_or(general.threadQueueCapacity);
+        general.fileBufferSize    = config["general"]["file_buffer_size"]     .value_or(general.fileBufferSize);
+        general.batchSize         = config["general"]["batch_size"]           .value_or(general.batchSize);
+        general.mmapSegmentSize   = config["general"]["mmap_segment_size"]    .value_or(general.mmapSegmentSize);
+        general.mmapMsync         = config["general"]["mmap_msync"]           .value_or(general.mmapMsync);
+        general.rotationSize      = config["general"]["rotation_size"]        .value_or(general.rotationSize);
+        general.rotationInterval  = config["general"]["rotation_interval"]    .value_or(general.rotationInterval);
+        general.compressRotated   = config["general"]["compress_rotated"]     .value_or(general.compressRotated);
+        general.backpressurePolicy = config["general"]["backpressure_policy"] .value_or(general.backpressurePolicy);
+        general.queueMaxMessages  = config["general"]["queue_max_messages"]   .value_or(general.queueMaxMessages);
+        general.queueMaxBytes     = config["general"]["queue_max_bytes"]      .value_or(general.queueMaxBytes);
+        general.blockTimeoutMs    = config["general"]["block_timeout_ms"]     .value_or(general.blockTimeoutMs);
+        general.dispatchMode      = config["general"]["dispatch_mode"]        .value_or(general.dispatchMode);
+        general.backendOverflowPolicy = config["general"]["backend_overflow_policy"].value_or(general.backendOverflowPolicy);
+        general.waitStrategy      = config["general"]["wait_strategy"]        .value_or(general.waitStrategy);
+        general.waitSpinUs        = config["general"]["wait_spin_us"]         .value_or(general.waitSpinUs);
+        general.waitIntervalUs    = config["general"]["wait_interval_us"]     .value_or(general.waitIntervalUs);
+        general.crashHandler      = config["general"]["crash_handler"]        .value_or(general.crashHandler);
+        general.shmRingName       = config["general"]["shm_ring_name"]        .value_or(general.shmRingName);
+        general.shmRingSize       = config["general"]["shm_ring_size"]        .value_or(general.shmRingSize);
+        general.shmPollMs         = config["general"]["shm_poll_ms"]          .value_or(general.shmPollMs);
+        general.suppressionReportInterval = config["general"]["suppression_report_interval"].value_or(general.suppressionReportInterval);
+        general.coalesceWindowMs  = config["general"]["coalesce_window_ms"]   .value_or(general.coalesceWindowMs);
     }
 }
 
@@ -165,20 +254,24 @@ void LoggerConfig::loadDisplay(const toml::table& config, LoggerSettings& settin
 void LoggerConfig::loadLevels(const toml::table& config, LoggerSettings& settings) {
     if (config.contains("levels")) {
         auto& levels = settings.config.levels;
-        levels.levelNames.clear();
-        levels.levelIndexMap.clear();
         levels.enabledArray.fill(false);
 
-        int index = 0;
+        // Keep the index of levels we already know so LevelIds survive a reload
         for (auto&& [key, node] : *config["levels"].as_table()) {
-            if (index >= MAX_LEVELS) break;
             std::string levelName = std::string(key);
 
-            levels.levelNames.push_back(levelName);
-            levels.levelIndexMap[levelName] = index;
-            levels.enabledArray[index] = (node.as_string()->get() == "ON");
+            int index;
+            auto it = levels.levelIndexMap.find(levelName);
+            if (it != levels.levelIndexMap.end()) {
+                index = it->second;
+            } else {
+                if (levels.levelNames.size() >= MAX_LEVELS) break;
+                index = static_cast<int>(levels.levelNames.size());
+                levels.levelNames.push_back(levelName);
+                levels.levelIndexMap[levelName] = index;
+            }
 
-            ++index;
+            levels.enabledArray[index] = (node.as_string()->get() == "ON");
         }
     }
 }
@@ -203,6 +296,19 @@ void LoggerConfig::loadSeverities(const toml::table& config, LoggerSettings& set
     }
 }
 
+//------------------------------------------------------------------------------
+// resolveTypedLevels: Level::X -> LevelId and effective severity
+//------------------------------------------------------------------------------
+void LoggerConfig::resolveTypedLevels(LoggerSettings& settings) {
+    auto& levels = settings.config.levels;
+    for (std::size_t i = 0; i < TYPED_LEVEL_COUNT; ++i) {
+        const LevelId id = settings.findLevel(TYPED_LEVEL_NAMES[i]);
+        const bool enabled = id < MAX_LEVELS && levels.enabledArray[id];
+        levels.typedIds[i] = id;
+        levels.typedSeverities[i] = enabled ? levels.severitiesArray[id] : LEVEL_DISABLED;
+    }
+}
+
 //------------------------------------------------------------------------------
 // loadColors
 //------------------------------------------------------------------------------
@@ -257,29 +363,97 @@ void LoggerConfig::loadColors(const toml::table& config, LoggerSettings& setting
     }
 }
 
+//------------------------------------------------------------------------------
+// readLimitRules: rate/burst/sample for every level of one [contexts] table,
+// with LEVEL = { ... } sub-tables overriding the context-wide values
+//------------------------------------------------------------------------------
+namespace {
+
+    LimitRule readLimitRule(const toml::table& table, LimitRule rule) {
+        rule.rate   = table["rate"]  .value_or(rule.rate);
+        rule.burst  = table["burst"] .value_or(rule.burst);
+        rule.sample = table["sample"].value_or(rule.sample);
+        return rule;
+    }
+
+    std::array<LimitRule, MAX_LEVELS> readLimitRules(const toml::table& table,
+                                                     const LoggerSettings::Levels& levels) {
+        std::array<LimitRule, MAX_LEVELS> rules;
+        rules.fill(readLimitRule(table, LimitRule{}));
+        for (auto&& [key, node] : table) {
+            const auto* perLevel = node.as_table();
+            const auto it = levels.levelIndexMap.find(std::string(key));
+            if (perLevel && it != levels.levelIndexMap.end() && it->second < MAX_LEVELS) {
+                rules[it->second] = readLimitRule(*perLevel, rules[it->second]);
+            }
+        }
+        return rules;
+    }
+
+    // Typed levels that pass a context with this minimum severity, one bit each
+    std::uint8_t typedLevelMaskFor(const LoggerSettings::Levels& levels, int minimum) {
+        std::uint8_t mask = 0;
+        for (std::size_t i = 0; i < TYPED_LEVEL_COUNT; ++i) {
+            const int severity = levels.typedSeverities[i];
+            if (severity != LEVEL_DISABLED && severity >= minimum) mask |= static_cast<std::uint8_t>(1u << i);
+        }
+        return mask;
+    }
+
+} // namespace
+
 //------------------------------------------------------------------------------
 // loadContexts
 //------------------------------------------------------------------------------
 void LoggerConfig::loadContexts(const toml::table& config, LoggerSettings& settings) {
-    if (!config.contains("contexts")) return;
     auto& ctxs = settings.config.contexts;
+    auto& registry = *settings.contextRegistry;
+    const auto& levels = settings.config.levels;
+
+    // Contexts not listed in [contexts] log at INFO and above
+    const auto infoIt = levels.levelIndexMap.find("INFO");
+    ctxs.defaultSeverity = (infoIt != levels.levelIndexMap.end()) ? levels.severitiesArray[infoIt->second] : 0;
+
+    std::unordered_map<std::string, int> configured;
+    auto limiter = std::make_shared<RateLimiter>();
     ctxs.contextNames.clear();
-    ctxs.contextIndexMap.clear();
-    ctxs.contextSeverityArray.fill(0);
-
-    int ctxIndex = 0;
-    for (auto&& [key, node] : *config["contexts"].as_table()) {
-        if (ctxIndex >= MAX_CONTEXTS) break;
-        std::string contextName = std::string(key);
-        ctxs.contextNames.push_back(contextName);
-        ctxs.contextIndexMap[contextName] = ctxIndex;
-
-        // For each context, find the level’s severity
-        auto severityIt = settings.config.levels.levelIndexMap.find(node.as_string()->get());
-        ctxs.contextSeverityArray[ctxIndex] = (severityIt != settings.config.levels.levelIndexMap.end())
-                                                 ? settings.config.levels.severitiesArray[severityIt->second]
-                                                 : 0;
-        ++ctxIndex;
+    if (auto* table = config["contexts"].as_table()) {
+        for (auto&& [key, node] : *table) {
+            std::string contextName = std::string(key);
+
+            // NAME = "LEVEL" or NAME = { level = "LEVEL", rate = ..., ... }
+            const auto* limits = node.as_table();
+            const std::string levelName = limits ? (*limits)["level"].value_or(std::string{})
+                                                 : node.value_or(std::string{});
+
+            // For each context, find the level’s severity
+            auto severityIt = levels.levelIndexMap.find(levelName);
+            if (severityIt != levels.levelIndexMap.end()) {
+                configured[contextName] = levels.severitiesArray[severityIt->second];
+            } else {
+                configured[contextName] = limits && levelName.empty() ? ctxs.defaultSeverity : 0;
+            }
+            ctxs.contextNames.push_back(contextName);
+            const ContextId id = registry.findOrAdd(contextName);
+
+            if (limits && id != INVALID_CONTEXT_ID) {
+                limiter->setRules(id, readLimitRules(*limits, levels));
+            }
+        }
+    }
+    settings.rateLimiter = limiter->empty() ? nullptr : std::move(limiter);
+
+    // Existing ContextIds keep their meaning; re-derive every id's severity by
+    // name. Only this copy changes, so producers switch over with the snapshot.
+    const auto count = static_cast<ContextId>(registry.size());
+    settings.contextSeverities.assign(count, ctxs.defaultSeverity);
+    settings.defaultTypedLevelMask = typedLevelMaskFor(levels, ctxs.defaultSeverity);
+    settings.typedLevelMasks.assign(count, settings.defaultTypedLevelMask);
+    for (ContextId id = 0; id < count; ++id) {
+        const auto it = configured.find(std::string(registry.name(id)));
+        if (it == configured.end()) continue;
+        settings.contextSeverities[id] = it->second;
+        settings.typedLevelMasks[id] = typedLevelMaskFor(levels, it->second);
     }
 }
 
@@ -305,11 +479,36 @@ log_directory = "logs/"
 log_filename_format = "log_%Y-%m-%d_%H-%M-%S.txt"
 log_rotation_days = 7
 flush_mode = "instant"
+queue_mode = "deque"   # deque, ring or per_thread
+queue_capacity = 8192
+thread_queue_capacity = 1024
+file_buffer_size = 262144
+batch_size = 256
+mmap_segment_size = 67108864
+mmap_msync = "none"   # none, async or sync
+rotation_size = 104857600   # bytes, 0 = never rotate by size
+rotation_interval = 86400   # seconds, 0 = never rotate by time
+compress_rotated = true
+backpressure_policy = "block"   # block, drop_newest, drop_oldest or block_timeout
+queue_max_messages = 65536   # 0 = no limit
+queue_max_bytes = 67108864   # 0 = no limit
+block_timeout_ms = 100
+dispatch_mode = "serial"   # serial or fan_out (one thread per backend)
+backend_overflow_policy = "drop_oldest"   # fan_out, a backend's queue is full: drop_oldest or drop_newest
+wait_strategy = "adaptive"   # spin, adaptive (spin, yield, then sleep) or interval
+wait_spin_us = 50
+wait_interval_us = 1000
+crash_handler = false   # on SIGSEGV/SIGABRT/SIGBUS/SIGFPE write queued messages to the log file first
+shm_ring_name = "mylogger"   # ShmRingBackend / mylogger-collector segment prefix
+shm_ring_size = 4194304
+shm_poll_ms = 10
+suppression_report_interval = 10   # seconds between per-context "N messages suppressed" records
+coalesce_window_ms = 0   # fold consecutive identical messages into "last message repeated N times", 0 = off
 
 [format]
 log_timestamps = true
-timestamp_format = "ISO"
-log_format = "plain"
+timestamp_format = "ISO"   # ISO, ISO_MS, ISO_US, ISO_NS or a strftime pattern
+log_format = "plain"   # plain, json, logfmt or binary (decode with mylogger-decode)
 
 [backends]
 enable_console = true
@@ -350,6 +549,9 @@ CRITICAL  = "#FF0000FF"
 [colors.context]
 
 [contexts]
+# NAME = "LEVEL", or with sampling and a token-bucket rate (messages/second),
+# optionally overridden per level:
+# NETWORK = { level = "INFO", rate = 1000, burst = 5000, sample = 1.0, DEBUG = { sample = 0.01 } }
 )";
 
     std::cerr << "Default configuration created: " << filepath << "\n";
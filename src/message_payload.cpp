@@ -0,0 +1,69 @@
+#include "myLogger/message_payload.hpp"
+#include <new>
+
+namespace {
+
+    // Slabs this thread took over from the return lists, one list per class
+    struct SlabCache {
+        std::array<SlabArena::FreeSlab*, SlabArena::SLAB_SIZES.size()> free{};
+
+        ~SlabCache() {
+            for (std::size_t slabClass = 0; slabClass < free.size(); ++slabClass) {
+                if (free[slabClass]) SlabArena::instance().giveBack(slabClass, free[slabClass]);
+            }
+        }
+    };
+
+    thread_local SlabCache cache;
+
+} // namespace
+
+// Never destroyed: payloads still queued at exit (or held by thread_locals)
+// may hand their slabs back after static destructors have run.
+SlabArena& SlabArena::instance() {
+    static SlabArena* arena = new SlabArena();
+    return *arena;
+}
+
+char* SlabArena::acquire(std::size_t bytes) {
+    const std::size_t slabClass = sizeClass(bytes);
+    if (slabClass == SLAB_SIZES.size()) {
+        return new char[bytes];
+    }
+
+    FreeSlab*& local = cache.free[slabClass];
+    if (!local) {
+        // Only whole-list takeovers pop from `returned`, so there is no ABA
+        local = returned[slabClass].exchange(nullptr, std::memory_order_acquire);
+    }
+    if (!local) {
+        return new char[SLAB_SIZES[slabClass]];
+    }
+
+    FreeSlab* slab = local;
+    local = slab->next;
+    slab->~FreeSlab();
+    return reinterpret_cast<char*>(slab);
+}
+
+void SlabArena::release(char* slab, std::size_t bytes) {
+    const std::size_t slabClass = sizeClass(bytes);
+    if (slabClass == SLAB_SIZES.size()) {
+        delete[] slab;
+        return;
+    }
+
+    FreeSlab* node = new (slab) FreeSlab{nullptr};
+    giveBack(slabClass, node);
+}
+
+void SlabArena::giveBack(std::size_t slabClass, FreeSlab* first) {
+    FreeSlab* last = first;
+    while (last->next) last = last->next;
+
+    auto& head = returned[slabClass];
+    last->next = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(last->next, first,
+                                       std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
@@ -0,0 +1,89 @@
+#include "myLogger/rate_limiter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+    std::int64_t steadyNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Per-thread generator (splitmix64); seeded from the thread's own address
+    std::uint64_t nextRandom() {
+        thread_local std::uint64_t state = reinterpret_cast<std::uintptr_t>(&state) ^
+                                           static_cast<std::uint64_t>(steadyNs());
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Threads are spread over the shards in the order they first get suppressed
+    std::size_t shardIndex() {
+        static std::atomic<std::size_t> nextShard{0};
+        thread_local const std::size_t shard =
+            nextShard.fetch_add(1, std::memory_order_relaxed) % RateLimiter::SHARD_COUNT;
+        return shard;
+    }
+
+    // GCRA: a token is available while the arrival time is at most
+    // `tolerance` ahead of now
+    bool takeToken(std::atomic<std::int64_t>& arrival, std::int64_t intervalNs, std::int64_t toleranceNs) {
+        const std::int64_t now = steadyNs();
+        std::int64_t current = arrival.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::int64_t base = std::max(current, now);
+            if (base - now > toleranceNs) return false;
+            if (arrival.compare_exchange_weak(current, base + intervalNs, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Setup (config load)
+//------------------------------------------------------------------------------
+bool RateLimiter::setRules(ContextId context, const std::array<LimitRule, MAX_LEVELS>& rules) {
+    auto state = std::make_unique<ContextState>();
+    bool any = false;
+    for (std::size_t level = 0; level < MAX_LEVELS; ++level) {
+        const LimitRule& in = rules[level];
+        Rule& rule = state->rules[level];
+
+        if (in.rate > 0) {
+            const double burst = in.burst > 0 ? in.burst : std::max(in.rate, 1.0);
+            rule.intervalNs = std::max<std::int64_t>(static_cast<std::int64_t>(1e9 / in.rate), 1);
+            rule.toleranceNs = static_cast<std::int64_t>((std::max(burst, 1.0) - 1.0) * static_cast<double>(rule.intervalNs));
+        }
+        if (in.sample < 1) {
+            rule.sampled = true;
+            rule.sampleThreshold = in.sample > 0 ? static_cast<std::uint64_t>(std::ldexp(in.sample, 64)) : 0;
+        }
+        rule.limited = rule.intervalNs > 0 || rule.sampled;
+        any = any || rule.limited;
+    }
+    if (!any) return false;
+
+    if (contexts.size() <= context) contexts.resize(static_cast<std::size_t>(context) + 1);
+    contexts[context] = std::move(state);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Admission (producer threads)
+//------------------------------------------------------------------------------
+bool RateLimiter::admitLimited(ContextState& state, LevelId level) {
+    const Rule& rule = state.rules[level];
+    bool keep = !rule.sampled || nextRandom() < rule.sampleThreshold;
+    if (keep && rule.intervalNs > 0) {
+        keep = takeToken(state.buckets[level].arrival, rule.intervalNs, rule.toleranceNs);
+    }
+    if (!keep) {
+        state.shards[shardIndex()].suppressed[level].fetch_add(1, std::memory_order_relaxed);
+    }
+    return keep;
+}
@@ -0,0 +1,45 @@
+#include "myLogger/settings_snapshots.hpp"
+#include <algorithm>
+#include <utility>
+
+std::shared_ptr<const LoggerSettings> SettingsSnapshots::latest() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return snapshot;
+}
+
+void SettingsSnapshots::publish(std::shared_ptr<const LoggerSettings> next) {
+    std::shared_ptr<const LoggerSettings> previous;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        previous = std::exchange(snapshot, std::move(next));
+        publishedVersion.fetch_add(1, std::memory_order_release);
+    }
+    // `previous` is released here, outside the lock; threads still using it
+    // hold their own references.
+}
+
+// Slow path of current(): first use on this thread, or a newer snapshot
+const LoggerSettings& SettingsSnapshots::refresh() const {
+    struct Held {
+        std::uint64_t id;
+        std::shared_ptr<const LoggerSettings> snapshot;
+    };
+    thread_local std::vector<Held> held;   // one per cell this thread reads
+
+    auto entry = std::find_if(held.begin(), held.end(), [this](const auto& e) { return e.id == id; });
+    if (entry == held.end()) {
+        // Forget snapshots nobody else holds any more (reloaded or destroyed cells)
+        std::erase_if(held, [](const auto& e) { return e.snapshot.use_count() == 1; });
+        entry = held.insert(held.end(), {id, nullptr});
+    }
+
+    std::uint64_t version;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entry->snapshot = snapshot;
+        version = publishedVersion.load(std::memory_order_relaxed);
+    }
+
+    lastUsed[id % CACHE_SLOTS] = {id, version, entry->snapshot.get()};
+    return *entry->snapshot;
+}
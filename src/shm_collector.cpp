@@ -0,0 +1,136 @@
+#include "myLogger/shm_collector.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <csignal>
+#include <dirent.h>
+#endif
+
+namespace {
+
+    bool writerAlive(int pid) {
+#if defined(__unix__) || defined(__APPLE__)
+        return pid <= 0 || ::kill(pid, 0) == 0 || errno == EPERM;
+#else
+        (void)pid;
+        return true;
+#endif
+    }
+
+} // namespace
+
+ShmCollector::ShmCollector(const LoggerSettings& loggerSettings)
+    : settings(loggerSettings)
+{
+    // The merged file is the whole point, whatever the workers' config says
+    settings.config.backends.enableFile = true;
+    settings.config.levels.levelNames.reserve(MAX_LEVELS);   // internLevel() appends
+    output.setup(settings);
+}
+
+ShmCollector::~ShmCollector() {
+    output.shutdown();
+}
+
+//------------------------------------------------------------------------------
+// One Sweep: read every ring, write, then release what was written
+//------------------------------------------------------------------------------
+std::size_t ShmCollector::poll() {
+    discover();
+
+    batch.clear();
+    std::vector<bool> finished(sources.size());
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        auto& source = *sources[i];
+        // Checked before draining: whatever a closed ring published is visible now
+        finished[i] = source.ring.closed() || !writerAlive(source.ring.writerPid());
+
+        ShmRecord record;
+        while (source.ring.next(record)) {
+            auto& log = batch.emplace_back(internLevel(record.level), settings.addContext(record.context), record.text);
+            log.timeNs = record.timeNs;
+        }
+
+        source.dropped = source.ring.dropped();
+        const std::uint64_t reported = source.ring.droppedReported();
+        if (source.dropped != reported) {
+            auto& report = batch.emplace_back(settings.mostSevereLevel(), settings.addContext("LOGGER"),
+                                              std::to_string(source.dropped - reported) +
+                                              " messages dropped by pid " + std::to_string(source.ring.writerPid()) +
+                                              " (ring full)");
+            report.timeNs = currentTimeNs();
+        }
+    }
+
+    if (!batch.empty()) {
+        std::stable_sort(batch.begin(), batch.end(),
+                         [](const LogMessage& a, const LogMessage& b) { return a.timeNs < b.timeNs; });
+        if (settings.config.format.enableTimestamps) {
+            for (auto& log : batch) log.stampTime(settings.config.format.timestampFormat);
+        }
+        output.writeBatch(batch, settings);
+        output.flush();
+    }
+
+    for (std::size_t i = sources.size(); i-- > 0;) {
+        sources[i]->ring.commit(sources[i]->dropped);
+        if (finished[i]) {
+            sources[i]->ring.close();
+            ShmRing::unlink(sources[i]->name);
+            sources.erase(sources.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+    }
+    return batch.size();
+}
+
+void ShmCollector::run(const std::atomic<bool>& stop) {
+    const auto idle = std::chrono::milliseconds(std::max(settings.config.general.shmPollMs, 1));
+    while (!stop.load(std::memory_order_acquire)) {
+        // Keep sweeping while there is traffic; rest once the rings are empty
+        if (poll() == 0) std::this_thread::sleep_for(idle);
+    }
+    poll();
+}
+
+//------------------------------------------------------------------------------
+// Map Rings That Appeared Since the Last Sweep
+//------------------------------------------------------------------------------
+void ShmCollector::discover() {
+#if defined(__linux__)
+    DIR* directory = opendir("/dev/shm");
+    if (!directory) return;
+
+    const std::string prefix = settings.config.general.shmRingName + ".";
+    while (const dirent* entry = readdir(directory)) {
+        const std::string_view file = entry->d_name;
+        if (!file.starts_with(prefix)) continue;
+
+        const std::string name = "/" + std::string(file);
+        const bool known = std::any_of(sources.begin(), sources.end(),
+                                       [&name](const auto& source) { return source->name == name; });
+        if (known) continue;
+
+        // Fails while the writer is still initializing; the next sweep retries
+        auto source = std::make_unique<Source>();
+        if (!source->ring.attach(name)) continue;
+        source->name = name;
+        sources.push_back(std::move(source));
+    }
+    closedir(directory);
+#endif
+}
+
+// Names come from the writers' configs; unknown ones are added while there is room
+LevelId ShmCollector::internLevel(std::string_view name) {
+    const LevelId id = settings.findLevel(name);
+    if (id != INVALID_LEVEL_ID) return id;
+
+    auto& levels = settings.config.levels;
+    if (levels.levelNames.size() >= MAX_LEVELS) return INVALID_LEVEL_ID;
+    levels.levelIndexMap.emplace(std::string(name), static_cast<int>(levels.levelNames.size()));
+    levels.levelNames.emplace_back(name);
+    return static_cast<LevelId>(levels.levelNames.size() - 1);
+}
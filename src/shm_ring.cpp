@@ -0,0 +1,257 @@
+#include "myLogger/shm_ring.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MYLOGGER_HAS_SHM 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    constexpr std::size_t HEADER_BYTES = 4096;   // keeps the data area page-aligned
+    constexpr std::size_t RECORD_HEADER_BYTES = 16;
+    constexpr std::size_t MIN_CAPACITY = 4096;
+
+    static_assert(sizeof(ShmRingHeader) <= HEADER_BYTES);
+
+    struct RecordHeader {
+        std::uint32_t length;   // unpadded
+        std::uint16_t levelLength;
+        std::uint16_t contextLength;
+        std::int64_t timeNs;
+    };
+    static_assert(sizeof(RecordHeader) == RECORD_HEADER_BYTES);
+
+    constexpr std::uint64_t alignRecord(std::uint64_t size) {
+        return (size + 7) & ~std::uint64_t{7};
+    }
+
+} // namespace
+
+ShmRing::~ShmRing() {
+    close();
+}
+
+//------------------------------------------------------------------------------
+// Writer Side
+//------------------------------------------------------------------------------
+bool ShmRing::tryWrite(std::int64_t timeNs, std::string_view level, std::string_view context, std::string_view text) {
+    level = level.substr(0, UINT16_MAX);
+    context = context.substr(0, UINT16_MAX);
+
+    // A record may take at most a quarter of the ring; longer text is cut
+    const std::uint64_t maxRecord = capacity / 4;
+    const std::uint64_t fixed = RECORD_HEADER_BYTES + level.size() + context.size();
+    if (fixed + 8 > maxRecord) return false;
+    if (fixed + text.size() > maxRecord - 7) {
+        text = text.substr(0, maxRecord - 7 - fixed);
+    }
+
+    const std::uint64_t length = fixed + text.size();
+    const std::uint64_t size = alignRecord(length);
+    const std::uint64_t offset = localPos & mask;
+    const std::uint64_t untilEnd = capacity - offset;
+    const std::uint64_t needed = size > untilEnd ? size + untilEnd : size;
+
+    if (localPos + needed - cachedPos > capacity) {
+        cachedPos = header->readPos.load(std::memory_order_acquire);
+        if (localPos + needed - cachedPos > capacity) return false;
+    }
+
+    if (size > untilEnd) {
+        const std::uint32_t wrap = SHM_RECORD_WRAP | static_cast<std::uint32_t>(untilEnd);
+        std::memcpy(data + offset, &wrap, sizeof(wrap));
+        localPos += untilEnd;
+    }
+
+    char* out = data + (localPos & mask);
+    const RecordHeader record{static_cast<std::uint32_t>(length), static_cast<std::uint16_t>(level.size()),
+                              static_cast<std::uint16_t>(context.size()), timeNs};
+    std::memcpy(out, &record, sizeof(record));
+    out += sizeof(record);
+    std::memcpy(out, level.data(), level.size());
+    out += level.size();
+    std::memcpy(out, context.data(), context.size());
+    out += context.size();
+    std::memcpy(out, text.data(), text.size());
+
+    localPos += size;
+    return true;
+}
+
+void ShmRing::publish() {
+    if (header) header->writePos.store(localPos, std::memory_order_release);
+}
+
+void ShmRing::countDropped(std::uint64_t count) {
+    if (header) header->dropped.fetch_add(count, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// Reader Side
+//------------------------------------------------------------------------------
+bool ShmRing::next(ShmRecord& record) {
+    for (;;) {
+        if (localPos == cachedPos) {
+            cachedPos = header->writePos.load(std::memory_order_acquire);
+            if (localPos == cachedPos) return false;
+        }
+
+        const std::uint64_t offset = localPos & mask;
+        const std::uint64_t untilEnd = capacity - offset;
+        std::uint32_t length = 0;
+        std::memcpy(&length, data + offset, sizeof(length));
+        if (length & SHM_RECORD_WRAP) {
+            localPos += untilEnd;
+            continue;
+        }
+
+        RecordHeader fields{};
+        std::memcpy(&fields, data + offset, sizeof(fields));
+        const std::uint64_t used = RECORD_HEADER_BYTES + fields.levelLength + fields.contextLength;
+        const std::uint64_t size = alignRecord(length);
+        if (length < used || size > untilEnd || localPos + size > cachedPos) {
+            // Not something tryWrite() produced; give up on what is published
+            localPos = cachedPos;
+            return false;
+        }
+
+        const char* in = data + offset + RECORD_HEADER_BYTES;
+        record.timeNs = fields.timeNs;
+        record.level = {in, fields.levelLength};
+        record.context = {in + fields.levelLength, fields.contextLength};
+        record.text = {in + used - RECORD_HEADER_BYTES, length - used};
+
+        localPos += size;
+        return true;
+    }
+}
+
+void ShmRing::commit(std::uint64_t droppedReported) {
+    if (!header) return;
+    header->droppedReported.store(droppedReported, std::memory_order_relaxed);
+    header->readPos.store(localPos, std::memory_order_release);
+}
+
+std::uint64_t ShmRing::droppedReported() const {
+    return header ? header->droppedReported.load(std::memory_order_relaxed) : 0;
+}
+
+std::uint64_t ShmRing::dropped() const {
+    return header ? header->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+bool ShmRing::closed() const {
+    return header && header->closed.load(std::memory_order_acquire) != 0;
+}
+
+int ShmRing::writerPid() const {
+    return header ? header->pid : 0;
+}
+
+#if defined(MYLOGGER_HAS_SHM)
+
+//------------------------------------------------------------------------------
+// Segment Lifecycle
+//------------------------------------------------------------------------------
+bool ShmRing::create(const std::string& name, std::size_t requestedCapacity) {
+    close();
+
+    const std::size_t dataBytes = std::bit_ceil(std::max(requestedCapacity, MIN_CAPACITY));
+    if (dataBytes > SHM_RECORD_WRAP) return false;
+
+    // A segment by this name belongs to a process that no longer exists
+    shm_unlink(name.c_str());
+    const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) return false;
+
+    const std::size_t size = HEADER_BYTES + dataBytes;
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0 || !map(fd, size)) {
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+    ::close(fd);
+
+    // ftruncate() zero-filled the segment, so the atomics start at 0
+    header->version = SHM_RING_VERSION;
+    header->capacity = static_cast<std::uint32_t>(dataBytes);
+    header->pid = static_cast<std::int32_t>(getpid());
+    capacity = dataBytes;
+    mask = capacity - 1;
+    localPos = cachedPos = 0;
+    header->magic.store(SHM_RING_MAGIC, std::memory_order_release);
+    return true;
+}
+
+bool ShmRing::attach(const std::string& name) {
+    close();
+
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) return false;
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < HEADER_BYTES + MIN_CAPACITY ||
+        !map(fd, static_cast<std::size_t>(info.st_size))) {
+        ::close(fd);
+        return false;
+    }
+    ::close(fd);
+
+    const std::uint64_t dataBytes = header->capacity;
+    if (header->magic.load(std::memory_order_acquire) != SHM_RING_MAGIC || header->version != SHM_RING_VERSION ||
+        dataBytes < MIN_CAPACITY || (dataBytes & (dataBytes - 1)) != 0 || HEADER_BYTES + dataBytes > mappedSize) {
+        close();
+        return false;
+    }
+
+    capacity = dataBytes;
+    mask = capacity - 1;
+    localPos = header->readPos.load(std::memory_order_acquire);
+    cachedPos = localPos;
+    return true;
+}
+
+bool ShmRing::map(int fd, std::size_t size) {
+    // The reader writes too: readPos lives in the header
+    void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) return false;
+
+    header = static_cast<ShmRingHeader*>(addr);
+    data = static_cast<char*>(addr) + HEADER_BYTES;
+    mappedSize = size;
+    return true;
+}
+
+void ShmRing::close(bool markClosed) {
+    if (!header) return;
+
+    if (markClosed) {
+        publish();
+        header->closed.store(1, std::memory_order_release);
+    }
+    munmap(header, mappedSize);
+    header = nullptr;
+    data = nullptr;
+    mappedSize = 0;
+    capacity = mask = 0;
+}
+
+void ShmRing::unlink(const std::string& name) {
+    shm_unlink(name.c_str());
+}
+
+#else // !MYLOGGER_HAS_SHM
+
+bool ShmRing::create(const std::string&, std::size_t) { return false; }
+bool ShmRing::attach(const std::string&) { return false; }
+bool ShmRing::map(int, std::size_t) { return false; }
+void ShmRing::close(bool) {}
+void ShmRing::unlink(const std::string&) {}
+
+#endif // MYLOGGER_HAS_SHM
@@ -0,0 +1,138 @@
+#include "myLogger/structured_format.hpp"
+#include <charconv>
+#include <cmath>
+
+namespace {
+
+    template <typename T>
+    void appendNumber(T value, std::string& out) {
+        char buf[32];
+        const auto result = std::to_chars(buf, buf + sizeof(buf), value);
+        out.append(buf, result.ptr);
+    }
+
+    // Keys are written bare in logfmt; anything that would end one becomes '_'
+    void appendLogfmtKey(std::string_view key, std::string& out) {
+        for (const char c : key) {
+            const auto byte = static_cast<unsigned char>(c);
+            out += (byte <= ' ' || c == '=' || c == '"' || byte == 0x7F) ? '_' : c;
+        }
+    }
+
+    void appendJsonValue(const FieldValue& value, std::string& out) {
+        switch (value.type) {
+            case FieldType::Int:    appendNumber(value.i, out); break;
+            case FieldType::UInt:   appendNumber(value.u, out); break;
+            case FieldType::Bool:   out += value.u ? "true" : "false"; break;
+            case FieldType::Double:
+                if (std::isfinite(value.d)) {
+                    appendNumber(value.d, out);
+                } else {
+                    out += "null";   // JSON has no NaN or infinity
+                }
+                break;
+            case FieldType::String:
+                out += '"';
+                appendJsonEscaped(value.s, out);
+                out += '"';
+                break;
+        }
+    }
+
+    void appendLogfmtFieldValue(const FieldValue& value, std::string& out) {
+        switch (value.type) {
+            case FieldType::Int:    appendNumber(value.i, out); break;
+            case FieldType::UInt:   appendNumber(value.u, out); break;
+            case FieldType::Bool:   out += value.u ? "true" : "false"; break;
+            case FieldType::Double: appendNumber(value.d, out); break;
+            case FieldType::String: appendLogfmtValue(value.s, out); break;
+        }
+    }
+
+    void appendJsonMember(std::string_view key, std::string_view text, std::string& out) {
+        out += '"';
+        out += key;
+        out += "\":\"";
+        appendJsonEscaped(text, out);
+        out += '"';
+    }
+
+    void appendLogfmtPair(std::string_view key, std::string_view text, std::string& out) {
+        out += key;
+        out += '=';
+        appendLogfmtValue(text, out);
+    }
+
+} // namespace
+
+LogFormat parseLogFormat(std::string_view name) {
+    if (name == "json") return LogFormat::Json;
+    if (name == "logfmt") return LogFormat::Logfmt;
+    if (name == "binary") return LogFormat::Binary;
+    return LogFormat::Plain;
+}
+
+void appendPlainFields(const LogFields& fields, std::string& out) {
+    fields.forEach([&out](std::string_view key, const FieldValue& value) {
+        out += ' ';
+        appendLogfmtKey(key, out);
+        out += '=';
+        appendLogfmtFieldValue(value, out);
+    });
+}
+
+//------------------------------------------------------------------------------
+// Whole Lines
+//------------------------------------------------------------------------------
+void appendRecordLine(LogFormat format, std::string_view timestamp, std::string_view level,
+                      std::string_view context, std::string_view message, const LogFields& fields,
+                      std::string& out) {
+    switch (format) {
+        case LogFormat::Json:
+            out += '{';
+            if (!timestamp.empty()) {
+                appendJsonMember("time", timestamp, out);
+                out += ',';
+            }
+            appendJsonMember("level", level, out);
+            out += ',';
+            appendJsonMember("context", context, out);
+            out += ',';
+            appendJsonMember("msg", message, out);
+            fields.forEach([&out](std::string_view key, const FieldValue& value) {
+                out += ",\"";
+                appendJsonEscaped(key, out);
+                out += "\":";
+                appendJsonValue(value, out);
+            });
+            out += "}\n";
+            break;
+
+        case LogFormat::Logfmt:
+            if (!timestamp.empty()) {
+                appendLogfmtPair("time", timestamp, out);
+                out += ' ';
+            }
+            appendLogfmtPair("level", level, out);
+            out += ' ';
+            appendLogfmtPair("context", context, out);
+            out += ' ';
+            appendLogfmtPair("msg", message, out);
+            appendPlainFields(fields, out);
+            out += '\n';
+            break;
+
+        case LogFormat::Plain:
+        case LogFormat::Binary:
+            out += timestamp;
+            out += " [";
+            out += level;
+            out += "] ";
+            out += context;
+            out += ": ";
+            out += message;
+            appendPlainFields(fields, out);
+            out += '\n';
+            break;
+    }
+}
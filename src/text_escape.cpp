@@ -0,0 +1,355 @@
+#include "myLogger/text_escape.hpp"
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__)) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MYLOGGER_HAS_SSE2 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define MYLOGGER_HAS_AVX2 1
+#define MYLOGGER_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER)
+#define MYLOGGER_HAS_AVX2 1
+#define MYLOGGER_TARGET_AVX2
+#include <intrin.h>
+#endif
+#endif
+
+namespace {
+
+    enum class ByteClass {
+        Json,
+        Logfmt,
+        Terminal,
+        NonAscii
+    };
+
+    constexpr char REPLACEMENT_CHARACTER[] = "\xEF\xBF\xBD";   // U+FFFD
+    constexpr char HEX[] = "0123456789abcdef";
+
+    //--------------------------------------------------------------------------
+    // Scalar: the reference for the vector kernels
+    //--------------------------------------------------------------------------
+    template <ByteClass C>
+    constexpr bool isSpecial(unsigned char c) {
+        if constexpr (C == ByteClass::Json) {
+            return c < 0x20 || c == '"' || c == '\\' || c >= 0x7F;
+        } else if constexpr (C == ByteClass::Logfmt) {
+            return c <= ' ' || c == '=' || c == '"' || c == '\\' || c >= 0x7F;
+        } else if constexpr (C == ByteClass::Terminal) {
+            return (c < 0x20 && c != '\t') || c >= 0x7F;
+        } else {
+            return c >= 0x80;
+        }
+    }
+
+    template <ByteClass C>
+    std::size_t findScalar(const char* data, std::size_t size, std::size_t from) {
+        for (; from < size; ++from) {
+            if (isSpecial<C>(static_cast<unsigned char>(data[from]))) return from;
+        }
+        return size;
+    }
+
+#if defined(MYLOGGER_HAS_SSE2)
+    //--------------------------------------------------------------------------
+    // SSE2: signed compares, so "< 0x20" also catches every byte >= 0x80
+    //--------------------------------------------------------------------------
+    template <ByteClass C>
+    unsigned specialMask(__m128i v) {
+        if constexpr (C == ByteClass::NonAscii) {
+            return static_cast<unsigned>(_mm_movemask_epi8(v));
+        } else {
+            const auto is = [v](char c) { return _mm_cmpeq_epi8(v, _mm_set1_epi8(c)); };
+            __m128i mask = is(0x7F);
+            if constexpr (C == ByteClass::Json) {
+                mask = _mm_or_si128(mask, _mm_cmplt_epi8(v, _mm_set1_epi8(0x20)));
+                mask = _mm_or_si128(mask, _mm_or_si128(is('"'), is('\\')));
+            } else if constexpr (C == ByteClass::Logfmt) {
+                mask = _mm_or_si128(mask, _mm_cmplt_epi8(v, _mm_set1_epi8(0x21)));
+                mask = _mm_or_si128(mask, _mm_or_si128(is('"'), is('\\')));
+                mask = _mm_or_si128(mask, is('='));
+            } else {
+                mask = _mm_or_si128(mask, _mm_andnot_si128(is('\t'), _mm_cmplt_epi8(v, _mm_set1_epi8(0x20))));
+            }
+            return static_cast<unsigned>(_mm_movemask_epi8(mask));
+        }
+    }
+
+    template <ByteClass C>
+    std::size_t findSse2(const char* data, std::size_t size, std::size_t from) {
+        for (; from + 16 <= size; from += 16) {
+            const unsigned mask = specialMask<C>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + from)));
+            if (mask != 0) return from + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+        return findScalar<C>(data, size, from);
+    }
+#endif
+
+#if defined(MYLOGGER_HAS_AVX2)
+    //--------------------------------------------------------------------------
+    // AVX2: same masks over 32 bytes; the tail goes through SSE2
+    //--------------------------------------------------------------------------
+    template <ByteClass C>
+    MYLOGGER_TARGET_AVX2 unsigned specialMask(__m256i v) {
+        if constexpr (C == ByteClass::NonAscii) {
+            return static_cast<unsigned>(_mm256_movemask_epi8(v));
+        } else {
+            const auto is = [v](char c) MYLOGGER_TARGET_AVX2 { return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c)); };
+            const auto below = [v](char c) MYLOGGER_TARGET_AVX2 { return _mm256_cmpgt_epi8(_mm256_set1_epi8(c), v); };
+            __m256i mask = is(0x7F);
+            if constexpr (C == ByteClass::Json) {
+                mask = _mm256_or_si256(mask, below(0x20));
+                mask = _mm256_or_si256(mask, _mm256_or_si256(is('"'), is('\\')));
+            } else if constexpr (C == ByteClass::Logfmt) {
+                mask = _mm256_or_si256(mask, below(0x21));
+                mask = _mm256_or_si256(mask, _mm256_or_si256(is('"'), is('\\')));
+                mask = _mm256_or_si256(mask, is('='));
+            } else {
+                mask = _mm256_or_si256(mask, _mm256_andnot_si256(is('\t'), below(0x20)));
+            }
+            return static_cast<unsigned>(_mm256_movemask_epi8(mask));
+        }
+    }
+
+    template <ByteClass C>
+    MYLOGGER_TARGET_AVX2 std::size_t findAvx2(const char* data, std::size_t size, std::size_t from) {
+        for (; from + 32 <= size; from += 32) {
+            const unsigned mask = specialMask<C>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + from)));
+            if (mask != 0) return from + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+        // The compiler leaves out vzeroupper before a tail call; legacy SSE
+        // code after dirty upper halves runs many times slower
+        _mm256_zeroupper();
+        return findSse2<C>(data, size, from);
+    }
+
+    bool cpuHasAvx2() {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#else
+        int regs[4];
+        __cpuid(regs, 0);
+        if (regs[0] < 7) return false;
+        __cpuid(regs, 1);
+        const bool osxsave = (regs[2] & (1 << 27)) != 0;
+        const bool avx = (regs[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;   // OS saves YMM state
+        __cpuidex(regs, 7, 0);
+        return (regs[1] & (1 << 5)) != 0;
+#endif
+    }
+#endif
+
+    //--------------------------------------------------------------------------
+    // Kernel Tables
+    //--------------------------------------------------------------------------
+    constexpr EscapeKernel SCALAR_KERNEL{
+        SimdLevel::Scalar,
+        findScalar<ByteClass::Json>,
+        findScalar<ByteClass::Logfmt>,
+        findScalar<ByteClass::Terminal>,
+        findScalar<ByteClass::NonAscii>,
+    };
+
+#if defined(MYLOGGER_HAS_SSE2)
+    constexpr EscapeKernel SSE2_KERNEL{
+        SimdLevel::Sse2,
+        findSse2<ByteClass::Json>,
+        findSse2<ByteClass::Logfmt>,
+        findSse2<ByteClass::Terminal>,
+        findSse2<ByteClass::NonAscii>,
+    };
+#endif
+
+#if defined(MYLOGGER_HAS_AVX2)
+    constexpr EscapeKernel AVX2_KERNEL{
+        SimdLevel::Avx2,
+        findAvx2<ByteClass::Json>,
+        findAvx2<ByteClass::Logfmt>,
+        findAvx2<ByteClass::Terminal>,
+        findAvx2<ByteClass::NonAscii>,
+    };
+#endif
+
+    const EscapeKernel& detectKernel() {
+#if defined(MYLOGGER_HAS_AVX2)
+        if (cpuHasAvx2()) return AVX2_KERNEL;
+#endif
+#if defined(MYLOGGER_HAS_SSE2)
+        return SSE2_KERNEL;
+#else
+        return SCALAR_KERNEL;
+#endif
+    }
+
+    //--------------------------------------------------------------------------
+    // Shared Escape Loop
+    //--------------------------------------------------------------------------
+    // Unmarked bytes and valid UTF-8 sequences are appended in runs; ASCII
+    // specials go through `escape`, and invalid UTF-8 bytes become U+FFFD.
+    template <typename Escape>
+    void appendEscapedRuns(std::string_view text, std::string& out,
+                           std::size_t (*find)(const char*, std::size_t, std::size_t), Escape escape) {
+        const char* data = text.data();
+        const std::size_t size = text.size();
+        std::size_t runStart = 0;
+        std::size_t i = find(data, size, 0);
+        while (i < size) {
+            const auto c = static_cast<unsigned char>(data[i]);
+            if (c >= 0x80) {
+                const std::size_t length = utf8SequenceLength(text.substr(i));
+                if (length != 0) {
+                    i = find(data, size, i + length);
+                    continue;
+                }
+                out.append(data + runStart, i - runStart);
+                out.append(REPLACEMENT_CHARACTER, 3);
+            } else {
+                out.append(data + runStart, i - runStart);
+                escape(c, out);
+            }
+            runStart = i + 1;
+            i = find(data, size, runStart);
+        }
+        out.append(data + runStart, size - runStart);
+    }
+
+    void escapeJsonByte(unsigned char c, std::string& out) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default: {
+                const char escape[] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]};
+                out.append(escape, sizeof(escape));
+            }
+        }
+    }
+
+    void escapeTerminalByte(unsigned char c, std::string& out) {
+        const char escape[] = {'\\', 'x', HEX[c >> 4], HEX[c & 0xF]};
+        out.append(escape, sizeof(escape));
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Kernel Selection
+//------------------------------------------------------------------------------
+const EscapeKernel& escapeKernel() {
+    static const EscapeKernel& kernel = detectKernel();
+    return kernel;
+}
+
+const EscapeKernel* escapeKernelFor(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar:
+            return &SCALAR_KERNEL;
+        case SimdLevel::Sse2:
+#if defined(MYLOGGER_HAS_SSE2)
+            return &SSE2_KERNEL;
+#else
+            return nullptr;
+#endif
+        case SimdLevel::Avx2:
+#if defined(MYLOGGER_HAS_AVX2)
+            return cpuHasAvx2() ? &AVX2_KERNEL : nullptr;
+#else
+            return nullptr;
+#endif
+    }
+    return nullptr;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::Sse2:   return "sse2";
+        case SimdLevel::Avx2:   return "avx2";
+    }
+    return "unknown";
+}
+
+//------------------------------------------------------------------------------
+// UTF-8 Validation
+//------------------------------------------------------------------------------
+// Well-formed sequences only (Unicode table 3-7): no overlong forms, no
+// surrogates, nothing above U+10FFFF
+std::size_t utf8SequenceLength(std::string_view text) {
+    if (text.empty()) return 0;
+    const auto byte = [&text](std::size_t i) { return static_cast<unsigned char>(text[i]); };
+    const unsigned char lead = byte(0);
+    if (lead < 0x80) return 1;
+
+    std::size_t length;
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;   // bounds for the second byte
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (lead == 0xE0) low = 0xA0;
+        if (lead == 0xED) high = 0x9F;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (lead == 0xF0) low = 0x90;
+        if (lead == 0xF4) high = 0x8F;
+    } else {
+        return 0;
+    }
+
+    if (text.size() < length) return 0;
+    if (byte(1) < low || byte(1) > high) return 0;
+    for (std::size_t i = 2; i < length; ++i) {
+        if ((byte(i) & 0xC0) != 0x80) return 0;
+    }
+    return length;
+}
+
+bool isValidUtf8(std::string_view text, const EscapeKernel& kernel) {
+    std::size_t i = kernel.findNonAscii(text.data(), text.size(), 0);
+    while (i < text.size()) {
+        const std::size_t length = utf8SequenceLength(text.substr(i));
+        if (length == 0) return false;
+        i = kernel.findNonAscii(text.data(), text.size(), i + length);
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Escaping
+//------------------------------------------------------------------------------
+void appendJsonEscaped(std::string_view text, std::string& out, const EscapeKernel& kernel) {
+    appendEscapedRuns(text, out, kernel.findJsonSpecial, escapeJsonByte);
+}
+
+void appendLogfmtValue(std::string_view text, std::string& out, const EscapeKernel& kernel) {
+    // Non-ASCII alone does not need quotes, but invalid UTF-8 is replaced, which does
+    bool quote = text.empty();
+    std::size_t i = kernel.findLogfmtSpecial(text.data(), text.size(), 0);
+    while (!quote && i < text.size()) {
+        if (static_cast<unsigned char>(text[i]) < 0x80) {
+            quote = true;
+            break;
+        }
+        const std::size_t length = utf8SequenceLength(text.substr(i));
+        quote = length == 0;
+        i = kernel.findLogfmtSpecial(text.data(), text.size(), i + (length ? length : 1));
+    }
+
+    if (!quote) {
+        out += text;
+        return;
+    }
+    out += '"';
+    appendJsonEscaped(text, out, kernel);
+    out += '"';
+}
+
+void appendTerminalSafe(std::string_view text, std::string& out, const EscapeKernel& kernel) {
+    appendEscapedRuns(text, out, kernel.findTerminalSpecial, escapeTerminalByte);
+}
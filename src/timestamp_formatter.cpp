@@ -0,0 +1,204 @@
+#include "myLogger/timestamp_formatter.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+namespace {
+
+    constexpr std::int64_t NANOS_PER_SECOND = 1'000'000'000;
+    constexpr std::int64_t OFFSET_RECHECK_SECONDS = 15 * 60;
+
+    std::int64_t floorDiv(std::int64_t a, std::int64_t b) {
+        std::int64_t q = a / b;
+        if ((a % b != 0) && ((a < 0) != (b < 0))) --q;
+        return q;
+    }
+
+    //--------------------------------------------------------------------------
+    // Civil calendar arithmetic (proleptic Gregorian, H. Hinnant's algorithms)
+    //--------------------------------------------------------------------------
+    std::int64_t daysFromCivil(std::int64_t y, unsigned m, unsigned d) {
+        y -= m <= 2;
+        const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+        const auto yoe = static_cast<unsigned>(y - era * 400);
+        const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+    }
+
+    std::tm civilFromLocalSeconds(std::int64_t local) {
+        const std::int64_t days = floorDiv(local, 86400);
+        const std::int64_t secondOfDay = local - days * 86400;
+
+        const std::int64_t z = days + 719468;
+        const std::int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+        const auto doe = static_cast<unsigned>(z - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const unsigned d = doy - (153 * mp + 2) / 5 + 1;
+        const unsigned m = mp < 10 ? mp + 3 : mp - 9;
+        const std::int64_t y = static_cast<std::int64_t>(yoe) + era * 400 + (m <= 2);
+
+        std::tm tm{};
+        tm.tm_year = static_cast<int>(y - 1900);
+        tm.tm_mon  = static_cast<int>(m - 1);
+        tm.tm_mday = static_cast<int>(d);
+        tm.tm_hour = static_cast<int>(secondOfDay / 3600);
+        tm.tm_min  = static_cast<int>(secondOfDay / 60 % 60);
+        tm.tm_sec  = static_cast<int>(secondOfDay % 60);
+        tm.tm_wday = static_cast<int>(((days + 4) % 7 + 7) % 7);   // 1970-01-01 was a Thursday
+        tm.tm_yday = static_cast<int>(days - daysFromCivil(y, 1, 1));
+        tm.tm_isdst = -1;
+        return tm;
+    }
+
+    // Broken-down local time, with tm_isdst (and tm_gmtoff/tm_zone where the
+    // platform has them) filled in for strftime's %z and %Z
+    std::tm localTime(std::int64_t second) {
+        const auto t = static_cast<std::time_t>(second);
+        std::tm tm{};
+#if defined(_WIN32)
+        localtime_s(&tm, &t);
+#else
+        localtime_r(&t, &tm);
+#endif
+        return tm;
+    }
+
+    // Local time minus UTC at `second`, in seconds
+    std::int64_t utcOffsetAt(std::int64_t second) {
+        const std::tm tm = localTime(second);
+        const std::int64_t localAsUtc = daysFromCivil(tm.tm_year + 1900, static_cast<unsigned>(tm.tm_mon + 1),
+                                                      static_cast<unsigned>(tm.tm_mday)) * 86400
+                                      + tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+        return localAsUtc - second;
+    }
+
+    //--------------------------------------------------------------------------
+    // Per-thread cache of the formatted prefix for the current second
+    //--------------------------------------------------------------------------
+    struct TimestampCache {
+        std::string format;
+        bool iso = true;
+        int fractionDigits = 0;
+        std::int64_t fractionDivisor = NANOS_PER_SECOND;
+
+        std::int64_t second = INT64_MIN;
+        char prefix[MAX_TIMESTAMP_LENGTH] = {};
+        std::size_t prefixLength = 0;
+
+        std::int64_t utcOffset = 0;
+        std::int64_t offsetValidFrom = 1;   // empty range until first lookup
+        std::int64_t offsetValidUntil = 0;
+
+        void setFormat(std::string_view newFormat) {
+            format.assign(newFormat);
+            second = INT64_MIN;
+            iso = true;
+            if (format == "ISO")          { fractionDigits = 0; }
+            else if (format == "ISO_MS")  { fractionDigits = 3; }
+            else if (format == "ISO_US")  { fractionDigits = 6; }
+            else if (format == "ISO_NS")  { fractionDigits = 9; }
+            else                          { fractionDigits = 0; iso = false; }
+
+            fractionDivisor = 1;
+            for (int i = fractionDigits; i < 9; ++i) fractionDivisor *= 10;
+        }
+
+        void rebuildPrefix(std::int64_t newSecond) {
+            if (iso) {
+                if (newSecond < offsetValidFrom || newSecond >= offsetValidUntil) {
+                    utcOffset = utcOffsetAt(newSecond);
+                    offsetValidFrom = floorDiv(newSecond, OFFSET_RECHECK_SECONDS) * OFFSET_RECHECK_SECONDS;
+                    offsetValidUntil = offsetValidFrom + OFFSET_RECHECK_SECONDS;
+                }
+                const std::tm tm = civilFromLocalSeconds(newSecond + utcOffset);
+                char* p = prefix;
+                p = writeFixedDigits(p, static_cast<std::uint32_t>(tm.tm_year + 1900), 4); *p++ = '-';
+                p = writeFixedDigits(p, static_cast<std::uint32_t>(tm.tm_mon + 1), 2);     *p++ = '-';
+                p = writeFixedDigits(p, static_cast<std::uint32_t>(tm.tm_mday), 2);        *p++ = 'T';
+                p = writeFixedDigits(p, static_cast<std::uint32_t>(tm.tm_hour), 2);        *p++ = ':';
+                p = writeFixedDigits(p, static_cast<std::uint32_t>(tm.tm_min), 2);         *p++ = ':';
+                p = writeFixedDigits(p, static_cast<std::uint32_t>(tm.tm_sec), 2);
+                prefixLength = static_cast<std::size_t>(p - prefix);
+            } else {
+                // Patterns may use %z or %Z, which need the zone localtime_r reports
+                const std::tm tm = localTime(newSecond);
+                prefixLength = std::strftime(prefix, sizeof(prefix), format.c_str(), &tm);
+            }
+            second = newSecond;
+        }
+    };
+
+    thread_local TimestampCache cache;
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Format Timestamp
+//------------------------------------------------------------------------------
+std::size_t formatTimestamp(std::int64_t timeNs, std::string_view format, char* out, std::size_t capacity) {
+    if (format != cache.format) {
+        cache.setFormat(format);
+    }
+
+    const std::int64_t second = floorDiv(timeNs, NANOS_PER_SECOND);
+    if (second != cache.second) {
+        cache.rebuildPrefix(second);
+    }
+
+    char buf[MAX_TIMESTAMP_LENGTH + 16];
+    std::memcpy(buf, cache.prefix, cache.prefixLength);
+    char* p = buf + cache.prefixLength;
+    if (cache.fractionDigits > 0) {
+        const auto fraction = static_cast<std::uint32_t>((timeNs - second * NANOS_PER_SECOND) / cache.fractionDivisor);
+        *p++ = '.';
+        p = writeFixedDigits(p, fraction, cache.fractionDigits);
+    }
+
+    const std::size_t length = std::min(static_cast<std::size_t>(p - buf), capacity);
+    std::memcpy(out, buf, length);
+    return length;
+}
+
+std::int64_t localUtcOffset(std::int64_t timeNs) {
+    return utcOffsetAt(floorDiv(timeNs, NANOS_PER_SECOND));
+}
+
+//------------------------------------------------------------------------------
+// Format Timestamp at a Fixed Offset (async-signal-safe)
+//------------------------------------------------------------------------------
+std::size_t formatTimestampAtOffset(std::int64_t timeNs, std::int64_t utcOffset, std::string_view format,
+                                    char* out, std::size_t capacity) {
+    int fractionDigits = 9;
+    if (format == "ISO")          fractionDigits = 0;
+    else if (format == "ISO_MS")  fractionDigits = 3;
+    else if (format == "ISO_US")  fractionDigits = 6;
+
+    std::int64_t fractionDivisor = 1;
+    for (int i = fractionDigits; i < 9; ++i) fractionDivisor *= 10;
+
+    const std::int64_t second = floorDiv(timeNs, NANOS_PER_SECOND);
+    const std::tm tm = civilFromLocalSeconds(second + utcOffset);
+
+    char buf[MAX_TIMESTAMP_LENGTH + 16];
+    char* p = buf;
+    p = writeFixedDigits(p, static_cast<std::uint32_t>(tm.tm_year + 1900), 4); *p++ = '-';
+    p = writeFixedDigits(p, static_cast<std::uint32_t>(tm.tm_mon + 1), 2);     *p++ = '-';
+    p = writeFixedDigits(p, static_cast<std::uint32_t>(tm.tm_mday), 2);        *p++ = 'T';
+    p = writeFixedDigits(p, static_cast<std::uint32_t>(tm.tm_hour), 2);        *p++ = ':';
+    p = writeFixedDigits(p, static_cast<std::uint32_t>(tm.tm_min), 2);         *p++ = ':';
+    p = writeFixedDigits(p, static_cast<std::uint32_t>(tm.tm_sec), 2);
+    if (fractionDigits > 0) {
+        *p++ = '.';
+        p = writeFixedDigits(p, static_cast<std::uint32_t>((timeNs - second * NANOS_PER_SECOND) / fractionDivisor),
+                             fractionDigits);
+    }
+
+    const std::size_t length = std::min(static_cast<std::size_t>(p - buf), capacity);
+    std::memcpy(out, buf, length);
+    return length;
+}
@@ -0,0 +1,323 @@
+#include "myLogger/logger.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    const std::filesystem::path DIR = std::filesystem::temp_directory_path() / "mylogger_backpressure_test";
+
+    // Holds the consumer inside write() until opened, so the queue fills up
+    class GateBackend {
+    public:
+        struct Entry {
+            std::string context;
+            std::string message;
+        };
+
+        void setup([[maybe_unused]] const LoggerSettings& settings) {}
+
+        void write(const LogMessage& log, const LoggerSettings& settings) {
+            std::unique_lock<std::mutex> lock(mutex);
+            entries.push_back({std::string(settings.contextName(log.context)), std::string(log.message.view())});
+            changed.notify_all();
+            changed.wait(lock, [this] { return open; });
+        }
+
+        void waitForEntries(std::size_t count) {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return entries.size() >= count; });
+        }
+
+        void openGate() {
+            std::lock_guard<std::mutex> lock(mutex);
+            open = true;
+            changed.notify_all();
+        }
+
+        std::vector<Entry> written() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return entries;
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::vector<Entry> entries;
+        bool open = false;
+    };
+
+    std::shared_ptr<LoggerSettings> makeSettings(const std::string& policy, int maxMessages, int timeoutMs = 0) {
+        std::filesystem::create_directories(DIR);
+        auto settings = std::make_shared<LoggerSettings>();
+        settings->configPath = (DIR / (policy + ".conf")).string();
+        std::ofstream config(settings->configPath, std::ios::trunc);
+        config << "[general]\n"
+               << "log_directory = \"" << DIR.string() << "\"\n"
+               << "queue_mode = \"deque\"\n"
+               << "backpressure_policy = \"" << policy << "\"\n"
+               << "queue_max_messages = " << maxMessages << "\n"
+               << "queue_max_bytes = 0\n"
+               << "block_timeout_ms = " << timeoutMs << "\n"
+               << "[backends]\nenable_console = false\nenable_file = false\n"
+               << "[levels]\nDEBUG = \"ON\"\nINFO = \"ON\"\nERROR = \"ON\"\n"
+               << "[severities]\nDEBUG = 2\nINFO = 3\nERROR = 5\n"
+               << "[contexts]\nAPP = \"DEBUG\"\n";
+        return settings;
+    }
+
+    // Logs one message and waits until the consumer is stuck writing it; the
+    // queue is empty from then on
+    void stall(Logger<GateBackend>& logger, GateBackend& backend) {
+        logger.log(logger.level("INFO"), logger.context("APP"), "stall");
+        backend.waitForEntries(1);
+    }
+
+    // Counts what it is given and never holds the writer up
+    class CountingBackend {
+    public:
+        void setup([[maybe_unused]] const LoggerSettings& settings) {}
+
+        void write([[maybe_unused]] const LogMessage& log, [[maybe_unused]] const LoggerSettings& settings) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++count;
+            changed.notify_all();
+        }
+
+        bool waitFor(std::size_t expected, std::chrono::seconds timeout) {
+            std::unique_lock<std::mutex> lock(mutex);
+            return changed.wait_for(lock, timeout, [&] { return count >= expected; });
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::size_t count = 0;
+    };
+
+    std::vector<std::string> messages(const std::vector<GateBackend::Entry>& entries, const std::string& context) {
+        std::vector<std::string> result;
+        for (const auto& entry : entries) {
+            if (entry.context == context) result.push_back(entry.message);
+        }
+        return result;
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ drop_newest: the queue keeps the first messages; the rest are counted
+//    per level and reported once in a "N messages dropped" record
+//------------------------------------------------------------------------------
+TEST(Backpressure, DropNewest) {
+    GateBackend backend;
+    Logger<GateBackend> logger(makeSettings("drop_newest", 4), backend);
+    const ContextId app = logger.context("APP");
+    stall(logger, backend);
+
+    for (int i = 0; i < 4; ++i) logger.log(logger.level("INFO"), app, "kept {}", i);
+    for (int i = 0; i < 3; ++i) logger.log(logger.level("DEBUG"), app, "debug {}", i);
+    for (int i = 0; i < 3; ++i) logger.log(logger.level("ERROR"), app, "error {}", i);
+
+    EXPECT_EQ(logger.droppedMessages(), 6u);
+    EXPECT_EQ(logger.droppedMessages(logger.level("INFO")), 0u);
+    EXPECT_EQ(logger.droppedMessages(logger.level("DEBUG")), 3u);
+    EXPECT_EQ(logger.droppedMessages(logger.level("ERROR")), 3u);
+
+    backend.openGate();
+    logger.shutdown();
+
+    const auto entries = backend.written();
+    EXPECT_EQ(messages(entries, "APP"),
+              (std::vector<std::string>{"stall", "kept 0", "kept 1", "kept 2", "kept 3"}));
+    const auto reports = messages(entries, "LOGGER");
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_EQ(reports[0].rfind("6 messages dropped (", 0), 0u) << reports[0];
+    EXPECT_NE(reports[0].find("DEBUG: 3"), std::string::npos) << reports[0];
+    EXPECT_NE(reports[0].find("ERROR: 3"), std::string::npos) << reports[0];
+    EXPECT_EQ(reports[0].find("INFO"), std::string::npos) << reports[0];
+
+    std::filesystem::remove_all(DIR);
+}
+
+// ✅ drop_oldest: every new message evicts the head, so the newest survive
+TEST(Backpressure, DropOldest) {
+    GateBackend backend;
+    Logger<GateBackend> logger(makeSettings("drop_oldest", 4), backend);
+    const ContextId app = logger.context("APP");
+    stall(logger, backend);
+
+    for (int i = 0; i < 10; ++i) logger.log(logger.level("INFO"), app, "message {}", i);
+    EXPECT_EQ(logger.droppedMessages(logger.level("INFO")), 6u);
+
+    backend.openGate();
+    logger.shutdown();
+
+    const auto entries = backend.written();
+    EXPECT_EQ(messages(entries, "APP"),
+              (std::vector<std::string>{"stall", "message 6", "message 7", "message 8", "message 9"}));
+    EXPECT_EQ(messages(entries, "LOGGER"), (std::vector<std::string>{"6 messages dropped (INFO: 6)"}));
+
+    std::filesystem::remove_all(DIR);
+}
+
+//------------------------------------------------------------------------------
+// ✅ block_timeout: a full queue holds the producer for block_timeout_ms,
+//    then the message is dropped
+//------------------------------------------------------------------------------
+TEST(Backpressure, BlockTimeoutDrops) {
+    GateBackend backend;
+    Logger<GateBackend> logger(makeSettings("block_timeout", 2, 50), backend);
+    const ContextId app = logger.context("APP");
+    stall(logger, backend);
+
+    logger.log(logger.level("INFO"), app, "queued 0");
+    logger.log(logger.level("INFO"), app, "queued 1");
+    const auto start = std::chrono::steady_clock::now();
+    logger.log(logger.level("ERROR"), app, "timed out");
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(45));
+    EXPECT_EQ(logger.droppedMessages(logger.level("ERROR")), 1u);
+
+    backend.openGate();
+    logger.shutdown();
+
+    const auto entries = backend.written();
+    EXPECT_EQ(messages(entries, "APP"), (std::vector<std::string>{"stall", "queued 0", "queued 1"}));
+    EXPECT_EQ(messages(entries, "LOGGER"), (std::vector<std::string>{"1 messages dropped (ERROR: 1)"}));
+
+    std::filesystem::remove_all(DIR);
+}
+
+// ✅ Room freed before the deadline admits the blocked producer: nothing dropped
+TEST(Backpressure, BlockTimeoutAdmitsWhenRoomFrees) {
+    GateBackend backend;
+    Logger<GateBackend> logger(makeSettings("block_timeout", 1, 10000), backend);
+    const ContextId app = logger.context("APP");
+    stall(logger, backend);
+
+    logger.log(logger.level("INFO"), app, "queued");
+    std::thread opener([&backend] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        backend.openGate();
+    });
+    const auto start = std::chrono::steady_clock::now();
+    logger.log(logger.level("INFO"), app, "admitted");
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    opener.join();
+    logger.shutdown();
+
+    EXPECT_EQ(logger.droppedMessages(), 0u);
+    EXPECT_EQ(messages(backend.written(), "APP"), (std::vector<std::string>{"stall", "queued", "admitted"}));
+
+    std::filesystem::remove_all(DIR);
+}
+
+//------------------------------------------------------------------------------
+// ✅ block: producers on a one-slot queue lose nothing
+//------------------------------------------------------------------------------
+TEST(Backpressure, BlockLosesNothing) {
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 500;
+    GateBackend backend;
+    backend.openGate();
+    Logger<GateBackend> logger(makeSettings("block", 1), backend);
+    const LevelId info = logger.level("INFO");
+    const ContextId app = logger.context("APP");
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < THREADS; ++t) {
+        producers.emplace_back([&, t] {
+            for (int i = 0; i < PER_THREAD; ++i) logger.log(info, app, "{} {}", t, i);
+        });
+    }
+    for (auto& producer : producers) producer.join();
+    logger.shutdown();
+
+    EXPECT_EQ(logger.droppedMessages(), 0u);
+    std::vector<int> next(THREADS, 0);
+    for (const auto& message : messages(backend.written(), "APP")) {
+        const int t = std::stoi(message);
+        ASSERT_EQ(std::stoi(message.substr(message.find(' ') + 1)), next[t]) << message;
+        ++next[t];
+    }
+    EXPECT_EQ(next, std::vector<int>(THREADS, PER_THREAD));
+
+    std::filesystem::remove_all(DIR);
+}
+
+//------------------------------------------------------------------------------
+// ✅ fan_out: a stalled backend drops its own overflow (backend_overflow_policy,
+//    not backpressure_policy = "block"), and the one next to it keeps writing
+//------------------------------------------------------------------------------
+TEST(Backpressure, FanOutSlowBackendDoesNotBlockOthers) {
+    constexpr int MESSAGES = 200;
+    constexpr int MAX_QUEUED = 8;
+    std::filesystem::create_directories(DIR);
+    auto settings = std::make_shared<LoggerSettings>();
+    settings->configPath = (DIR / "fan_out.conf").string();
+    {
+        std::ofstream config(settings->configPath, std::ios::trunc);
+        config << "[general]\n"
+               << "log_directory = \"" << DIR.string() << "\"\n"
+               << "queue_mode = \"deque\"\n"
+               << "dispatch_mode = \"fan_out\"\n"
+               << "flush_mode = \"batch\"\n"
+               << "backpressure_policy = \"block\"\n"
+               << "backend_overflow_policy = \"drop_oldest\"\n"
+               << "queue_max_messages = " << MAX_QUEUED << "\n"
+               << "[backends]\nenable_console = false\nenable_file = false\n"
+               << "[levels]\nINFO = \"ON\"\n"
+               << "[severities]\nINFO = 3\n"
+               << "[contexts]\nAPP = \"INFO\"\n";
+    }
+
+    GateBackend slow;
+    CountingBackend fast;
+    Logger<GateBackend, CountingBackend> logger(settings, slow, fast);
+    const LevelId info = logger.level("INFO");
+    const ContextId app = logger.context("APP");
+
+    logger.log(info, app, "stall");
+    slow.waitForEntries(1);
+
+    // The slow worker is parked in write(); the fast one still gets every
+    // message (paced on it, so only the slow queue can overflow)
+    bool delivered = true;
+    for (int i = 0; i < MESSAGES && delivered; ++i) {
+        logger.log(info, app, "message {}", i);
+        delivered = fast.waitFor(static_cast<std::size_t>(i) + 2, std::chrono::seconds(10));
+    }
+    auto stats = logger.backendStats();
+    if (!delivered) slow.openGate();   // lets the logger shut down
+    ASSERT_TRUE(delivered);
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].droppedMessages, static_cast<std::uint64_t>(MESSAGES - (MAX_QUEUED - 1)));
+    EXPECT_EQ(stats[0].queuedMessages, static_cast<std::size_t>(MAX_QUEUED));   // "stall" in write() + 7
+    EXPECT_EQ(stats[0].peakQueuedMessages, static_cast<std::size_t>(MAX_QUEUED));
+    EXPECT_EQ(stats[1].droppedMessages, 0u);
+
+    slow.openGate();
+    logger.shutdown();
+
+    stats = logger.backendStats();
+    EXPECT_EQ(stats[0].queuedMessages, 0u);
+    EXPECT_EQ(stats[0].writtenMessages, static_cast<std::uint64_t>(MAX_QUEUED));
+    EXPECT_EQ(stats[1].writtenMessages, static_cast<std::uint64_t>(MESSAGES + 1));
+    EXPECT_EQ(stats[1].droppedMessages, 0u);
+    EXPECT_GT(stats[1].maxLagNs, 0);
+    EXPECT_GT(stats[0].maxLagNs, 0);
+    EXPECT_EQ(logger.droppedMessages(), 0u);   // per-backend drops are not logger drops
+
+    // drop_oldest: the newest messages survive the overflow
+    std::vector<std::string> expected{"stall"};
+    for (int i = MESSAGES - (MAX_QUEUED - 1); i < MESSAGES; ++i) expected.push_back("message " + std::to_string(i));
+    EXPECT_EQ(messages(slow.written(), "APP"), expected);
+
+    std::filesystem::remove_all(DIR);
+}
@@ -0,0 +1,128 @@
+#include "myLogger/backends/file_backend.hpp"
+#include "myLogger/binary_log_format.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    const std::filesystem::path DIR = std::filesystem::temp_directory_path() / "mylogger_binary_test";
+
+    std::string readFile(const std::filesystem::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        std::stringstream contents;
+        contents << in.rdbuf();
+        return contents.str();
+    }
+
+    LoggerSettings makeSettings(const std::string& logFormat, const std::string& filename) {
+        std::filesystem::create_directories(DIR);
+        const auto configPath = (DIR / (filename + ".conf")).string();
+        {
+            std::ofstream config(configPath, std::ios::trunc);
+            config << "[general]\n"
+                   << "log_directory = \"" << DIR.string() << "\"\n"
+                   << "log_filename_format = \"" << filename << "\"\n"
+                   << "rotation_size = 0\nrotation_interval = 0\n"
+                   << "[format]\nlog_format = \"" << logFormat << "\"\ntimestamp_format = \"ISO_MS\"\n"
+                   << "[backends]\nenable_console = false\nenable_file = true\n"
+                   << "[levels]\nDEBUG = \"ON\"\nINFO = \"ON\"\nERROR = \"ON\"\n"
+                   << "[severities]\nDEBUG = 2\nINFO = 3\nERROR = 5\n"
+                   << "[contexts]\nAPP = \"DEBUG\"\nNETWORK = \"DEBUG\"\n";
+        }
+        LoggerSettings settings;
+        LoggerConfig::loadOrGenerateConfig(configPath, settings);
+        return settings;
+    }
+
+    // A mix of levels, contexts, fields and awkward text; time runs backwards once
+    std::vector<LogMessage> makeBatch(const LoggerSettings& settings, std::int64_t baseNs) {
+        const LevelId debug = settings.findLevel("DEBUG");
+        const LevelId info = settings.findLevel("INFO");
+        const LevelId error = settings.findLevel("ERROR");
+        const ContextId app = settings.findContext("APP");
+        const ContextId network = settings.findContext("NETWORK");
+
+        std::vector<LogMessage> batch;
+        batch.emplace_back(info, app, "started");
+        batch.emplace_back(debug, network, "quote \" backslash \\ tab \t unicode \xC3\xA9");
+        batch.emplace_back(error, network, "");
+        batch.emplace_back(info, app, "request done");
+        batch.back().fields = LogFields{{"user_id", 42}, {"latency_us", 913.5}, {"ok", true},
+                                        {"path", "/api/orders?id=7"}, {"delta", -3}};
+        batch.emplace_back(error, app, "earlier than the one before");
+
+        const std::int64_t offsets[] = {0, 1'500'000, 1'500'000, 2'000'000'123, 1'000'000};
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            batch[i].timeNs = baseNs + offsets[i];
+            batch[i].stampTime(settings.config.format.timestampFormat);
+        }
+        return batch;
+    }
+
+    // Two sessions into one file: setup() appends a new session to a binary log
+    std::string writeTwice(const std::string& logFormat, const std::string& filename) {
+        const LoggerSettings settings = makeSettings(logFormat, filename);
+        for (const std::int64_t baseNs : {1'714'564'800'000'000'000LL, 1'714'568'400'250'000'000LL}) {
+            FileBackend backend;
+            backend.setup(settings);
+            backend.writeBatch(makeBatch(settings, baseNs), settings);
+            backend.shutdown();
+        }
+        return readFile(DIR / filename);
+    }
+
+    std::string decode(const std::string& binary, LogFormat format) {
+        std::istringstream in(binary);
+        std::ostringstream out;
+        std::string error;
+        EXPECT_TRUE(decodeBinaryLog(in, out, error, format)) << error;
+        return out.str();
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ A binary log decodes to exactly the text FileBackend writes directly,
+//    for each text encoding mylogger-decode offers
+//------------------------------------------------------------------------------
+TEST(BinaryLog, DecodesToTheTextEncodings) {
+    std::filesystem::remove_all(DIR);
+    const std::string binary = writeTwice("binary", "binary.log");
+    ASSERT_EQ(binary.compare(0, BINARY_LOG_MAGIC_LENGTH, BINARY_LOG_MAGIC), 0);
+
+    const std::string plain = writeTwice("plain", "plain.txt");
+    ASSERT_FALSE(plain.empty());
+    EXPECT_EQ(decode(binary, LogFormat::Plain), plain);
+    EXPECT_EQ(decode(binary, LogFormat::Json), writeTwice("json", "json.txt"));
+    EXPECT_EQ(decode(binary, LogFormat::Logfmt), writeTwice("logfmt", "logfmt.txt"));
+
+    std::filesystem::remove_all(DIR);
+}
+
+// ✅ Damage is reported; the lines before it are still written
+TEST(BinaryLog, MalformedInput) {
+    std::filesystem::remove_all(DIR);
+    const std::string binary = writeTwice("binary", "binary.log");
+
+    std::string error;
+    {
+        std::istringstream in("NOTALOG!" + binary.substr(BINARY_LOG_MAGIC_LENGTH));
+        std::ostringstream out;
+        EXPECT_FALSE(decodeBinaryLog(in, out, error));
+        EXPECT_FALSE(error.empty());
+    }
+    {
+        error.clear();
+        std::istringstream in(binary.substr(0, binary.size() - 3));
+        std::ostringstream out;
+        EXPECT_FALSE(decodeBinaryLog(in, out, error));
+        EXPECT_FALSE(error.empty());
+        EXPECT_NE(out.str().find("started"), std::string::npos);
+    }
+
+    std::filesystem::remove_all(DIR);
+}
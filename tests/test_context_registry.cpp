@@ -0,0 +1,112 @@
+#include "myLogger/context_registry.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    constexpr int NAMES = 600;   // well past the old 256-context limit
+
+    std::string nameOf(int i) { return "ctx_" + std::to_string(i); }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ Ids are dense and every name reads back, across several id segments
+//------------------------------------------------------------------------------
+TEST(ContextRegistry, ManyContexts) {
+    ContextRegistry registry;
+    for (int i = 0; i < NAMES; ++i) {
+        ASSERT_EQ(registry.findOrAdd(nameOf(i)), static_cast<ContextId>(i));
+    }
+    EXPECT_EQ(registry.size(), static_cast<std::size_t>(NAMES));
+    for (int i = 0; i < NAMES; ++i) {
+        EXPECT_EQ(registry.find(nameOf(i)), static_cast<ContextId>(i));
+        EXPECT_EQ(registry.name(static_cast<ContextId>(i)), nameOf(i));
+    }
+    EXPECT_EQ(registry.find("missing"), INVALID_CONTEXT_ID);
+    EXPECT_EQ(registry.name(NAMES), "UNKNOWN");
+}
+
+//------------------------------------------------------------------------------
+// ✅ Writers register the same new names in different orders while readers
+//    look them up: every caller gets one id per name, a name once found keeps
+//    its id, and ids read back to their names. Lost races leave aliases,
+//    which names() leaves out.
+//------------------------------------------------------------------------------
+TEST(ContextRegistry, ConcurrentRegistration) {
+    constexpr int WRITERS = 6;
+    constexpr int READERS = 2;
+    ContextRegistry registry;
+    std::atomic<bool> go{false};
+    std::atomic<int> writersLeft{WRITERS};
+
+    std::vector<std::vector<ContextId>> ids(WRITERS, std::vector<ContextId>(NAMES, INVALID_CONTEXT_ID));
+    std::vector<std::thread> threads;
+    for (int w = 0; w < WRITERS; ++w) {
+        threads.emplace_back([&, w] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            // Overlapping orders: each writer starts at another point, half go backwards
+            for (int k = 0; k < NAMES; ++k) {
+                const int step = (w * NAMES / WRITERS + k) % NAMES;
+                const int i = w % 2 ? NAMES - 1 - step : step;
+                ids[w][i] = registry.findOrAdd(nameOf(i));
+                if (k % 64 == 0) std::this_thread::yield();
+            }
+            writersLeft.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    std::vector<std::vector<ContextId>> seen(READERS, std::vector<ContextId>(NAMES, INVALID_CONTEXT_ID));
+    std::atomic<int> unstable{0};
+    std::atomic<int> misnamed{0};
+    for (int r = 0; r < READERS; ++r) {
+        threads.emplace_back([&, r] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            do {
+                for (int i = 0; i < NAMES; ++i) {
+                    const ContextId id = registry.find(nameOf(i));
+                    if (id == INVALID_CONTEXT_ID) continue;
+                    if (seen[r][i] == INVALID_CONTEXT_ID) seen[r][i] = id;
+                    if (seen[r][i] != id) ++unstable;
+                    if (registry.name(id) != nameOf(i)) ++misnamed;
+                }
+                std::this_thread::yield();
+            } while (writersLeft.load(std::memory_order_acquire) > 0);
+        });
+    }
+
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(unstable.load(), 0);
+    EXPECT_EQ(misnamed.load(), 0);
+
+    std::set<ContextId> distinct;
+    for (int i = 0; i < NAMES; ++i) {
+        const ContextId id = registry.find(nameOf(i));
+        ASSERT_NE(id, INVALID_CONTEXT_ID) << nameOf(i);
+        for (int w = 0; w < WRITERS; ++w) ASSERT_EQ(ids[w][i], id) << nameOf(i) << " writer " << w;
+        for (int r = 0; r < READERS; ++r) {
+            if (seen[r][i] != INVALID_CONTEXT_ID) {
+                EXPECT_EQ(seen[r][i], id) << nameOf(i);
+            }
+        }
+        EXPECT_EQ(registry.name(id), nameOf(i));
+        distinct.insert(id);
+    }
+    EXPECT_EQ(distinct.size(), static_cast<std::size_t>(NAMES));
+    EXPECT_GE(registry.size(), static_cast<std::size_t>(NAMES));
+
+    std::vector<std::string> names = registry.names();
+    ASSERT_EQ(names.size(), static_cast<std::size_t>(NAMES));
+    std::sort(names.begin(), names.end());
+    EXPECT_EQ(std::unique(names.begin(), names.end()), names.end());
+    EXPECT_TRUE(std::binary_search(names.begin(), names.end(), nameOf(NAMES - 1)));
+
+    // Repeated registration returns the same ids
+    for (int i = 0; i < NAMES; ++i) EXPECT_EQ(registry.findOrAdd(nameOf(i)), ids[0][i]);
+}
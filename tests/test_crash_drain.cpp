@@ -0,0 +1,173 @@
+#include "myLogger/backends/file_backend.hpp"
+#include "myLogger/logger.hpp"
+#include <gtest/gtest.h>
+#include <csignal>
+#include <climits>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+//------------------------------------------------------------------------------
+// ✅ crash_handler: a child process logs, then dies on a fatal signal; every
+//    message it logged must be in its log file.
+//------------------------------------------------------------------------------
+#if !defined(_WIN32)
+namespace {
+
+    constexpr int MESSAGE_COUNT = 5000;
+
+    std::filesystem::path crashDirectory(const std::string& name) {
+        auto dir = std::filesystem::temp_directory_path() / ("mylogger_crash_" + name + "_" + std::to_string(getpid()));
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        return dir;
+    }
+
+    // Recurses until the stack runs out; the handler then needs its own stack
+    volatile int recursionLimit = INT32_MAX;
+    [[gnu::noinline]] int overflowStack(int depth) {
+        volatile char frame[1024];
+        frame[0] = static_cast<char>(depth);
+        if (depth >= recursionLimit) return frame[0];
+        return overflowStack(depth + 1) + frame[0];
+    }
+
+    [[noreturn]] void logAndCrash(const std::filesystem::path& dir, const std::string& queueMode, int signal,
+                                  const std::string& logFormat = "plain", bool overflow = false) {
+        auto settings = std::make_shared<LoggerSettings>();
+        settings->configPath = (dir / "logger.conf").string();
+        {
+            std::ofstream config(settings->configPath);
+            config << "[general]\n"
+                   << "log_directory = \"" << dir.string() << "\"\n"
+                   << "log_filename_format = \"crash.txt\"\n"
+                   << "flush_mode = \"batch\"\n"
+                   << "queue_mode = \"" << queueMode << "\"\n"
+                   << "crash_handler = true\n"
+                   << "[format]\nlog_format = \"" << logFormat << "\"\n"
+                   << "[backends]\nenable_console = false\nenable_file = true\n"
+                   << "[levels]\nINFO = \"ON\"\nCRITICAL = \"ON\"\n"
+                   << "[severities]\nINFO = 3\nCRITICAL = 6\n"
+                   << "[contexts]\nCRASH = \"INFO\"\n";
+        }
+
+        // Deliberately leaked: no destructor may flush for us
+        auto* fileBackend = new FileBackend();
+        auto* logger = new Logger<FileBackend>(settings, *fileBackend);
+        const LevelId level = logger->level("INFO");
+        const ContextId context = logger->context("CRASH");
+        for (int i = 0; i < MESSAGE_COUNT; ++i) {
+            logger->log(level, context, "message " + std::to_string(i));
+            logger->log(level, context, "deferred {}", i);
+        }
+
+        if (overflow) {
+            overflowStack(0);
+        }
+        if (signal == SIGSEGV) {
+            volatile int* nowhere = nullptr;
+            *nowhere = 1;
+        }
+        std::raise(signal);
+        std::_Exit(0);   // not reached
+    }
+
+    void expectDrained(const std::string& queueMode, int signal, bool overflow = false) {
+        const auto dir = crashDirectory(queueMode + "_" + std::to_string(signal) + (overflow ? "_overflow" : ""));
+
+        const pid_t child = fork();
+        ASSERT_GE(child, 0);
+        if (child == 0) {
+            logAndCrash(dir, queueMode, signal, "plain", overflow);
+        }
+
+        int status = 0;
+        ASSERT_EQ(waitpid(child, &status, 0), child);
+        ASSERT_TRUE(WIFSIGNALED(status)) << "child exited normally";
+        EXPECT_EQ(WTERMSIG(status), signal);
+
+        std::ifstream file(dir / "crash.txt");
+        ASSERT_TRUE(file) << "no log file";
+        std::stringstream contents;
+        contents << file.rdbuf();
+        const std::string log = contents.str();
+
+        for (int i = 0; i < MESSAGE_COUNT; i += 499) {
+            EXPECT_NE(log.find("CRASH: message " + std::to_string(i) + "\n"), std::string::npos) << "message " << i;
+            EXPECT_NE(log.find("CRASH: deferred " + std::to_string(i) + "\n"), std::string::npos) << "deferred " << i;
+        }
+        const std::string last = std::to_string(MESSAGE_COUNT - 1);
+        EXPECT_NE(log.find("CRASH: message " + last + "\n"), std::string::npos);
+        EXPECT_NE(log.find("CRASH: deferred " + last + "\n"), std::string::npos);
+        EXPECT_NE(log.find("LOGGER: Fatal signal " + std::to_string(signal)), std::string::npos);
+
+        std::filesystem::remove_all(dir);
+    }
+
+} // namespace
+
+TEST(CrashDrain, SegfaultRing)       { expectDrained("ring", SIGSEGV); }
+TEST(CrashDrain, AbortRing)          { expectDrained("ring", SIGABRT); }
+TEST(CrashDrain, SegfaultPerThread)  { expectDrained("per_thread", SIGSEGV); }
+TEST(CrashDrain, FpeRing)            { expectDrained("ring", SIGFPE); }
+TEST(CrashDrain, StackOverflowRing)  { expectDrained("ring", SIGSEGV, true); }
+
+//------------------------------------------------------------------------------
+// ✅ The drained lines keep the file's encoding and time zone
+//------------------------------------------------------------------------------
+TEST(CrashDrain, JsonLinesStayJson) {
+    const auto dir = crashDirectory("json");
+
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        // Five hours ahead of UTC: a drain in UTC would stand out
+        setenv("TZ", "XYZ-5", 1);
+        tzset();
+        logAndCrash(dir, "ring", SIGABRT, "json");
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFSIGNALED(status)) << "child exited normally";
+
+    // "2024-05-01T12:34:56" as seconds, zone ignored
+    const auto seconds = [](const std::string& time) {
+        std::tm tm{};
+        std::istringstream(time) >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+        return static_cast<long long>(timegm(&tm));
+    };
+
+    std::ifstream file(dir / "crash.txt");
+    ASSERT_TRUE(file) << "no log file";
+    std::string line;
+    std::string firstTime;
+    int lines = 0;
+    bool sawNote = false;
+    while (std::getline(file, line)) {
+        ++lines;
+        ASSERT_EQ(line.rfind("{\"time\":\"", 0), 0u) << line;
+        ASSERT_EQ(line.back(), '}') << line;
+
+        // Same format and zone as the lines the consumer wrote
+        const std::string time = line.substr(9, line.find('"', 9) - 9);
+        ASSERT_EQ(time.size(), 19u) << line;
+        if (firstTime.empty()) firstTime = time;
+        ASSERT_LT(std::abs(seconds(time) - seconds(firstTime)), 60) << line;
+
+        sawNote |= line.find("\"context\":\"LOGGER\",\"msg\":\"Fatal signal ") != std::string::npos;
+    }
+    EXPECT_GE(lines, 2 * MESSAGE_COUNT + 1);
+    EXPECT_TRUE(sawNote);
+
+    std::filesystem::remove_all(dir);
+}
+#endif
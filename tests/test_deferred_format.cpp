@@ -0,0 +1,53 @@
+#include "myLogger/logger_core.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+// ✅ Only literals make a format; string arguments are copied, other pointers refused
+static_assert(!std::is_convertible_v<const char*, DeferredFormatString>);
+static_assert(!std::is_convertible_v<std::string, DeferredFormatString>);
+static_assert(DeferredFormatArg<const char*>);
+static_assert(DeferredFormatArg<std::string>);
+static_assert(DeferredFormatArg<char[6]>);
+static_assert(!DeferredFormatArg<int*>);
+static_assert(!DeferredFormatArg<void*>);
+
+namespace {
+
+    std::string render(LogMessage& log) {
+        std::string scratch;
+        log.materialize(scratch);
+        return std::string(log.message.view());
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ Strings are copied at the call: the source may be gone before rendering
+//------------------------------------------------------------------------------
+TEST(DeferredFormat, StringArgumentsOutliveTheirSource) {
+    LogMessage log;
+    {
+        std::string user = "alice";
+        std::string_view route = "/api/orders";
+        log.captureFormat("user {} on {} ({} ms, ok={})", user.c_str(), route, 12.5, true);
+        user.assign("XXXXX");
+    }
+    EXPECT_TRUE(log.deferred.pending());
+    EXPECT_EQ(render(log), "user alice on /api/orders (12.5 ms, ok=true)");
+}
+
+TEST(DeferredFormat, NullAndMissingArguments) {
+    LogMessage log;
+    const char* nothing = nullptr;
+    log.captureFormat("{} {} {{literal}} {}", nothing, 7);
+    EXPECT_EQ(render(log), "(null) 7 {literal} {}");
+}
+
+// ✅ Strings too long for the argument buffer are rendered on the producer
+TEST(DeferredFormat, LongStringsRenderedImmediately) {
+    const std::string longText(MAX_DEFERRED_ARGS_SIZE * 2, 'x');
+    LogMessage log;
+    log.captureFormat("[{}] {}", longText, 42);
+    EXPECT_FALSE(log.deferred.pending());
+    EXPECT_EQ(log.message.view(), "[" + longText + "] 42");
+}
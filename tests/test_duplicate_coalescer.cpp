@@ -0,0 +1,210 @@
+#include "myLogger/backends/file_backend.hpp"
+#include "myLogger/logger.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    constexpr std::int64_t MS = 1'000'000;
+    constexpr std::int64_t WINDOW = 100 * MS;
+
+    LogMessage record(std::string_view text, std::int64_t timeNs, LevelId level = 1, ContextId context = 1) {
+        LogMessage log{level, context, text};
+        log.timeNs = timeNs;
+        return log;
+    }
+
+    std::vector<std::string> texts(const std::vector<LogMessage>& batch) {
+        std::vector<std::string> out;
+        for (const auto& log : batch) out.emplace_back(log.message.view());
+        return out;
+    }
+
+    using Texts = std::vector<std::string>;
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ Repeats inside one batch collapse into the first record plus a count,
+//    written where the run ended
+//------------------------------------------------------------------------------
+TEST(DuplicateCoalescer, FoldsWithinBatch) {
+    DuplicateCoalescer coalescer;
+    LoggerSettings::Format format;
+    format.enableTimestamps = false;
+
+    std::vector<LogMessage> batch;
+    batch.push_back(record("a", 0));
+    batch.push_back(record("b", 1));
+    batch.push_back(record("b", 2));
+    batch.push_back(record("b", 3));
+    batch.push_back(record("c", 4));
+    batch.push_back(record("c", 5, 2));   // same text, other level
+    batch.push_back(record("c", 6, 2, 2)); // same text, other context
+
+    std::vector<LogMessage> leading;
+    coalescer.apply(batch, WINDOW, format, leading);
+
+    EXPECT_TRUE(leading.empty());
+    EXPECT_EQ(texts(batch), (Texts{"a", "b", "last message repeated 2 times", "c", "c", "c"}));
+    EXPECT_EQ(batch[2].timeNs, 3);
+    EXPECT_EQ(batch[2].level, 1);
+
+    LogMessage summary;
+    EXPECT_FALSE(coalescer.flushExpired(100 * MS, WINDOW, true, format, summary));
+}
+
+TEST(DuplicateCoalescer, FieldsTakePart) {
+    DuplicateCoalescer coalescer;
+    LoggerSettings::Format format;
+
+    std::vector<LogMessage> batch;
+    for (int id : {1, 2, 2}) {
+        batch.push_back(record("request", id));
+        batch.back().fields.assign({{{"id", id}}});
+    }
+
+    std::vector<LogMessage> leading;
+    coalescer.apply(batch, WINDOW, format, leading);
+    ASSERT_EQ(batch.size(), 2u);
+
+    LogMessage summary;
+    ASSERT_TRUE(coalescer.flushExpired(0, WINDOW, true, format, summary));
+    EXPECT_EQ(summary.message.view(), "last message repeated 1 times");
+    EXPECT_EQ(summary.fields.size(), 0u);
+    EXPECT_NE(summary.timestampLength, 0);
+}
+
+// ✅ A run spanning batches is matched by content and counted until it ends
+TEST(DuplicateCoalescer, RunAcrossBatches) {
+    DuplicateCoalescer coalescer;
+    LoggerSettings::Format format;
+    format.enableTimestamps = false;
+    std::vector<LogMessage> leading;
+
+    std::vector<LogMessage> first;
+    first.push_back(record("x", 0));
+    first.push_back(record("x", 1));
+    coalescer.apply(first, WINDOW, format, leading);
+    EXPECT_EQ(texts(first), (Texts{"x"}));
+
+    std::vector<LogMessage> second;
+    second.push_back(record("x", 2));
+    second.push_back(record("x", 3));
+    coalescer.apply(second, WINDOW, format, leading);
+    EXPECT_TRUE(second.empty());
+    EXPECT_TRUE(leading.empty());
+
+    std::vector<LogMessage> third;
+    third.push_back(record("y", 4));
+    coalescer.apply(third, WINDOW, format, leading);
+    EXPECT_EQ(texts(leading), (Texts{"last message repeated 3 times"}));
+    EXPECT_EQ(texts(third), (Texts{"y"}));
+}
+
+// ✅ Once the first record's batch is gone, a record of the same shape but
+//    other bytes (message or fields) still ends the run
+TEST(DuplicateCoalescer, RunAcrossBatchesComparesBytes) {
+    DuplicateCoalescer coalescer;
+    LoggerSettings::Format format;
+    format.enableTimestamps = false;
+    std::vector<LogMessage> leading;
+
+    auto withField = [](std::string_view text, std::int64_t timeNs, int id) {
+        LogMessage log = record(text, timeNs);
+        log.fields.assign({{{"id", id}}});
+        return log;
+    };
+    {
+        std::vector<LogMessage> first;
+        first.push_back(withField("abc", 0, 1));
+        coalescer.apply(first, WINDOW, format, leading);
+    }
+
+    std::vector<LogMessage> second;
+    second.push_back(withField("abc", 1, 1));
+    second.push_back(withField("abd", 2, 1));   // same length, other text
+    second.push_back(withField("abd", 3, 2));   // same length, other field value
+    coalescer.apply(second, WINDOW, format, leading);
+    EXPECT_TRUE(leading.empty());
+    EXPECT_EQ(texts(second), (Texts{"last message repeated 1 times", "abd", "abd"}));
+}
+
+// ✅ The window starts at the run's first record; a repeat after it starts over
+TEST(DuplicateCoalescer, WindowCloses) {
+    DuplicateCoalescer coalescer;
+    LoggerSettings::Format format;
+    format.enableTimestamps = false;
+    std::vector<LogMessage> leading;
+
+    std::vector<LogMessage> batch;
+    batch.push_back(record("x", 0));
+    batch.push_back(record("x", 50 * MS));
+    batch.push_back(record("x", 150 * MS));
+    coalescer.apply(batch, WINDOW, format, leading);
+    EXPECT_EQ(texts(batch), (Texts{"x", "last message repeated 1 times", "x"}));
+
+    std::vector<LogMessage> more;
+    more.push_back(record("x", 160 * MS));
+    coalescer.apply(more, WINDOW, format, leading);
+    EXPECT_TRUE(more.empty());
+
+    // Idle: nothing until the window of the run at 150 ms has passed
+    LogMessage summary;
+    EXPECT_FALSE(coalescer.flushExpired(200 * MS, WINDOW, false, format, summary));
+    ASSERT_TRUE(coalescer.flushExpired(250 * MS, WINDOW, false, format, summary));
+    EXPECT_EQ(summary.message.view(), "last message repeated 1 times");
+    EXPECT_EQ(summary.timeNs, 160 * MS);
+    EXPECT_FALSE(coalescer.flushExpired(300 * MS, WINDOW, true, format, summary));
+}
+
+//------------------------------------------------------------------------------
+// ✅ Configured through [general]; the count reaches the log at shutdown
+//------------------------------------------------------------------------------
+TEST(DuplicateCoalescer, ConfiguredWindowWritesCount) {
+    const auto dir = std::filesystem::temp_directory_path() / "mylogger_coalesce_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    auto settings = std::make_shared<LoggerSettings>();
+    settings->configPath = (dir / "logger.conf").string();
+    {
+        std::ofstream config(settings->configPath);
+        config << "[general]\n"
+               << "log_directory = \"" << dir.string() << "\"\n"
+               << "log_filename_format = \"coalesced.txt\"\n"
+               << "coalesce_window_ms = 60000\n"
+               << "[backends]\nenable_console = false\nenable_file = true\n"
+               << "[levels]\nINFO = \"ON\"\n"
+               << "[severities]\nINFO = 3\n"
+               << "[contexts]\nAPP = \"INFO\"\n";
+    }
+
+    {
+        FileBackend fileBackend;
+        Logger<FileBackend> logger(settings, fileBackend);
+        const ContextId app = logger.context("APP");
+        logger.log(logger.level("INFO"), app, "starting");
+        for (int i = 0; i < 1000; ++i) {
+            logger.log(logger.level("INFO"), app, "connection refused");
+        }
+        logger.shutdown();
+    }
+
+    std::ifstream in(dir / "coalesced.txt");
+    std::stringstream contents;
+    contents << in.rdbuf();
+    const std::string log = contents.str();
+
+    EXPECT_NE(log.find("starting\n"), std::string::npos);
+    const auto first = log.find("connection refused\n");
+    ASSERT_NE(first, std::string::npos);
+    EXPECT_EQ(log.find("connection refused\n", first + 1), std::string::npos);
+    EXPECT_NE(log.find("[INFO] APP: last message repeated 999 times"), std::string::npos) << log;
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,194 @@
+#include "myLogger/backends/file_backend.hpp"
+#include "myLogger/log_rotator.hpp"
+#include "myLogger/logger.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    const fs::path DIR = fs::temp_directory_path() / "mylogger_rotation_test";
+
+    void touchOld(const fs::path& path) {
+        std::ofstream(path) << "old\n";
+        fs::last_write_time(path, fs::file_time_type::clock::now() - std::chrono::hours(24 * 30));
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ Names are matched against the whole format, not a literal prefix
+//------------------------------------------------------------------------------
+TEST(LogRotation, RotatedNames) {
+    const std::string_view format = "log_%Y-%m-%d_%H-%M-%S.txt";
+    EXPECT_TRUE(LogRotator::isRotatedName("log_2024-05-06_13-45-10.txt", format));
+    EXPECT_TRUE(LogRotator::isRotatedName("log_2024-05-06_13-45-10.3.txt", format));
+    EXPECT_TRUE(LogRotator::isRotatedName("log_2024-05-06_13-45-10.12.txt.gz", format));
+    EXPECT_FALSE(LogRotator::isRotatedName("log_backup.txt", format));
+    EXPECT_FALSE(LogRotator::isRotatedName("log_2024-05-06.txt", format));
+    EXPECT_FALSE(LogRotator::isRotatedName("log_2024-05-06_13-45-10.x.txt", format));
+
+    EXPECT_TRUE(LogRotator::isRotatedName("20240506.log", "%Y%m%d.log"));
+    EXPECT_TRUE(LogRotator::isRotatedName("app-2024-05-06T13:45:10", "app-%FT%T"));
+    EXPECT_TRUE(LogRotator::isRotatedName("app-2024-05-06T13:45:10.2", "app-%FT%T"));
+    EXPECT_TRUE(LogRotator::isRotatedName("app_May_06.log", "app_%b_%d.log"));
+    EXPECT_TRUE(LogRotator::isRotatedName("fixed.1.txt", "fixed.txt"));
+    EXPECT_FALSE(LogRotator::isRotatedName("fixed.txt.bak", "fixed.txt"));
+}
+
+// ✅ Retention deletes old files of this format only, never the active one
+TEST(LogRotation, RetentionSweep) {
+    fs::remove_all(DIR);
+    fs::create_directories(DIR);
+
+    for (const char* name : {"app_20200101.log", "app_20200102.1.log.gz", "app_notes.log",
+                             "other.txt", "app_20200103.log"}) {
+        touchOld(DIR / name);
+    }
+    std::ofstream(DIR / "app_20991231.log") << "fresh\n";
+
+    LoggerSettings settings;
+    settings.config.general.logDirectory = DIR.string();
+    settings.config.general.logFilenameFormat = "app_%Y%m%d.log";
+    settings.config.general.logRotationDays = 7;
+
+    LogRotator rotator;
+    rotator.configure(settings, (DIR / "app_20200103.log").string(), 0);
+    rotator.shutdown();
+
+    EXPECT_FALSE(fs::exists(DIR / "app_20200101.log"));
+    EXPECT_FALSE(fs::exists(DIR / "app_20200102.1.log.gz"));
+    EXPECT_TRUE(fs::exists(DIR / "app_notes.log"));
+    EXPECT_TRUE(fs::exists(DIR / "other.txt"));
+    EXPECT_TRUE(fs::exists(DIR / "app_20200103.log"));   // active
+    EXPECT_TRUE(fs::exists(DIR / "app_20991231.log"));   // too new
+
+    fs::remove_all(DIR);
+}
+
+//------------------------------------------------------------------------------
+// ✅ Size-based rotation: every line lands in exactly one file, in order
+//------------------------------------------------------------------------------
+TEST(LogRotation, SizeRotationKeepsEveryLine) {
+    fs::remove_all(DIR);
+    fs::create_directories(DIR);
+    constexpr int LINES = 3000;
+    constexpr std::uintmax_t MAX_BYTES = 4096;
+
+    auto settings = std::make_shared<LoggerSettings>();
+    settings->configPath = (DIR / "logger.conf").string();
+    {
+        std::ofstream config(settings->configPath);
+        config << "[general]\n"
+               << "log_directory = \"" << DIR.string() << "\"\n"
+               << "log_filename_format = \"rotating.txt\"\n"
+               << "rotation_size = " << MAX_BYTES << "\n"
+               << "rotation_interval = 0\n"
+               << "compress_rotated = false\n"
+               << "[backends]\nenable_console = false\nenable_file = true\n"
+               << "[levels]\nINFO = \"ON\"\n"
+               << "[severities]\nINFO = 3\n"
+               << "[contexts]\nAPP = \"INFO\"\n";
+    }
+
+    {
+        FileBackend fileBackend;
+        Logger<FileBackend> logger(settings, fileBackend);
+        const LevelId info = logger.level("INFO");
+        const ContextId app = logger.context("APP");
+        for (int i = 0; i < LINES; ++i) {
+            logger.log(info, app, "line {}", i);
+        }
+        logger.shutdown();
+    }
+
+    std::vector<fs::path> files{DIR / "rotating.txt"};
+    for (int n = 1; fs::exists(DIR / ("rotating." + std::to_string(n) + ".txt")); ++n) {
+        files.push_back(DIR / ("rotating." + std::to_string(n) + ".txt"));
+    }
+    ASSERT_GT(files.size(), 2u);
+
+    int expected = 0;
+    for (const auto& file : files) {
+        EXPECT_LE(fs::file_size(file), MAX_BYTES) << file;
+        std::ifstream in(file);
+        std::string line;
+        while (std::getline(in, line)) {
+            const auto at = line.rfind("line ");
+            ASSERT_NE(at, std::string::npos) << line;
+            ASSERT_EQ(std::stoi(line.substr(at + 5)), expected) << file;
+            ++expected;
+        }
+    }
+    EXPECT_EQ(expected, LINES);
+
+    fs::remove_all(DIR);
+}
+
+//------------------------------------------------------------------------------
+// ✅ A rotated file that cannot be opened is retried with the next batch;
+//    the records in between are counted as lost
+//------------------------------------------------------------------------------
+TEST(LogRotation, FailedReopenIsRetried) {
+    fs::remove_all(DIR);
+    const fs::path logs = DIR / "logs";
+    fs::create_directories(logs);
+
+    const auto configPath = (DIR / "logger.conf").string();
+    {
+        std::ofstream config(configPath);
+        config << "[general]\n"
+               << "log_directory = \"" << logs.string() << "\"\n"
+               << "log_filename_format = \"retry.txt\"\n"
+               << "rotation_size = 64\n"
+               << "rotation_interval = 0\n"
+               << "compress_rotated = false\n"
+               << "[backends]\nenable_console = false\nenable_file = true\n"
+               << "[levels]\nINFO = \"ON\"\n"
+               << "[severities]\nINFO = 3\n"
+               << "[contexts]\nAPP = \"INFO\"\n";
+    }
+    LoggerSettings settings;
+    LoggerConfig::loadOrGenerateConfig(configPath, settings);
+    const LevelId info = settings.findLevel("INFO");
+    const ContextId app = settings.findContext("APP");
+
+    // Every record is longer than rotation_size, so each one rotates
+    auto batch = [&](const std::string& text, int count) {
+        std::vector<LogMessage> records;
+        for (int i = 0; i < count; ++i) records.emplace_back(info, app, text + " " + std::string(64, '.'));
+        return records;
+    };
+
+    FileBackend backend;
+    backend.setup(settings);
+    backend.writeBatch(batch("before", 2), settings);
+    EXPECT_EQ(backend.lostMessageCount(), 0u);
+
+    // A plain file where the log directory was: the rotated file cannot open
+    fs::rename(logs, DIR / "moved");
+    std::ofstream(logs) << "in the way\n";
+    backend.writeBatch(batch("lost", 2), settings);
+    backend.writeBatch(batch("lost", 3), settings);
+    EXPECT_EQ(backend.lostMessageCount(), 5u);
+
+    fs::remove(logs);
+    backend.writeBatch(batch("after", 1), settings);
+    backend.shutdown();
+    EXPECT_EQ(backend.lostMessageCount(), 5u);
+
+    std::string written;
+    for (const auto& entry : fs::directory_iterator(logs)) {
+        std::ifstream in(entry.path());
+        written.append(std::istreambuf_iterator<char>(in), {});
+    }
+    EXPECT_NE(written.find("after "), std::string::npos);
+    EXPECT_EQ(written.find("lost "), std::string::npos);
+
+    fs::remove_all(DIR);
+}
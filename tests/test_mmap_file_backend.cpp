@@ -0,0 +1,100 @@
+#include "myLogger/backends/mmap_file_backend.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__)
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+    const std::filesystem::path DIR = std::filesystem::temp_directory_path() / "mylogger_mmap_test";
+
+    void writeLines(MmapFileBackend& backend, const LoggerSettings& settings, int from, int to) {
+        std::vector<LogMessage> batch;
+        for (int i = from; i < to; ++i) {
+            batch.emplace_back(0, 0, "line " + std::to_string(i));
+        }
+        backend.writeBatch(batch, settings);
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ A run that dies without closing its segment leaves a zero-filled tail;
+//    the next run resumes in the newest segment, right after the last record
+//------------------------------------------------------------------------------
+TEST(MmapFileBackend, ResumesAfterCrash) {
+    constexpr int LINES = 600;
+    std::filesystem::remove_all(DIR);
+    std::filesystem::create_directories(DIR);
+
+    LoggerSettings settings;
+    settings.config.general.logDirectory = DIR.string();
+    settings.config.general.logFilenameFormat = "mapped.txt";
+    settings.config.general.mmapSegmentSize = 4096;
+
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        MmapFileBackend backend;
+        backend.setup(settings);
+        writeLines(backend, settings, 0, LINES / 2);
+        _exit(backend.segmentPath() == (DIR / "mapped.txt").string() ? 2 : 0);   // no shutdown()
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0) << "first run did not reach a second segment";
+
+    {
+        MmapFileBackend backend;
+        backend.setup(settings);
+        EXPECT_NE(backend.segmentPath(), (DIR / "mapped.txt").string());
+        writeLines(backend, settings, LINES / 2, LINES);
+        backend.shutdown();
+    }
+
+    std::vector<std::filesystem::path> segments{DIR / "mapped.txt"};
+    for (int n = 1; std::filesystem::exists(DIR / ("mapped." + std::to_string(n) + ".txt")); ++n) {
+        segments.push_back(DIR / ("mapped." + std::to_string(n) + ".txt"));
+    }
+
+    int expected = 0;
+    for (const auto& segment : segments) {
+        std::ifstream in(segment);
+        std::stringstream contents;
+        contents << in.rdbuf();
+        ASSERT_EQ(contents.str().find('\0'), std::string::npos) << segment;
+
+        std::string line;
+        while (std::getline(contents, line)) {
+            const auto at = line.rfind("line ");
+            ASSERT_NE(at, std::string::npos) << line;
+            ASSERT_EQ(std::stoi(line.substr(at + 5)), expected) << segment;
+            ++expected;
+        }
+    }
+    EXPECT_EQ(expected, LINES);
+
+    std::filesystem::remove_all(DIR);
+}
+
+// ✅ log_format = "binary" is refused up front instead of written as text
+TEST(MmapFileBackend, RejectsBinaryFormat) {
+    LoggerSettings settings;
+    settings.config.general.logDirectory = DIR.string();
+    settings.config.general.logFilenameFormat = "mapped.log";
+    settings.config.format.logFormat = "binary";
+
+    MmapFileBackend backend;
+    EXPECT_THROW(backend.setup(settings), std::runtime_error);
+    EXPECT_FALSE(std::filesystem::exists(DIR / "mapped.log"));
+}
+
+#endif // __unix__
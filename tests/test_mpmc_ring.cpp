@@ -0,0 +1,164 @@
+#include "myLogger/logger.hpp"
+#include "myLogger/mpmc_ring_buffer.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    constexpr int PRODUCERS = 4;
+    constexpr std::uint64_t PER_PRODUCER = 50'000;
+
+    std::uint64_t encode(std::uint64_t producer, std::uint64_t sequence) { return producer << 32 | sequence; }
+
+    class CollectingBackend {
+    public:
+        std::mutex mutex;
+        std::vector<std::string> messages;
+
+        void setup([[maybe_unused]] const LoggerSettings& settings) {}
+
+        void write(const LogMessage& log, [[maybe_unused]] const LoggerSettings& settings) {
+            std::lock_guard<std::mutex> lock(mutex);
+            messages.emplace_back(log.message.view());
+        }
+    };
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ Full and empty: a failed push leaves the value alone, order is FIFO
+//------------------------------------------------------------------------------
+TEST(MpmcRing, FullAndEmpty) {
+    MpmcRingBuffer<std::string> ring(3);   // rounded up to 4
+    ASSERT_EQ(ring.getCapacity(), 4u);
+
+    std::string value;
+    EXPECT_FALSE(ring.tryPop(value));
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(ring.tryPush(std::to_string(i)));
+    std::string rejected = "kept";
+    EXPECT_FALSE(ring.tryPush(std::move(rejected)));
+    EXPECT_EQ(rejected, "kept");
+    EXPECT_EQ(ring.size(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(value, std::to_string(i));
+    }
+    EXPECT_TRUE(ring.empty());
+}
+
+//------------------------------------------------------------------------------
+// ✅ Several producers and consumers on a small ring: every value comes out
+//    exactly once, and each consumer sees each producer's values in order
+//------------------------------------------------------------------------------
+TEST(MpmcRing, StressNoLossNoDuplicates) {
+    constexpr int CONSUMERS = 2;
+    MpmcRingBuffer<std::uint64_t> ring(64);
+
+    std::vector<std::thread> producers;
+    for (std::uint64_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (std::uint64_t i = 0; i < PER_PRODUCER; ++i) {
+                while (!ring.tryPush(encode(p, i))) std::this_thread::yield();
+            }
+        });
+    }
+
+    std::atomic<std::uint64_t> popped{0};
+    std::vector<std::vector<std::uint64_t>> seen(CONSUMERS);
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < CONSUMERS; ++c) {
+        consumers.emplace_back([&, c] {
+            std::vector<std::uint64_t>& mine = seen[c];
+            std::uint64_t value = 0;
+            while (popped.load(std::memory_order_relaxed) < PRODUCERS * PER_PRODUCER) {
+                // Alternate between both ways of popping
+                std::size_t got = 0;
+                if (mine.size() % 2 == 0) {
+                    got = ring.popBulk(16, [&mine](std::uint64_t&& v) { mine.push_back(v); });
+                } else if (ring.tryPop(value)) {
+                    mine.push_back(value);
+                    got = 1;
+                }
+                if (got == 0) std::this_thread::yield();
+                popped.fetch_add(got, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& thread : producers) thread.join();
+    for (auto& thread : consumers) thread.join();
+
+    std::vector<std::uint8_t> count(PRODUCERS * PER_PRODUCER, 0);
+    for (const auto& mine : seen) {
+        std::vector<std::int64_t> last(PRODUCERS, -1);
+        for (const std::uint64_t value : mine) {
+            const std::uint64_t p = value >> 32;
+            const auto i = static_cast<std::int64_t>(value & 0xFFFFFFFF);
+            ASSERT_LT(p, static_cast<std::uint64_t>(PRODUCERS));
+            ASSERT_GT(i, last[p]) << "producer " << p << " out of order";
+            last[p] = i;
+            ++count[p * PER_PRODUCER + static_cast<std::uint64_t>(i)];
+        }
+    }
+    for (std::size_t i = 0; i < count.size(); ++i) {
+        ASSERT_EQ(count[i], 1) << "value " << i;
+    }
+    EXPECT_TRUE(ring.empty());
+}
+
+//------------------------------------------------------------------------------
+// ✅ queue_mode = "ring" end to end: every thread's messages arrive once, in order
+//------------------------------------------------------------------------------
+TEST(MpmcRing, LoggerRingModeDeliversEverything) {
+    constexpr int MESSAGES = 5000;
+    const auto dir = std::filesystem::temp_directory_path() / "mylogger_mpmc_test";
+    std::filesystem::create_directories(dir);
+
+    auto settings = std::make_shared<LoggerSettings>();
+    settings->configPath = (dir / "logger.conf").string();
+    {
+        std::ofstream config(settings->configPath);
+        config << "[general]\n"
+               << "log_directory = \"" << dir.string() << "\"\n"
+               << "queue_mode = \"ring\"\n"
+               << "queue_capacity = 128\n"
+               << "backpressure_policy = \"block\"\n"
+               << "[backends]\nenable_console = false\nenable_file = false\n"
+               << "[levels]\nINFO = \"ON\"\n"
+               << "[severities]\nINFO = 3\n"
+               << "[contexts]\nAPP = \"INFO\"\n";
+    }
+
+    CollectingBackend backend;
+    {
+        Logger<CollectingBackend> logger(settings, backend);
+        const LevelId info = logger.level("INFO");
+        const ContextId app = logger.context("APP");
+        std::vector<std::thread> producers;
+        for (int p = 0; p < PRODUCERS; ++p) {
+            producers.emplace_back([&, p] {
+                for (int i = 0; i < MESSAGES; ++i) logger.log(info, app, "{} {}", p, i);
+            });
+        }
+        for (auto& thread : producers) thread.join();
+        logger.shutdown();
+        EXPECT_EQ(logger.droppedMessages(), 0u);
+    }
+
+    std::vector<int> next(PRODUCERS, 0);
+    for (const auto& message : backend.messages) {
+        const int p = std::stoi(message);
+        ASSERT_EQ(std::stoi(message.substr(message.find(' ') + 1)), next[p]) << message;
+        ++next[p];
+    }
+    EXPECT_EQ(next, std::vector<int>(PRODUCERS, MESSAGES));
+
+    std::filesystem::remove_all(dir);
+}
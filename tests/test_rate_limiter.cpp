@@ -0,0 +1,152 @@
+#include "myLogger/backends/file_backend.hpp"
+#include "myLogger/logger.hpp"
+#include "myLogger/rate_limiter.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    constexpr ContextId CONTEXT = 3;
+    constexpr LevelId LEVEL = 2;
+
+    std::array<LimitRule, MAX_LEVELS> rulesFor(LevelId level, LimitRule rule) {
+        std::array<LimitRule, MAX_LEVELS> rules{};
+        rules[level] = rule;
+        return rules;
+    }
+
+    std::uint64_t collect(RateLimiter& limiter) {
+        std::uint64_t total = 0;
+        limiter.collectSuppressed([&](ContextId context, LevelId level, std::uint64_t count) {
+            EXPECT_EQ(context, CONTEXT);
+            EXPECT_EQ(level, LEVEL);
+            total += count;
+        });
+        return total;
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ Token bucket: a full bucket lets `burst` through, then refuses and counts
+//------------------------------------------------------------------------------
+TEST(RateLimiter, BurstThenSuppress) {
+    RateLimiter limiter;
+    ASSERT_TRUE(limiter.setRules(CONTEXT, rulesFor(LEVEL, {.rate = 1, .burst = 10})));
+
+    int admitted = 0;
+    for (int i = 0; i < 1000; ++i) {
+        admitted += limiter.admit(LEVEL, CONTEXT);
+    }
+    EXPECT_EQ(admitted, 10);
+    EXPECT_EQ(collect(limiter), 990u);
+    EXPECT_EQ(collect(limiter), 0u);   // collecting resets the counts
+
+    // Other levels and contexts are not limited
+    EXPECT_TRUE(limiter.admit(LEVEL + 1, CONTEXT));
+    EXPECT_TRUE(limiter.admit(LEVEL, CONTEXT + 1));
+    EXPECT_FALSE(limiter.setRules(CONTEXT + 1, rulesFor(LEVEL, {})));
+}
+
+TEST(RateLimiter, Sampling) {
+    RateLimiter limiter;
+    ASSERT_TRUE(limiter.setRules(CONTEXT, rulesFor(LEVEL, {.sample = 0.25})));
+
+    constexpr int TOTAL = 100000;
+    int admitted = 0;
+    for (int i = 0; i < TOTAL; ++i) {
+        admitted += limiter.admit(LEVEL, CONTEXT);
+    }
+    EXPECT_NEAR(admitted, TOTAL / 4, TOTAL / 50);
+    EXPECT_EQ(collect(limiter), static_cast<std::uint64_t>(TOTAL - admitted));
+
+    RateLimiter none;
+    none.setRules(CONTEXT, rulesFor(LEVEL, {.sample = 0}));
+    EXPECT_FALSE(none.admit(LEVEL, CONTEXT));
+}
+
+// ✅ Many threads share one bucket: the rate holds and every message is
+//    either admitted or counted
+TEST(RateLimiter, ConcurrentProducers) {
+    RateLimiter limiter;
+    ASSERT_TRUE(limiter.setRules(CONTEXT, rulesFor(LEVEL, {.rate = 1000, .burst = 100})));
+
+    std::atomic<std::uint64_t> admitted{0};
+    std::atomic<std::uint64_t> attempts{0};
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            std::uint64_t mine = 0, tries = 0;
+            while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(200)) {
+                mine += limiter.admit(LEVEL, CONTEXT);
+                ++tries;
+            }
+            admitted += mine;
+            attempts += tries;
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_LE(admitted.load(), static_cast<std::uint64_t>(100 + 1000 * seconds) + 1);
+    EXPECT_GE(admitted.load(), 100u);
+    EXPECT_EQ(admitted.load() + collect(limiter), attempts.load());
+}
+
+//------------------------------------------------------------------------------
+// ✅ Configured through [contexts]; the summary record reaches the log
+//------------------------------------------------------------------------------
+TEST(RateLimiter, ConfiguredContextWritesSummary) {
+    const auto dir = std::filesystem::temp_directory_path() / "mylogger_rate_limit_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    auto settings = std::make_shared<LoggerSettings>();
+    settings->configPath = (dir / "logger.conf").string();
+    {
+        std::ofstream config(settings->configPath);
+        config << "[general]\n"
+               << "log_directory = \"" << dir.string() << "\"\n"
+               << "log_filename_format = \"limited.txt\"\n"
+               << "[backends]\nenable_console = false\nenable_file = true\n"
+               << "[levels]\nDEBUG = \"ON\"\nINFO = \"ON\"\n"
+               << "[severities]\nDEBUG = 2\nINFO = 3\n"
+               << "[contexts]\n"
+               << "NETWORK = { level = \"DEBUG\", rate = 0.001, burst = 5, DEBUG = { sample = 0 } }\n"
+               << "APP = \"INFO\"\n";
+    }
+
+    {
+        FileBackend fileBackend;
+        Logger<FileBackend> logger(settings, fileBackend);
+        const ContextId network = logger.context("NETWORK");
+        const ContextId app = logger.context("APP");
+        for (int i = 0; i < 100; ++i) {
+            logger.log(logger.level("INFO"), network, "network " + std::to_string(i));
+            logger.log(logger.level("DEBUG"), network, "network debug");
+            logger.log(logger.level("INFO"), app, "app " + std::to_string(i));
+        }
+        logger.shutdown();
+    }
+
+    std::ifstream in(dir / "limited.txt");
+    std::stringstream contents;
+    contents << in.rdbuf();
+    const std::string log = contents.str();
+
+    EXPECT_NE(log.find("network 4\n"), std::string::npos);
+    EXPECT_EQ(log.find("network 5\n"), std::string::npos);
+    EXPECT_EQ(log.find("network debug"), std::string::npos);
+    EXPECT_NE(log.find("app 99\n"), std::string::npos);
+    EXPECT_NE(log.find("[INFO] NETWORK: 195 messages suppressed (DEBUG: 100, INFO: 95)"), std::string::npos) << log;
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,158 @@
+#include "myLogger/backends/file_backend.hpp"
+#include "myLogger/logger.hpp"
+#include "myLogger/settings_snapshots.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+    const std::filesystem::path DIR = std::filesystem::temp_directory_path() / "mylogger_snapshot_test";
+
+    std::string writeConfig(const std::string& name, const std::string& contexts) {
+        std::filesystem::create_directories(DIR);
+        const auto path = (DIR / name).string();
+        std::ofstream config(path, std::ios::trunc);
+        config << "[general]\n"
+               << "log_directory = \"" << DIR.string() << "\"\n"
+               << "log_filename_format = \"reload.txt\"\n"
+               << "[backends]\nenable_console = false\nenable_file = true\n"
+               << "[levels]\nDEBUG = \"ON\"\nINFO = \"ON\"\nERROR = \"ON\"\n"
+               << "[severities]\nDEBUG = 2\nINFO = 3\nERROR = 5\n"
+               << "[contexts]\n" << contexts;
+        return path;
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ A reload parses into a copy: the snapshot it replaces keeps its
+//    per-context severities, only the registry's names are shared
+//------------------------------------------------------------------------------
+TEST(SettingsSnapshots, ReloadLeavesPublishedSnapshotAlone) {
+    auto first = std::make_shared<LoggerSettings>();
+    LoggerConfig::loadOrGenerateConfig(writeConfig("first.conf", "NETWORK = \"ERROR\"\n"), *first);
+    const ContextId network = first->findContext("NETWORK");
+    ASSERT_NE(network, INVALID_CONTEXT_ID);
+
+    SettingsSnapshots snapshots;
+    snapshots.publish(first);
+    const LoggerSettings& before = snapshots.current();
+
+    auto second = std::make_shared<LoggerSettings>(*snapshots.latest());
+    LoggerConfig::loadOrGenerateConfig(writeConfig("second.conf", "NETWORK = \"DEBUG\"\nDISK = \"ERROR\"\n"), *second);
+
+    // Parsed but not yet published: nothing visible has changed
+    EXPECT_EQ(before.contextSeverity(network), 5);
+    EXPECT_EQ(snapshots.current().contextSeverity(network), 5);
+
+    snapshots.publish(second);
+    const LoggerSettings& after = snapshots.current();
+    EXPECT_EQ(after.contextSeverity(network), 2);
+    EXPECT_EQ(after.findContext("NETWORK"), network);   // ids survive the reload
+    EXPECT_EQ(after.contextSeverity(after.findContext("DISK")), 5);
+
+    // Registered after the load: the snapshot's default (INFO)
+    const ContextId late = after.addContext("LATE");
+    EXPECT_EQ(after.contextSeverity(late), 3);
+    EXPECT_EQ(first->contextSeverity(late), 3);
+
+    std::filesystem::remove_all(DIR);
+}
+
+// ✅ Typed levels: the context's minimum is folded into one mask per context
+TEST(SettingsSnapshots, TypedLevelMasks) {
+    LoggerSettings settings;
+    LoggerConfig::loadOrGenerateConfig(writeConfig("typed.conf", "NETWORK = \"ERROR\"\nCHATTY = \"DEBUG\"\n"), settings);
+    const auto bit = [](Level level) { return static_cast<std::uint8_t>(1u << static_cast<unsigned>(level)); };
+
+    // VERBOSE, WARN and CRITICAL are not in [levels] here
+    EXPECT_EQ(settings.typedLevelMask(settings.findContext("NETWORK")), bit(Level::Error));
+    EXPECT_EQ(settings.typedLevelMask(settings.findContext("CHATTY")),
+              bit(Level::Debug) | bit(Level::Info) | bit(Level::Error));
+    EXPECT_EQ(settings.typedLevelMask(settings.addContext("UNLISTED")), bit(Level::Info) | bit(Level::Error));
+
+    std::filesystem::remove_all(DIR);
+}
+
+// ✅ Producers racing a reload see either the old or the new pair of level
+//    and context severities, never a mix
+TEST(SettingsSnapshots, ReadersSeeWholeSnapshots) {
+    auto strict = std::make_shared<LoggerSettings>();
+    LoggerConfig::loadOrGenerateConfig(writeConfig("strict.conf", "NETWORK = \"ERROR\"\n"), *strict);
+    auto relaxed = std::make_shared<LoggerSettings>(*strict);
+    LoggerConfig::loadOrGenerateConfig(writeConfig("relaxed.conf", "NETWORK = \"DEBUG\"\n"), *relaxed);
+    relaxed->config.levels.severitiesArray[relaxed->findLevel("INFO")] = 30;
+    const ContextId network = strict->findContext("NETWORK");
+    const LevelId info = strict->findLevel("INFO");
+
+    SettingsSnapshots snapshots;
+    snapshots.publish(strict);
+    std::atomic<bool> done{false};
+    std::atomic<int> mixed{0};
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            const LoggerSettings& s = snapshots.current();
+            const int level = s.config.levels.severitiesArray[info];
+            const int context = s.contextSeverity(network);
+            if (!((level == 3 && context == 5) || (level == 30 && context == 2))) ++mixed;
+        }
+    });
+    for (int i = 0; i < 2000; ++i) {
+        snapshots.publish(i % 2 ? strict : relaxed);
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+    EXPECT_EQ(mixed.load(), 0);
+
+    std::filesystem::remove_all(DIR);
+}
+
+// ✅ Cells used in turn on one thread each keep their own cached snapshot,
+//    and a reload of one is seen without disturbing the other
+TEST(SettingsSnapshots, AlternatingCells) {
+    auto first = std::make_shared<LoggerSettings>();
+    auto second = std::make_shared<LoggerSettings>();
+    auto reloaded = std::make_shared<LoggerSettings>();
+
+    SettingsSnapshots a;
+    SettingsSnapshots b;
+    a.publish(first);
+    b.publish(second);
+    for (int i = 0; i < 1000; ++i) {
+        if (i == 500) a.publish(reloaded);
+        ASSERT_EQ(&a.current(), i < 500 ? first.get() : reloaded.get()) << i;
+        ASSERT_EQ(&b.current(), second.get()) << i;
+    }
+}
+
+//------------------------------------------------------------------------------
+// ✅ updateSettings() switches a running logger's context filter
+//------------------------------------------------------------------------------
+TEST(SettingsSnapshots, LoggerReload) {
+    std::filesystem::remove_all(DIR);
+    auto settings = std::make_shared<LoggerSettings>();
+    settings->configPath = writeConfig("logger.conf", "NETWORK = \"ERROR\"\n");
+
+    {
+        FileBackend fileBackend;
+        Logger<FileBackend> logger(settings, fileBackend);
+        const ContextId network = logger.context("NETWORK");
+        logger.log(logger.level("INFO"), network, "before reload");
+        logger.updateSettings(writeConfig("reloaded.conf", "NETWORK = \"DEBUG\"\n"));
+        logger.log(logger.level("INFO"), network, "after reload");
+        logger.shutdown();
+    }
+
+    std::ifstream in(DIR / "reload.txt");
+    std::stringstream contents;
+    contents << in.rdbuf();
+    EXPECT_EQ(contents.str().find("before reload"), std::string::npos);
+    EXPECT_NE(contents.str().find("after reload"), std::string::npos);
+
+    std::filesystem::remove_all(DIR);
+}
@@ -0,0 +1,270 @@
+#include "myLogger/backends/shm_ring_backend.hpp"
+#include "myLogger/logger.hpp"
+#include "myLogger/shm_collector.hpp"
+#include "myLogger/shm_ring.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/wait.h>
+#include <unistd.h>
+
+//------------------------------------------------------------------------------
+// ✅ ShmRing: records come out in order and intact across many wrap-arounds,
+//    and a full ring refuses records instead of waiting
+//------------------------------------------------------------------------------
+TEST(ShmRing, WrapsAndKeepsOrder) {
+    const std::string name = "/mylogger_test_ring." + std::to_string(getpid());
+    ShmRing writer;
+    ASSERT_TRUE(writer.create(name, 4096));
+    ShmRing reader;
+    ASSERT_TRUE(reader.attach(name));
+
+    int written = 0;
+    int read = 0;
+    while (read < 20000) {
+        // Lengths vary so records end at every 8-byte offset of the ring
+        while (written < 20000 &&
+               writer.tryWrite(written, "INFO", "CTX", std::to_string(written) + std::string(written % 61, 'x'))) {
+            ++written;
+        }
+        writer.publish();
+
+        ShmRecord record;
+        while (reader.next(record)) {
+            ASSERT_EQ(record.timeNs, read);
+            ASSERT_EQ(record.level, "INFO");
+            ASSERT_EQ(record.context, "CTX");
+            ASSERT_EQ(record.text, std::to_string(read) + std::string(read % 61, 'x'));
+            ++read;
+        }
+        reader.commit(0);
+    }
+
+    // Nothing read any more: the writer fills the ring and then gets refused
+    int accepted = 0;
+    while (writer.tryWrite(0, "INFO", "CTX", "filler") && accepted < 10000) ++accepted;
+    EXPECT_LT(accepted, 10000);
+    EXPECT_GT(accepted, 0);
+
+    writer.close(true);
+    EXPECT_TRUE(reader.closed());
+    reader.close();
+    ShmRing::unlink(name);
+}
+
+//------------------------------------------------------------------------------
+// ✅ ShmRingBackend + ShmCollector: several worker processes, one merged file
+//------------------------------------------------------------------------------
+namespace {
+
+    constexpr int WORKERS = 4;
+
+    struct Setup {
+        std::filesystem::path dir;
+        std::string configPath;
+        std::string ringName;
+    };
+
+    Setup makeSetup(const std::string& name, std::int64_t ringSize) {
+        Setup setup;
+        setup.dir = std::filesystem::temp_directory_path() / ("mylogger_shm_" + name + "_" + std::to_string(getpid()));
+        std::filesystem::remove_all(setup.dir);
+        std::filesystem::create_directories(setup.dir);
+        setup.configPath = (setup.dir / "logger.conf").string();
+        setup.ringName = "mylogger_test_" + name + "_" + std::to_string(getpid());
+
+        std::ofstream config(setup.configPath);
+        config << "[general]\n"
+               << "log_directory = \"" << setup.dir.string() << "\"\n"
+               << "log_filename_format = \"merged.txt\"\n"
+               << "flush_mode = \"batch\"\n"
+               << "shm_ring_name = \"" << setup.ringName << "\"\n"
+               << "shm_ring_size = " << ringSize << "\n"
+               << "shm_poll_ms = 1\n"
+               << "[backends]\nenable_console = false\nenable_file = true\n"
+               << "[levels]\nINFO = \"ON\"\nWARN = \"ON\"\n"
+               << "[severities]\nINFO = 3\nWARN = 4\n"
+               << "[contexts]\nWORKER = \"INFO\"\n";
+        return setup;
+    }
+
+    LoggerSettings loadSettings(const Setup& setup) {
+        LoggerSettings settings;
+        settings.configPath = setup.configPath;
+        LoggerConfig::loadOrGenerateConfig(settings.configPath, settings);
+        return settings;
+    }
+
+    // Logs `count` messages tagged `phase`; with `gate` >= 0 it first logs
+    // phase1 and blocks on the pipe before logging `phase`
+    [[noreturn]] void runWorker(const Setup& setup, int worker, const std::string& phase, int count, int gate = -1) {
+        auto settings = std::make_shared<LoggerSettings>();
+        settings->configPath = setup.configPath;
+        {
+            ShmRingBackend backend;
+            Logger<ShmRingBackend> logger(settings, backend);
+            const LevelId level = logger.level("INFO");
+            const ContextId context = logger.context("WORKER");
+
+            if (gate >= 0) {
+                for (int i = 0; i < 100; ++i) {
+                    logger.log(level, context, "worker {} phase1 {}", worker, i);
+                }
+                char byte;
+                while (read(gate, &byte, 1) < 0) {}
+            }
+            for (int i = 0; i < count; ++i) {
+                logger.log(level, context, "worker " + std::to_string(worker) + " " + phase + " " + std::to_string(i));
+            }
+        }
+        std::_Exit(0);
+    }
+
+    std::string readLog(const Setup& setup) {
+        std::ifstream file(setup.dir / "merged.txt");
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    std::size_t countOf(const std::string& log, const std::string& needle) {
+        std::size_t count = 0;
+        for (auto pos = log.find(needle); pos != std::string::npos; pos = log.find(needle, pos + 1)) ++count;
+        return count;
+    }
+
+    bool ringsLeft(const std::string& ringName) {
+        for (const auto& entry : std::filesystem::directory_iterator("/dev/shm")) {
+            if (entry.path().filename().string().starts_with(ringName + ".")) return true;
+        }
+        return false;
+    }
+
+    // Sweeps until every ring is finished and removed
+    void drainAll(ShmCollector& collector) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while ((collector.poll() > 0 || collector.ringCount() > 0) && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+} // namespace
+
+TEST(ShmCollector, MergesWorkerProcesses) {
+    constexpr int MESSAGES = 3000;
+    const auto setup = makeSetup("merge", 4 * 1024 * 1024);
+    ShmCollector collector(loadSettings(setup));
+
+    std::vector<pid_t> workers;
+    for (int w = 0; w < WORKERS; ++w) {
+        const pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0) runWorker(setup, w, "message", MESSAGES);
+        workers.push_back(pid);
+    }
+
+    // Collect while the workers run
+    std::size_t running = workers.size();
+    while (running > 0) {
+        collector.poll();
+        for (auto& pid : workers) {
+            int status = 0;
+            if (pid > 0 && waitpid(pid, &status, WNOHANG) == pid) {
+                EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+                pid = 0;
+                --running;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    drainAll(collector);
+    EXPECT_EQ(collector.ringCount(), 0u);
+    EXPECT_FALSE(ringsLeft(setup.ringName));
+
+    const std::string log = readLog(setup);
+    for (int w = 0; w < WORKERS; ++w) {
+        for (int i = 0; i < MESSAGES; i += 97) {
+            EXPECT_EQ(countOf(log, "WORKER: worker " + std::to_string(w) + " message " + std::to_string(i) + "\n"), 1u)
+                << "worker " << w << " message " << i;
+        }
+        EXPECT_EQ(countOf(log, "worker " + std::to_string(w) + " message " + std::to_string(MESSAGES - 1) + "\n"), 1u);
+    }
+    EXPECT_EQ(countOf(log, "\n"), static_cast<std::size_t>(WORKERS * MESSAGES));
+    EXPECT_EQ(countOf(log, "messages dropped"), 0u);
+
+    std::filesystem::remove_all(setup.dir);
+}
+
+TEST(ShmCollector, CollectorCrashDoesNotBlockWorkers) {
+    constexpr int MESSAGES = 5000;   // far more than a 16 KiB ring holds
+    const auto setup = makeSetup("crash", 16 * 1024);
+
+    const pid_t firstCollector = fork();
+    ASSERT_GE(firstCollector, 0);
+    if (firstCollector == 0) {
+        ShmCollector collector(loadSettings(setup));
+        std::atomic<bool> stop{false};
+        collector.run(stop);
+        std::_Exit(0);
+    }
+
+    int gate[2];
+    ASSERT_EQ(pipe(gate), 0);
+    std::vector<pid_t> workers;
+    for (int w = 0; w < WORKERS; ++w) {
+        const pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0) {
+            close(gate[1]);
+            runWorker(setup, w, "phase2", MESSAGES, gate[0]);
+        }
+        workers.push_back(pid);
+    }
+    close(gate[0]);
+
+    // Wait for the first collector to write phase 1, then kill it
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (countOf(readLog(setup), "phase1 99\n") < WORKERS && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    kill(firstCollector, SIGKILL);
+    int status = 0;
+    ASSERT_EQ(waitpid(firstCollector, &status, 0), firstCollector);
+
+    // With nobody reading, the workers must still finish (dropping what does not fit)
+    close(gate[1]);
+    for (const pid_t pid : workers) {
+        ASSERT_EQ(waitpid(pid, &status, 0), pid);
+        EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    // A new collector picks up where the first stopped and reports the drops
+    {
+        ShmCollector collector(loadSettings(setup));
+        drainAll(collector);
+        EXPECT_EQ(collector.ringCount(), 0u);
+    }
+    EXPECT_FALSE(ringsLeft(setup.ringName));
+
+    const std::string log = readLog(setup);
+    for (int w = 0; w < WORKERS; ++w) {
+        const std::string worker = "worker " + std::to_string(w);
+        EXPECT_EQ(countOf(log, worker + " phase1 0\n"), 1u);
+        EXPECT_EQ(countOf(log, worker + " phase1 99\n"), 1u);
+        EXPECT_EQ(countOf(log, worker + " phase2 0\n"), 1u);
+        EXPECT_EQ(countOf(log, worker + " phase2 " + std::to_string(MESSAGES - 1) + "\n"), 0u);
+        EXPECT_EQ(countOf(log, "dropped by pid " + std::to_string(workers[static_cast<std::size_t>(w)]) + " "), 1u);
+    }
+
+    std::filesystem::remove_all(setup.dir);
+}
+#endif
@@ -0,0 +1,182 @@
+#include "myLogger/logger.hpp"
+#include "myLogger/spsc_ring_buffer.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    // Records every batch; the first one is held until openGate()
+    class BatchRecorder {
+    public:
+        struct Record {
+            std::int64_t timeNs;
+            std::string message;
+        };
+
+        void setup([[maybe_unused]] const LoggerSettings& settings) {}
+
+        void write(const LogMessage& log, const LoggerSettings& settings) {
+            writeBatch(std::span<const LogMessage>(&log, 1), settings);
+        }
+
+        void writeBatch(std::span<const LogMessage> batch, [[maybe_unused]] const LoggerSettings& settings) {
+            std::unique_lock<std::mutex> lock(mutex);
+            auto& records = batches.emplace_back();
+            for (const auto& log : batch) records.push_back({log.timeNs, std::string(log.message.view())});
+            changed.notify_all();
+            changed.wait(lock, [this] { return open; });
+        }
+
+        void waitForBatch() {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return !batches.empty(); });
+        }
+
+        void openGate() {
+            std::lock_guard<std::mutex> lock(mutex);
+            open = true;
+            changed.notify_all();
+        }
+
+        std::vector<std::vector<Record>> batches;
+
+    private:
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool open = false;
+    };
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ Indices keep counting past the capacity: FIFO across every wrap,
+//    including popBulk() runs that straddle the end of the array
+//------------------------------------------------------------------------------
+TEST(SpscRing, Wraparound) {
+    SpscRingBuffer<int> ring(4);
+    int pushed = 0;
+    int expected = 0;
+    for (int round = 0; round < 1000; ++round) {
+        // 1..4 in, then a mix of front()/pop() and popBulk() out
+        const int fill = round % 4 + 1;
+        for (int i = 0; i < fill; ++i) ASSERT_TRUE(ring.tryPush(pushed++));
+        if (fill == 4) {
+            ASSERT_FALSE(ring.tryPush(-1));
+        }
+        ASSERT_EQ(ring.size(), static_cast<std::size_t>(fill));
+
+        if (round % 2 == 0) {
+            while (int* front = ring.front()) {
+                ASSERT_EQ(*front, expected++);
+                ring.pop();
+            }
+        } else {
+            ring.popBulk(3, [&expected](int&& value) { ASSERT_EQ(value, expected++); });
+            ring.popBulk(4, [&expected](int&& value) { ASSERT_EQ(value, expected++); });
+        }
+        ASSERT_TRUE(ring.empty());
+    }
+    EXPECT_EQ(expected, pushed);
+}
+
+// ✅ One producer and one consumer on an 8-slot ring: nothing lost or reordered
+TEST(SpscRing, ProducerConsumerStress) {
+    constexpr std::uint64_t ITEMS = 200'000;
+    SpscRingBuffer<std::uint64_t> ring(8);
+
+    std::thread producer([&ring] {
+        for (std::uint64_t i = 0; i < ITEMS; ++i) {
+            while (!ring.tryPush(i)) std::this_thread::yield();
+        }
+    });
+
+    std::uint64_t expected = 0;
+    bool ordered = true;
+    while (expected < ITEMS) {
+        const std::size_t got = ring.popBulk(5, [&](std::uint64_t&& value) { ordered &= value == expected++; });
+        if (got == 0) std::this_thread::yield();
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(ring.empty());
+}
+
+//------------------------------------------------------------------------------
+// ✅ queue_mode = "per_thread": threads that log in turns fill separate
+//    rings, and the consumer merges them back into capture-time order
+//------------------------------------------------------------------------------
+TEST(SpscRing, PerThreadBatchesMergedByTime) {
+    constexpr int THREADS = 4;
+    constexpr int TURNS = 240;
+    const auto dir = std::filesystem::temp_directory_path() / "mylogger_spsc_test";
+    std::filesystem::create_directories(dir);
+
+    auto settings = std::make_shared<LoggerSettings>();
+    settings->configPath = (dir / "logger.conf").string();
+    {
+        std::ofstream config(settings->configPath);
+        config << "[general]\n"
+               << "log_directory = \"" << dir.string() << "\"\n"
+               << "queue_mode = \"per_thread\"\n"
+               << "thread_queue_capacity = 128\n"
+               << "batch_size = 1024\n"
+               << "[backends]\nenable_console = false\nenable_file = false\n"
+               << "[levels]\nINFO = \"ON\"\n"
+               << "[severities]\nINFO = 3\n"
+               << "[contexts]\nAPP = \"INFO\"\n";
+    }
+
+    BatchRecorder backend;
+    {
+        Logger<BatchRecorder> logger(settings, backend);
+        const LevelId info = logger.level("INFO");
+        const ContextId app = logger.context("APP");
+
+        // Park the consumer in the backend so every turn is queued first
+        logger.log(info, app, "stall");
+        backend.waitForBatch();
+
+        std::atomic<int> turn{0};
+        std::vector<std::thread> producers;
+        for (int t = 0; t < THREADS; ++t) {
+            producers.emplace_back([&, t] {
+                for (;;) {
+                    const int current = turn.load(std::memory_order_acquire);
+                    if (current >= TURNS) return;
+                    if (current % THREADS != t) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    logger.log(info, app, "turn {}", current);
+                    turn.store(current + 1, std::memory_order_release);
+                }
+            });
+        }
+        for (auto& thread : producers) thread.join();
+
+        backend.openGate();
+        logger.shutdown();
+    }
+
+    ASSERT_EQ(backend.batches.size(), 2u);
+    const auto& merged = backend.batches[1];
+    ASSERT_EQ(merged.size(), static_cast<std::size_t>(TURNS));
+    for (int i = 0; i < TURNS; ++i) {
+        EXPECT_EQ(merged[i].message, "turn " + std::to_string(i));
+        if (i > 0) {
+            EXPECT_LE(merged[i - 1].timeNs, merged[i].timeNs);
+        }
+    }
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,99 @@
+#include "myLogger/structured_format.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace {
+
+    constexpr std::string_view TIME = "2024-05-01T12:00:00.250";
+
+    std::string line(LogFormat format, std::string_view timestamp, std::string_view message, const LogFields& fields) {
+        std::string out;
+        appendRecordLine(format, timestamp, "INFO", "APP", message, fields, out);
+        return out;
+    }
+
+    LogFields everyType() {
+        return LogFields{{"user_id", 42},
+                         {"delta", std::numeric_limits<std::int64_t>::min()},
+                         {"bytes", std::numeric_limits<std::uint64_t>::max()},
+                         {"ratio", 0.25},
+                         {"ok", true},
+                         {"cached", false},
+                         {"path", "/api/orders?id=7"},
+                         {"agent", "curl 8.0"}};
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ Known answers: one line per format for the same record
+//------------------------------------------------------------------------------
+TEST(StructuredFormat, Json) {
+    EXPECT_EQ(line(LogFormat::Json, TIME, "Request done", everyType()),
+              "{\"time\":\"2024-05-01T12:00:00.250\",\"level\":\"INFO\",\"context\":\"APP\",\"msg\":\"Request done\","
+              "\"user_id\":42,\"delta\":-9223372036854775808,\"bytes\":18446744073709551615,\"ratio\":0.25,"
+              "\"ok\":true,\"cached\":false,\"path\":\"/api/orders?id=7\",\"agent\":\"curl 8.0\"}\n");
+}
+
+TEST(StructuredFormat, Logfmt) {
+    EXPECT_EQ(line(LogFormat::Logfmt, TIME, "Request done", everyType()),
+              "time=2024-05-01T12:00:00.250 level=INFO context=APP msg=\"Request done\" "
+              "user_id=42 delta=-9223372036854775808 bytes=18446744073709551615 ratio=0.25 "
+              "ok=true cached=false path=\"/api/orders?id=7\" agent=\"curl 8.0\"\n");
+}
+
+TEST(StructuredFormat, Plain) {
+    EXPECT_EQ(line(LogFormat::Plain, TIME, "Request done", everyType()),
+              "2024-05-01T12:00:00.250 [INFO] APP: Request done "
+              "user_id=42 delta=-9223372036854775808 bytes=18446744073709551615 ratio=0.25 "
+              "ok=true cached=false path=\"/api/orders?id=7\" agent=\"curl 8.0\"\n");
+    EXPECT_EQ(line(LogFormat::Binary, TIME, "Request done", {}), "2024-05-01T12:00:00.250 [INFO] APP: Request done\n");
+}
+
+// ✅ Without timestamps the time key is left out, not written empty
+TEST(StructuredFormat, NoTimestamp) {
+    EXPECT_EQ(line(LogFormat::Json, "", "hi", {}), "{\"level\":\"INFO\",\"context\":\"APP\",\"msg\":\"hi\"}\n");
+    EXPECT_EQ(line(LogFormat::Logfmt, "", "hi", {}), "level=INFO context=APP msg=hi\n");
+}
+
+//------------------------------------------------------------------------------
+// ✅ Text that needs escaping, in messages, keys and values
+//------------------------------------------------------------------------------
+TEST(StructuredFormat, Escaping) {
+    const LogFields fields{{"we\"ird\nkey", "line\nbreak"}, {"a b=c", "x=\"y\""}};
+
+    EXPECT_EQ(line(LogFormat::Json, TIME, "say \"hi\"\t\\", fields),
+              "{\"time\":\"2024-05-01T12:00:00.250\",\"level\":\"INFO\",\"context\":\"APP\","
+              "\"msg\":\"say \\\"hi\\\"\\t\\\\\",\"we\\\"ird\\nkey\":\"line\\nbreak\",\"a b=c\":\"x=\\\"y\\\"\"}\n");
+
+    // Keys are written bare: anything that would end one becomes '_'
+    EXPECT_EQ(line(LogFormat::Logfmt, TIME, "say \"hi\"\t\\", fields),
+              "time=2024-05-01T12:00:00.250 level=INFO context=APP msg=\"say \\\"hi\\\"\\t\\\\\" "
+              "we_ird_key=\"line\\nbreak\" a_b_c=\"x=\\\"y\\\"\"\n");
+
+    // Broken UTF-8 becomes U+FFFD in both; valid UTF-8 alone needs no quotes
+    EXPECT_EQ(line(LogFormat::Logfmt, "", "caf\xC3\xA9", {{"bad", "\xFF"}}),
+              "level=INFO context=APP msg=caf\xC3\xA9 bad=\"\xEF\xBF\xBD\"\n");
+    EXPECT_EQ(line(LogFormat::Json, "", "caf\xC3\xA9", {{"bad", "\xFF"}}),
+              "{\"level\":\"INFO\",\"context\":\"APP\",\"msg\":\"caf\xC3\xA9\",\"bad\":\"\xEF\xBF\xBD\"}\n");
+}
+
+// ✅ JSON has no NaN or infinity: those become null; logfmt spells them out
+TEST(StructuredFormat, NonFiniteDoubles) {
+    const LogFields fields{{"nan", std::numeric_limits<double>::quiet_NaN()},
+                           {"inf", std::numeric_limits<double>::infinity()},
+                           {"tiny", 1e-300}};
+    EXPECT_EQ(line(LogFormat::Json, "", "m", fields),
+              "{\"level\":\"INFO\",\"context\":\"APP\",\"msg\":\"m\",\"nan\":null,\"inf\":null,\"tiny\":1e-300}\n");
+    EXPECT_EQ(line(LogFormat::Logfmt, "", "m", fields), "level=INFO context=APP msg=m nan=nan inf=inf tiny=1e-300\n");
+}
+
+// ✅ Keys longer than MAX_FIELD_KEY_LENGTH are cut when the fields are packed
+TEST(StructuredFormat, LongKeysAreCut) {
+    const std::string key(MAX_FIELD_KEY_LENGTH + 20, 'k');
+    const LogFields fields{{key, 1}};
+    EXPECT_EQ(line(LogFormat::Logfmt, "", "m", fields),
+              "level=INFO context=APP msg=m " + std::string(MAX_FIELD_KEY_LENGTH, 'k') + "=1\n");
+}
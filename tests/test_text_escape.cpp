@@ -0,0 +1,152 @@
+#include "myLogger/text_escape.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // Every kernel this build and CPU can run except the scalar reference
+    std::vector<const EscapeKernel*> vectorKernels() {
+        std::vector<const EscapeKernel*> kernels;
+        for (const SimdLevel level : {SimdLevel::Sse2, SimdLevel::Avx2}) {
+            if (const EscapeKernel* kernel = escapeKernelFor(level)) kernels.push_back(kernel);
+        }
+        return kernels;
+    }
+
+    // Mostly printable ASCII with specials, UTF-8 and broken UTF-8 mixed in,
+    // at lengths that end anywhere inside a 16- or 32-byte block
+    std::string randomText(std::mt19937& rng, std::size_t length) {
+        static const std::vector<std::string> pieces = {
+            "\"", "\\", "\n", "\t", "\x1b[31m", "\x7f", std::string(1, '\0'), "=", " ",
+            "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80",            // é € 😀
+            "\xC3", "\xE2\x82", "\xED\xA0\x80", "\xC0\xAF", "\xFF", "\xF4\x90\x80\x80",
+        };
+        std::uniform_int_distribution<int> pick(0, 99);
+        std::uniform_int_distribution<std::size_t> piece(0, pieces.size() - 1);
+        std::uniform_int_distribution<int> printable('!', '~');
+        std::string text;
+        while (text.size() < length) {
+            if (pick(rng) < 8) {
+                text += pieces[piece(rng)];
+            } else {
+                text += static_cast<char>(printable(rng));
+            }
+        }
+        text.resize(length);
+        return text;
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ Known answers for escaping and validation
+//------------------------------------------------------------------------------
+TEST(TextEscape, JsonEscaping) {
+    std::string out;
+    appendJsonEscaped("say \"hi\"\\\n\r\t\x01\x1b\x7f end", out);
+    EXPECT_EQ(out, "say \\\"hi\\\"\\\\\\n\\r\\t\\u0001\\u001b\\u007f end");
+
+    out.clear();
+    appendJsonEscaped("caf\xC3\xA9 \xFF \xE2\x82", out);   // valid é kept, broken bytes replaced
+    EXPECT_EQ(out, "caf\xC3\xA9 \xEF\xBF\xBD \xEF\xBF\xBD\xEF\xBF\xBD");
+}
+
+TEST(TextEscape, LogfmtQuoting) {
+    const auto logfmt = [](std::string_view text) {
+        std::string out;
+        appendLogfmtValue(text, out);
+        return out;
+    };
+    EXPECT_EQ(logfmt("plain"), "plain");
+    EXPECT_EQ(logfmt("caf\xC3\xA9"), "caf\xC3\xA9");
+    EXPECT_EQ(logfmt(""), "\"\"");
+    EXPECT_EQ(logfmt("two words"), "\"two words\"");
+    EXPECT_EQ(logfmt("a=b"), "\"a=b\"");
+    EXPECT_EQ(logfmt("bad\xFF"), "\"bad\xEF\xBF\xBD\"");
+}
+
+TEST(TextEscape, TerminalSafe) {
+    std::string out;
+    appendTerminalSafe("\x1b[2Jok\tstill ok\r\n\xC3\xA9\xC3", out);
+    EXPECT_EQ(out, "\\x1b[2Jok\tstill ok\\x0d\\x0a\xC3\xA9\xEF\xBF\xBD");
+}
+
+TEST(TextEscape, Utf8Validation) {
+    EXPECT_TRUE(isValidUtf8(""));
+    EXPECT_TRUE(isValidUtf8("ascii only"));
+    EXPECT_TRUE(isValidUtf8("\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\xF4\x8F\xBF\xBF"));
+    EXPECT_FALSE(isValidUtf8("\xC0\xAF"));               // overlong '/'
+    EXPECT_FALSE(isValidUtf8("\xE0\x80\xAF"));           // overlong
+    EXPECT_FALSE(isValidUtf8("\xED\xA0\x80"));           // surrogate
+    EXPECT_FALSE(isValidUtf8("\xF4\x90\x80\x80"));       // above U+10FFFF
+    EXPECT_FALSE(isValidUtf8("truncated \xE2\x82"));
+    EXPECT_FALSE(isValidUtf8("\x80"));                   // lone continuation
+}
+
+//------------------------------------------------------------------------------
+// ✅ Vector kernels match the scalar reference byte for byte
+//------------------------------------------------------------------------------
+TEST(TextEscape, VectorKernelsMatchScalar) {
+    const EscapeKernel& scalar = *escapeKernelFor(SimdLevel::Scalar);
+    const auto kernels = vectorKernels();
+    if (kernels.empty()) GTEST_SKIP() << "no SIMD kernel on this CPU";
+
+    std::mt19937 rng(12345);
+    for (int round = 0; round < 4000; ++round) {
+        const std::string text = randomText(rng, static_cast<std::size_t>(round % 131));
+
+        std::string expectedJson, expectedLogfmt, expectedTerminal;
+        appendJsonEscaped(text, expectedJson, scalar);
+        appendLogfmtValue(text, expectedLogfmt, scalar);
+        appendTerminalSafe(text, expectedTerminal, scalar);
+        const bool expectedValid = isValidUtf8(text, scalar);
+
+        for (const EscapeKernel* kernel : kernels) {
+            SCOPED_TRACE(simdLevelName(kernel->level));
+            std::string json, logfmt, terminal;
+            appendJsonEscaped(text, json, *kernel);
+            appendLogfmtValue(text, logfmt, *kernel);
+            appendTerminalSafe(text, terminal, *kernel);
+            ASSERT_EQ(json, expectedJson);
+            ASSERT_EQ(logfmt, expectedLogfmt);
+            ASSERT_EQ(terminal, expectedTerminal);
+            ASSERT_EQ(isValidUtf8(text, *kernel), expectedValid);
+
+            // Raw scans from every start offset, not only those the escapers hit
+            for (std::size_t from = 0; from <= text.size(); ++from) {
+                ASSERT_EQ(kernel->findJsonSpecial(text.data(), text.size(), from),
+                          scalar.findJsonSpecial(text.data(), text.size(), from));
+                ASSERT_EQ(kernel->findLogfmtSpecial(text.data(), text.size(), from),
+                          scalar.findLogfmtSpecial(text.data(), text.size(), from));
+                ASSERT_EQ(kernel->findTerminalSpecial(text.data(), text.size(), from),
+                          scalar.findTerminalSpecial(text.data(), text.size(), from));
+                ASSERT_EQ(kernel->findNonAscii(text.data(), text.size(), from),
+                          scalar.findNonAscii(text.data(), text.size(), from));
+            }
+        }
+    }
+}
+
+// ✅ Every byte value, alone at every position of a 64-byte block
+TEST(TextEscape, EveryByteAtEveryPosition) {
+    const EscapeKernel& scalar = *escapeKernelFor(SimdLevel::Scalar);
+    for (const EscapeKernel* kernel : vectorKernels()) {
+        SCOPED_TRACE(simdLevelName(kernel->level));
+        for (int value = 0; value < 256; ++value) {
+            for (std::size_t position = 0; position < 64; ++position) {
+                std::string text(64, 'a');
+                text[position] = static_cast<char>(value);
+                ASSERT_EQ(kernel->findJsonSpecial(text.data(), text.size(), 0),
+                          scalar.findJsonSpecial(text.data(), text.size(), 0));
+                ASSERT_EQ(kernel->findLogfmtSpecial(text.data(), text.size(), 0),
+                          scalar.findLogfmtSpecial(text.data(), text.size(), 0));
+                ASSERT_EQ(kernel->findTerminalSpecial(text.data(), text.size(), 0),
+                          scalar.findTerminalSpecial(text.data(), text.size(), 0));
+                ASSERT_EQ(kernel->findNonAscii(text.data(), text.size(), 0),
+                          scalar.findNonAscii(text.data(), text.size(), 0));
+            }
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#include "myLogger/timestamp_formatter.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <optional>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+namespace {
+
+    constexpr std::int64_t NS = 1'000'000'000;
+    constexpr std::int64_t FRACTION = 123'456'789;
+
+    // Both 2024 DST switches in New York, one second either side
+    constexpr std::int64_t SPRING_LAST_EST = 1'710'053'999;   // 01:59:59 EST, then 03:00:00 EDT
+    constexpr std::int64_t FALL_LAST_EDT = 1'730'613'599;     // 01:59:59 EDT, then 01:00:00 EST
+
+    // Runs the test in TZ=America/New_York, then restores the old zone
+    class TimestampFormatter : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            if (const char* tz = std::getenv("TZ")) previous = tz;
+            setenv("TZ", "America/New_York", 1);
+            tzset();
+        }
+
+        void TearDown() override {
+            if (previous) {
+                setenv("TZ", previous->c_str(), 1);
+            } else {
+                unsetenv("TZ");
+            }
+            tzset();
+        }
+
+        static std::string format(std::int64_t timeNs, std::string_view pattern) {
+            char out[MAX_TIMESTAMP_LENGTH];
+            return {out, formatTimestamp(timeNs, pattern, out, sizeof(out))};
+        }
+
+        // What localtime_r + strftime give for the whole second
+        static std::string reference(std::int64_t second, const char* pattern) {
+            const auto t = static_cast<std::time_t>(second);
+            std::tm tm{};
+            localtime_r(&t, &tm);
+            char out[MAX_TIMESTAMP_LENGTH];
+            return {out, std::strftime(out, sizeof(out), pattern, &tm)};
+        }
+
+    private:
+        std::optional<std::string> previous;
+    };
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ Known answers for each ISO format on both sides of the spring switch
+//------------------------------------------------------------------------------
+TEST_F(TimestampFormatter, IsoKnownAnswers) {
+    const std::int64_t before = SPRING_LAST_EST * NS + FRACTION;
+    const std::int64_t after = (SPRING_LAST_EST + 1) * NS + FRACTION;
+
+    EXPECT_EQ(format(before, "ISO"), "2024-03-10T01:59:59");
+    EXPECT_EQ(format(before, "ISO_MS"), "2024-03-10T01:59:59.123");
+    EXPECT_EQ(format(before, "ISO_US"), "2024-03-10T01:59:59.123456");
+    EXPECT_EQ(format(before, "ISO_NS"), "2024-03-10T01:59:59.123456789");
+
+    EXPECT_EQ(format(after, "ISO"), "2024-03-10T03:00:00");
+    EXPECT_EQ(format(after, "ISO_MS"), "2024-03-10T03:00:00.123");
+    EXPECT_EQ(format(after, "ISO_US"), "2024-03-10T03:00:00.123456");
+    EXPECT_EQ(format(after, "ISO_NS"), "2024-03-10T03:00:00.123456789");
+}
+
+// ✅ strftime patterns get the zone: %z and %Z follow the switch
+TEST_F(TimestampFormatter, StrftimeKnownAnswers) {
+    constexpr std::string_view pattern = "%Y-%m-%d %H:%M:%S %z %Z";
+    EXPECT_EQ(format(SPRING_LAST_EST * NS, pattern), "2024-03-10 01:59:59 -0500 EST");
+    EXPECT_EQ(format((SPRING_LAST_EST + 1) * NS, pattern), "2024-03-10 03:00:00 -0400 EDT");
+    EXPECT_EQ(format(FALL_LAST_EDT * NS, pattern), "2024-11-03 01:59:59 -0400 EDT");
+    EXPECT_EQ(format((FALL_LAST_EDT + 1) * NS, pattern), "2024-11-03 01:00:00 -0500 EST");
+}
+
+//------------------------------------------------------------------------------
+// ✅ Every second across both switches matches localtime_r + strftime, for
+//    the cached ISO path, a strftime pattern and the signal-safe formatter
+//------------------------------------------------------------------------------
+TEST_F(TimestampFormatter, MatchesLocaltimeAcrossDst) {
+    for (const std::int64_t edge : {SPRING_LAST_EST, FALL_LAST_EDT}) {
+        for (std::int64_t second = edge - 3600; second <= edge + 3600; ++second) {
+            const std::int64_t timeNs = second * NS + FRACTION;
+            const std::string iso = reference(second, "%Y-%m-%dT%H:%M:%S");
+
+            ASSERT_EQ(format(timeNs, "ISO"), iso) << second;
+            ASSERT_EQ(format(timeNs, "ISO_MS"), iso + ".123") << second;
+            ASSERT_EQ(format(timeNs, "%d/%m/%Y %H:%M:%S %z %Z"), reference(second, "%d/%m/%Y %H:%M:%S %z %Z"))
+                << second;
+
+            char out[MAX_TIMESTAMP_LENGTH];
+            const std::size_t length = formatTimestampAtOffset(timeNs, localUtcOffset(timeNs), "ISO_US", out,
+                                                               sizeof(out));
+            ASSERT_EQ(std::string(out, length), iso + ".123456") << second;
+        }
+    }
+}
+
+#endif // __unix__ || __APPLE__
@@ -0,0 +1,145 @@
+#include "myLogger/backends/uring_file_backend.hpp"
+#include "myLogger/binary_log_format.hpp"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/filter.h>
+#include <linux/seccomp.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+    const std::filesystem::path DIR = std::filesystem::temp_directory_path() / "mylogger_uring_test";
+
+    // From here on io_uring_enter fails with EIO in this process
+    bool failIoUringEnter() {
+        sock_filter filter[] = {
+            BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(seccomp_data, nr)),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_io_uring_enter, 0, 1),
+            BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | (EIO & SECCOMP_RET_DATA)),
+            BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW),
+        };
+        sock_fprog program{static_cast<unsigned short>(sizeof(filter) / sizeof(filter[0])), filter};
+        return prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) == 0 &&
+               prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, &program) == 0;
+    }
+
+    void writeLines(UringFileBackend& backend, const LoggerSettings& settings, int from, int to) {
+        std::vector<LogMessage> batch;
+        for (int i = from; i < to; ++i) {
+            batch.emplace_back(0, 0, "line " + std::to_string(i));
+        }
+        backend.writeBatch(batch, settings);
+    }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// ✅ io_uring_enter failing mid-run: nothing lost, nothing reordered, and
+//    shutdown() returns instead of waiting for completions forever
+//------------------------------------------------------------------------------
+TEST(UringFileBackend, SubmitFailureFallsBackToSynchronousWrites) {
+    constexpr int LINES = 400;
+    std::filesystem::remove_all(DIR);
+    std::filesystem::create_directories(DIR);
+
+    LoggerSettings settings;
+    settings.config.general.logDirectory = DIR.string();
+    settings.config.general.logFilenameFormat = "uring.txt";
+    settings.config.general.flushMode = "batch";
+    settings.config.general.fileBufferSize = 4096;
+
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        alarm(20);   // a hang fails the test instead of blocking it
+        UringFileBackend backend;
+        backend.setup(settings);
+        if (!backend.usingIoUring()) _exit(2);
+
+        for (int i = 0; i < LINES / 2; i += 50) writeLines(backend, settings, i, i + 50);
+        if (!failIoUringEnter()) _exit(3);
+        for (int i = LINES / 2; i < LINES; i += 50) writeLines(backend, settings, i, i + 50);
+        backend.shutdown();
+        _exit(backend.usingIoUring() ? 4 : 0);
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status)) << "child did not exit (hang or crash)";
+    if (WEXITSTATUS(status) == 2 || WEXITSTATUS(status) == 3) {
+        GTEST_SKIP() << "io_uring or seccomp not available here";
+    }
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    std::ifstream in(DIR / "uring.txt");
+    std::string line;
+    int expected = 0;
+    while (std::getline(in, line)) {
+        const auto at = line.rfind("line ");
+        ASSERT_NE(at, std::string::npos) << line;
+        ASSERT_EQ(std::stoi(line.substr(at + 5)), expected);
+        ++expected;
+    }
+    EXPECT_EQ(expected, LINES);
+
+    std::filesystem::remove_all(DIR);
+}
+
+//------------------------------------------------------------------------------
+// ✅ log_format = "binary": one file header, a session per setup(), and
+//    records that decode back in order
+//------------------------------------------------------------------------------
+TEST(UringFileBackend, BinaryFormat) {
+    std::filesystem::remove_all(DIR);
+    std::filesystem::create_directories(DIR);
+
+    LoggerSettings settings;
+    settings.config.general.logDirectory = DIR.string();
+    settings.config.general.logFilenameFormat = "uring.log";
+    settings.config.general.flushMode = "batch";
+    settings.config.general.fileBufferSize = 4096;
+    settings.config.format.logFormat = "binary";
+
+    for (int run = 0; run < 2; ++run) {
+        UringFileBackend backend;
+        backend.setup(settings);
+        if (!backend.usingIoUring()) GTEST_SKIP() << "io_uring not available here";
+        writeLines(backend, settings, run * 300, run * 300 + 300);
+        backend.shutdown();
+    }
+
+    std::ifstream in(DIR / "uring.log", std::ios::binary);
+    std::stringstream binary;
+    binary << in.rdbuf();
+    ASSERT_EQ(binary.str().compare(0, BINARY_LOG_MAGIC_LENGTH, BINARY_LOG_MAGIC), 0);
+    EXPECT_EQ(binary.str().find(BINARY_LOG_MAGIC, 1), std::string::npos);   // header written once
+
+    std::ostringstream decoded;
+    std::string error;
+    ASSERT_TRUE(decodeBinaryLog(binary, decoded, error)) << error;
+
+    std::istringstream lines(decoded.str());
+    std::string line;
+    int expected = 0;
+    while (std::getline(lines, line)) {
+        const auto at = line.rfind("line ");
+        ASSERT_NE(at, std::string::npos) << line;
+        ASSERT_EQ(std::stoi(line.substr(at + 5)), expected);
+        ++expected;
+    }
+    EXPECT_EQ(expected, 600);
+
+    std::filesystem::remove_all(DIR);
+}
+
+#endif // __linux__
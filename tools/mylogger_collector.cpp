@@ -0,0 +1,46 @@
+#include "myLogger/shm_collector.hpp"
+#include <atomic>
+#include <csignal>
+#include <iostream>
+#include <string>
+
+//------------------------------------------------------------------------------
+// mylogger-collector: merges the ShmRingBackend rings of all worker processes
+// into one log file, rotated as the config says
+//
+//   mylogger-collector [config]      (default: config/logger.conf)
+//
+// Runs until SIGINT or SIGTERM, then drains the rings once more and exits.
+//------------------------------------------------------------------------------
+namespace {
+
+    std::atomic<bool> stopRequested{false};
+
+    extern "C" void requestStop(int) {
+        stopRequested.store(true, std::memory_order_release);
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 2) {
+        std::cerr << "Usage: " << argv[0] << " [config]\n";
+        return 2;
+    }
+
+    LoggerSettings settings;
+    if (argc == 2) settings.configPath = argv[1];
+    LoggerConfig::loadOrGenerateConfig(settings.configPath, settings);
+
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+
+    try {
+        ShmCollector collector(settings);
+        collector.run(stopRequested);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
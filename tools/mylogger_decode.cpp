@@ -0,0 +1,53 @@
+#include "myLogger/binary_log_format.hpp"
+#include <fstream>
+#include <iostream>
+#include <string>
+
+//------------------------------------------------------------------------------
+// mylogger-decode: binary log -> the text FileBackend would have written
+//
+//   mylogger-decode [--format plain|json|logfmt] <binary-log> [output]
+//                                              ("-" or no output = stdout)
+//------------------------------------------------------------------------------
+int main(int argc, char** argv) {
+    LogFormat format = LogFormat::Plain;
+    int first = 1;
+    if (argc > 2 && std::string(argv[1]) == "--format") {
+        format = parseLogFormat(argv[2]);
+        first = 3;
+    }
+
+    const int remaining = argc - first;
+    if (remaining < 1 || remaining > 2) {
+        std::cerr << "Usage: " << argv[0] << " [--format plain|json|logfmt] <binary-log> [output]\n";
+        return 2;
+    }
+    const char* inputPath = argv[first];
+    const char* outputPath = remaining == 2 ? argv[first + 1] : "-";
+
+    std::ifstream input(inputPath, std::ios::binary);
+    if (!input) {
+        std::cerr << "Cannot open " << inputPath << "\n";
+        return 1;
+    }
+
+    std::ofstream file;
+    std::ostream* output = &std::cout;
+    if (std::string(outputPath) != "-") {
+        file.open(outputPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "Cannot create " << outputPath << "\n";
+            return 1;
+        }
+        output = &file;
+    }
+
+    std::string error;
+    const bool ok = decodeBinaryLog(input, *output, error, format);
+    output->flush();
+    if (!ok) {
+        std::cerr << inputPath << ": " << error << "\n";
+        return 1;
+    }
+    return 0;
+}